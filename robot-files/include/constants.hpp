@@ -16,10 +16,21 @@ constexpr int HORIZONTAL_ROTATION_SENSOR = 16;
 constexpr int VERTICAL_ROTATION_SENSOR = 6;
 constexpr int IMU_1 = 0; // newest
 constexpr int IMU_2 = 0; // Second IMU port, old
+constexpr int GPS = 0;   // 0 = no GPS sensor
+
+// relocalization distance sensors, 0 = none
+constexpr int DISTANCE_FRONT = 0;
+constexpr int DISTANCE_BACK = 0;
+constexpr int DISTANCE_LEFT = 0;
+constexpr int DISTANCE_RIGHT = 0;
+
+// game piece camera
+constexpr int AI_VISION = 0; // 0 = none
 
 // conveyor belt
 constexpr int ENDEFFECTOR_MOTOR_PORT = 11;
 constexpr int INTAKE_MOTOR_PORT = 20;
+constexpr int COLOR_SORT_OPTICAL = 0; // optical sensor on the conveyor, 0 = no color sort
 
 // pneumatics
 constexpr int LIL_WILL_PNEUMATIC = 'A';
@@ -36,6 +47,10 @@ constexpr double HORIZONTALTRACKING_WHEEL_OFFSET = 0;
 } // namespace CHASIS_VALUES
 
 namespace OPERATOR_CONSTANTS {
+// Drive through the curves below; false goes back to LemLib's default linear
+// curve (no deadband or minimum output), which drivers used before these
+constexpr bool USE_CURVES = true;
+
 namespace THROTTLE {
 constexpr int DEADBAND = 3;
 constexpr int MIN = 10;
@@ -49,6 +64,7 @@ constexpr double CURVE = 1.000;
 } // namespace STEER
 
 constexpr double DESATURATE_BIAS = 0.45;
+constexpr int DRIVE_KEEPALIVE_MS = 100; // resend an unchanged drive command this often
 } // namespace OPERATOR_CONSTANTS
 
 namespace DRIVETRAIN_CONSTANTS {
@@ -62,6 +78,15 @@ constexpr int SMALL_TIMEOUT = 100;
 constexpr double LARGE_ERROR = 3;
 constexpr int LARGE_TIMEOUT = 500;
 constexpr double SLEW = 0.0;
+
+// motion profile limits (tune on the field)
+constexpr double MAX_VELOCITY = 60;      // in/s
+constexpr double MAX_ACCELERATION = 120; // in/s^2
+constexpr double MAX_JERK = 0;           // in/s^3, 0 = trapezoidal profile
+
+// PID output multiplier by |error| (inches); tapers where output saturates anyway
+constexpr double GAIN_SCHEDULE_ERROR[] = {0, 12, 36};
+constexpr double GAIN_SCHEDULE_SCALE[] = {1.0, 1.0, 0.75};
 } // namespace LATERAL
 
 namespace ANGULAR {
@@ -74,9 +99,175 @@ constexpr int SMALL_TIMEOUT = 100;
 constexpr double LARGE_ERROR = 3;
 constexpr int LARGE_TIMEOUT = 500;
 constexpr double SLEW = 0;
+
+// motion profile limits (tune on the field)
+constexpr double MAX_VELOCITY = 360;      // deg/s
+constexpr double MAX_ACCELERATION = 1440; // deg/s^2
+constexpr double MAX_JERK = 0;            // deg/s^3, 0 = trapezoidal profile
+
+// PID output multiplier by |error| (degrees)
+constexpr double GAIN_SCHEDULE_ERROR[] = {0, 30, 120};
+constexpr double GAIN_SCHEDULE_SCALE[] = {1.0, 1.0, 0.75};
 } // namespace ANGULAR
+
+// kS/kV/kA per side, from tools/feedforward_fitter.cpp on a characterization log.
+// Until the robot is characterized these are estimates: blue 450rpm on 4"
+// wheels is ~94 in/s free speed at 12 V
+namespace FEEDFORWARD {
+namespace LEFT {
+constexpr double KS = 0.5;         // V
+constexpr double KV = 12.0 / 94.2; // V per in/s
+constexpr double KA = 0.02;        // V per in/s^2
+} // namespace LEFT
+
+namespace RIGHT {
+constexpr double KS = 0.5;
+constexpr double KV = 12.0 / 94.2;
+constexpr double KA = 0.02;
+} // namespace RIGHT
+} // namespace FEEDFORWARD
+
+namespace RAMSETE {
+constexpr double B = 2.0 / (39.37 * 39.37); // the usual 2 1/m^2, in 1/in^2
+constexpr double ZETA = 0.7;
+} // namespace RAMSETE
 } // namespace DRIVETRAIN_CONSTANTS
 
+namespace VOLTAGE_COMPENSATION_CONSTANTS {
+constexpr double NOMINAL_MV = 12000; // battery voltage the gains are tuned at
+constexpr double MIN_MV = 9000;      // never compensate for less than this
+} // namespace VOLTAGE_COMPENSATION_CONSTANTS
+
+namespace VOLTAGE_DRIVE_CONSTANTS {
+constexpr bool ENABLED = false;       // drive with move_voltage and our own velocity loop instead of move()
+constexpr double KP = 0.05;           // volts per in/s of wheel velocity error
+constexpr double KI = 0.2;            // volts per inch of accumulated error
+constexpr double INTEGRAL_LIMIT = 2;  // volts
+} // namespace VOLTAGE_DRIVE_CONSTANTS
+
+namespace SCHEDULER_CONSTANTS {
+// subsystem periods (ms)
+constexpr int INPUT_PERIOD_MS = 5;
+constexpr int DRIVETRAIN_PERIOD_MS = 5;
+constexpr int INTAKE_PERIOD_MS = 10;
+constexpr int ENDEFFECTOR_PERIOD_MS = 10;
+constexpr int PNEUMATICS_PERIOD_MS = 50;
+
+// ordering within a lane (higher runs first)
+constexpr int INPUT_PRIORITY = 4; // poll before anything consumes the frame
+constexpr int DRIVETRAIN_PRIORITY = 3;
+constexpr int INTAKE_PRIORITY = 2;
+constexpr int ENDEFFECTOR_PRIORITY = 2;
+constexpr int PNEUMATICS_PRIORITY = 1;
+} // namespace SCHEDULER_CONSTANTS
+
+namespace SENSOR_HUB_CONSTANTS {
+constexpr int PERIOD_MS = 5;           // sampling period
+constexpr int STALE_TIMEOUT_MS = 50;   // no fresh data for this long = stale
+constexpr int TASK_PRIORITY_OFFSET = 1; // above the drive lane so snapshots are fresh when it runs
+constexpr double BATTERY_FILTER_ALPHA = 0.05; // ~100 ms time constant at 5 ms
+} // namespace SENSOR_HUB_CONSTANTS
+
+namespace POSE_CHANNEL_CONSTANTS {
+constexpr int PERIOD_MS = 10;           // matches LemLib's odometry update rate
+constexpr int TASK_PRIORITY_OFFSET = 1; // publish before the drive lane reads
+} // namespace POSE_CHANNEL_CONSTANTS
+
+namespace ODOMETRY_CONSTANTS {
+constexpr bool USE_EKF = false;         // fuse every sensor with EkfOdometry instead of LemLib's odometry; pass tools/ekf_sim.cpp and run it on the robot first
+constexpr int PERIOD_MS = 5;            // one filter update per SensorHub snapshot
+constexpr int TASK_PRIORITY_OFFSET = 1; // with the pose publisher it replaces
+constexpr bool USE_GPS = false;         // needs the odometry frame to be the GPS field frame
+constexpr int IMU_DATA_RATE_MS = 5;     // gyro rate once per SensorHub cycle (the sensor's minimum)
+constexpr int ROTATION_DATA_RATE_MS = 5; // tracking wheels too; the default is 10
+constexpr int WHEEL_WINDOW_MS = 10;      // tracking wheel differencing window, two rotation updates
+constexpr double IMU_GYRO_SIGN = 1;     // flip if the fused heading turns the wrong way
+constexpr double GYRO_BIAS_TIME_CONSTANT = 0.5; // s of stillness the gyro bias estimate averages over
+constexpr double GYRO_DISAGREE_RATE = 5;        // deg/s apart before the gyro further from the wheels is dropped
+
+// measurement noise, standard deviations
+constexpr double TRACKING_WHEEL_NOISE = 1;   // in/s
+constexpr double MOTOR_ENCODER_NOISE = 4;    // in/s; drive wheels slip
+constexpr double IMU_HEADING_NOISE = 0.01;   // rad
+constexpr double GPS_POSITION_NOISE = 1;     // in, floor under the sensor's own estimate
+constexpr double GPS_HEADING_NOISE = 0.035;  // rad
+constexpr double OUTLIER_GATE = 4;           // reject innovations beyond this many standard deviations
+} // namespace ODOMETRY_CONSTANTS
+
+namespace WARM_START_CONSTANTS {
+constexpr bool ENABLED = true;                       // restore gyro biases and pose instead of a full IMU calibration
+constexpr const char* PATH = "/usd/warm_start.bin";
+constexpr int STILL_CHECK_MS = 300;                  // gyro sampling before trusting the saved biases
+constexpr double MAX_BIAS_CHANGE = 0.3;              // deg/s between the saved and the measured bias
+constexpr double MAX_GYRO_DEVIATION = 0.5;           // deg/s of spread; more means the robot is being moved
+constexpr int SAVE_PERIOD_MS = 1000;
+constexpr double SAVE_POSE_CHANGE = 0.5;             // in or deg; smaller changes are not worth an SD write
+constexpr double SAVE_BIAS_CHANGE = 0.02;            // deg/s
+} // namespace WARM_START_CONSTANTS
+
+// Relocalization needs the odometry frame to be the field frame (inches from
+// the field centre, like the GPS), so autons must setPose in that frame. It
+// only runs with ODOMETRY_CONSTANTS::USE_EKF, whose task owns the pose
+namespace MCL_CONSTANTS {
+constexpr int PERIOD_MS = 40;           // about one distance sensor update
+constexpr int TASK_PRIORITY_OFFSET = 0; // below odometry; the corrections are not urgent
+// mounts: inches right, inches forward, degrees clockwise from forward
+constexpr double FRONT_MOUNT[3] = {0, 6, 0};
+constexpr double BACK_MOUNT[3] = {0, -6, 180};
+constexpr double LEFT_MOUNT[3] = {-6, 0, -90};
+constexpr double RIGHT_MOUNT[3] = {6, 0, 90};
+constexpr int MIN_BEAMS = 2;               // one wall fixes only one axis
+constexpr double MAX_SPREAD = 3;           // in; a wider particle cloud is not trusted
+constexpr double POSITION_NOISE_FLOOR = 1; // in, floor under the cloud's spread
+constexpr double HEADING_NOISE_FLOOR = 3;  // deg; the gyros know heading better
+} // namespace MCL_CONSTANTS
+
+namespace CHARACTERIZATION_CONSTANTS {
+constexpr bool RUN_IN_AUTONOMOUS = false; // run the drive characterization tests instead of an auton
+constexpr double QUASISTATIC_VOLTS_PER_SECOND = 0.5;
+constexpr int QUASISTATIC_DURATION_MS = 7000;
+constexpr double STEP_VOLTS = 6;
+constexpr int STEP_DURATION_MS = 1500;
+constexpr int REST_MS = 3000; // between tests; reposition the robot
+constexpr int SAMPLE_PERIOD_MS = 10;
+constexpr const char* LOG_PATH = "/usd/characterization.csv";
+} // namespace CHARACTERIZATION_CONSTANTS
+
+namespace AUTOTUNE_CONSTANTS {
+constexpr bool RUN_IN_AUTONOMOUS = false; // run the PID autotuner instead of an auton
+constexpr double RELAY_OUTPUT = 40;        // relay amplitude (move() units)
+constexpr double LATERAL_HYSTERESIS = 0.25; // inches
+constexpr double ANGULAR_HYSTERESIS = 1;   // degrees
+constexpr int MIN_CYCLES = 5;              // limit cycles to average
+constexpr int RELAY_TIMEOUT_MS = 8000;
+constexpr double LATERAL_STEP = 24;        // simulated step the gains are optimised for (inches)
+constexpr double ANGULAR_STEP = 90;        // (degrees)
+constexpr double MAX_OVERSHOOT = 0.02;     // fraction of the step
+constexpr const char* GAINS_PATH = "/usd/autotune.txt"; // loaded at startup when present
+} // namespace AUTOTUNE_CONSTANTS
+
+namespace LATENCY_CONSTANTS {
+constexpr bool RUN_IN_AUTONOMOUS = false; // compare output path latency instead of running an auton
+constexpr int TRIALS = 6;                 // per path, alternating forwards and backwards
+constexpr double STEP_VELOCITY = 30;      // in/s
+constexpr int TRIAL_MS = 500;
+constexpr int REST_MS = 1000;
+constexpr double ONSET_DISTANCE = 0.05;   // inches of travel that count as motion
+constexpr const char* LOG_PATH = "/usd/latency.csv";
+} // namespace LATENCY_CONSTANTS
+
+namespace TRACKING_CALIBRATION_CONSTANTS {
+constexpr bool RUN_IN_AUTONOMOUS = false; // calibrate the tracking wheels instead of running an auton
+constexpr int SPIN_TURNS = 3;             // full turns in place, each way
+constexpr double SPIN_POWER = 40;         // move() units
+constexpr double LINE_POWER = 40;
+constexpr double LINE_START_GAP = 60;     // tape-measured gap from the front distance sensor to the wall at the start (inches)
+constexpr double LINE_STOP_GAP = 6;       // drive until the sensor reads this; it is accurate to ~0.6 in up close
+constexpr int SETTLE_MS = 750;            // rest after each segment before reading the sensors
+constexpr int SEGMENT_TIMEOUT_MS = 15000;
+constexpr const char* PATH = "/usd/tracking_wheels.txt"; // loaded at startup when present
+} // namespace TRACKING_CALIBRATION_CONSTANTS
+
 namespace VISION {
 namespace RED {
 constexpr double UPPER_BOUND = 20;
@@ -92,8 +283,63 @@ constexpr double LOWER_BOUND = 210;
 } // namespace BLUE
 } // namespace VISION
 
+namespace COLOR_SORT_CONSTANTS {
+constexpr int PERIOD_MS = 5;
+constexpr int TASK_PRIORITY_OFFSET = 2;     // above the sensor hub: a late pulse misses the piece
+constexpr double INTEGRATION_TIME_MS = 3;   // the optical sensor's minimum
+constexpr int LED_PWM = 100;                // percent; lights the piece so ambient light does not set its hue
+constexpr double MIN_SATURATION = 0.4;      // below this the hue is the belt's or the field's, not a piece's
+constexpr int MIN_PROXIMITY = 120;          // 0-255, higher is closer; a piece in front of the sensor
+constexpr int CONFIRM_SAMPLES = 2;          // consecutive agreeing samples before a piece is classified
+constexpr double BELT_INCHES_PER_DEGREE = 2 * 3.14159 / 360; // end effector roller travel per motor degree (2" roller)
+constexpr double EXIT_DISTANCE = 6;         // belt travel from the sensor to the eject point (inches)
+constexpr int EJECT_LEAD_MS = 20;           // eject command to reversed rollers, plus half a cycle; check with tools/conveyor_replay.cpp
+constexpr int EJECT_MS = 120;               // length of the eject pulse
+constexpr int ENDEFFECTOR_EJECT_POWER = -127; // reversing the top stage throws the piece out the back
+constexpr bool EJECT_WITH_INTAKE = false;   // also drive the intake during the pulse
+constexpr int INTAKE_EJECT_POWER = 0;
+} // namespace COLOR_SORT_CONSTANTS
+
+namespace VISION_TRACKER_CONSTANTS {
+constexpr int PERIOD_MS = 20;                // a little faster than the camera's frame rate
+constexpr int TASK_PRIORITY_OFFSET = -1;     // below the drive lane; a late frame only ages the targets
+constexpr double MOUNT[3] = {0, 6, 0};       // camera {right, forward, angle clockwise} on the robot (inches, degrees)
+constexpr double HORIZONTAL_FOV = 74;        // degrees
+constexpr double IMAGE_WIDTH = 320;          // pixels
+constexpr double PIECE_WIDTH = 3.5;          // inches
+constexpr double MIN_WIDTH_PX = 6;
+constexpr int ID_MASK = (1 << 1) | (1 << 2); // color descriptors (or AI model classes) that are pieces
+constexpr bool USE_AI_MODEL = false;         // track AI model objects instead of color descriptors
+constexpr int FRAME_LATENCY_MS = 40;         // capture to readable
+constexpr double GATE = 6;                   // inches a piece may move between frames and stay the same track
+constexpr double SMOOTHING = 0.5;
+constexpr int CONFIRM_FRAMES = 3;
+constexpr int TRACK_TIMEOUT_MS = 500;
+
+// opcontrol aim assist, added to the turn input while AIM_ASSIST is held
+constexpr double AIM_KP = 1.5;               // move() units per degree of bearing
+constexpr double AIM_MAX_TURN = 40;
+constexpr double AIM_MAX_BEARING = 35;       // ignore pieces further off the heading than this
+
+// drive_to_nearest_piece
+constexpr double DRIVE_MAX_BEARING = 60;
+constexpr double DRIVE_MAX_SPEED = 80;
+constexpr double RETARGET_DISTANCE = 2;      // re-aim when the tracked piece moves this far (inches)
+} // namespace VISION_TRACKER_CONSTANTS
+
+namespace TELEMETRY_CONSTANTS {
+constexpr int MIN_LEVEL = 1;               // LogLevel::INFO; calls below this compile out (0 also logs DEBUG)
+constexpr int DRAIN_PERIOD_MS = 50;
+constexpr bool TO_SD = true;               // raw records for tools/telemetry_decoder.cpp; otherwise printed as text
+constexpr const char* PATH = "/usd/telemetry.bin"; // rewritten every boot
+} // namespace TELEMETRY_CONSTANTS
+
 namespace CONTROLLER_BUTTONS {
 
+namespace DRIVETRAIN {
+constexpr auto AIM_ASSIST = pros::E_CONTROLLER_DIGITAL_B;
+} // namespace DRIVETRAIN
+
 namespace ENDEFFECTOR {
 constexpr auto SCORE_HIGH = pros::E_CONTROLLER_DIGITAL_L1;
 constexpr auto SCORE_MID = pros::E_CONTROLLER_DIGITAL_L2;
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "api.h" // for pros::Controller
+#include "input/input_hub.hpp" // for InputHub
+#include "telemetry/binary_log.hpp" // for BinaryLog
 
 /**
  * @namespace globals
@@ -24,6 +26,23 @@ namespace globals {
  */
 extern pros::Controller controller;
 
+/**
+ * @brief Single-poll input source built on the master controller
+ *
+ * Polled once per drive tick; subsystems receive InputFrames from it instead
+ * of querying the controller themselves.
+ * Defined as extern here, instantiated in globals.cpp.
+ */
+extern InputHub input;
+
+/**
+ * @brief Binary telemetry ring, written from any task
+ *
+ * Logging only copies bytes; the drain task started in initialize() formats
+ * or stores them. Defined as extern here, instantiated in globals.cpp.
+ */
+extern BinaryLog telemetry;
+
 /**
  * @enum SensorColors
  * @brief Represents detected alliance colors from optical sensors
@@ -0,0 +1,216 @@
+/**
+ * @file cached_actuators.hpp
+ * @brief Write-through command caches for motors and ADI digital outputs
+ *
+ * Subsystems command their actuators every tick, but the command rarely
+ * changes: a stopped intake is told move(0) every 10 ms. These wrappers only
+ * forward a write to the device when the commanded value or mode changes (or
+ * an optional keep-alive interval has elapsed), and count the writes they
+ * avoided so the recovered smart-port bandwidth can be measured.
+ *
+ * The wrappers hold a reference to an existing device, so the same device can
+ * still be handed to LemLib. Anything that writes to the device behind the
+ * cache's back must be followed by invalidate().
+ */
+
+#ifndef CACHED_ACTUATORS_HPP
+#define CACHED_ACTUATORS_HPP
+
+#include <cstdint>
+
+#include "pros/adi.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "pros/rtos.hpp"
+
+/**
+ * @struct WriteStats
+ * @brief Per-device write counters
+ */
+struct WriteStats {
+  uint32_t issued = 0;  ///< Writes forwarded to the device
+  uint32_t avoided = 0; ///< Writes suppressed because nothing changed
+};
+
+/**
+ * @class CommandCache
+ * @brief Decides whether a command needs to reach the device
+ *
+ * Device-agnostic and clock-agnostic; the caller supplies the time.
+ */
+class CommandCache {
+public:
+  /**
+   * @brief Constructor
+   * @param keepAliveMs Re-send an unchanged command after this long (0 = never)
+   */
+  explicit CommandCache(uint32_t keepAliveMs = 0)
+      : keepAliveMs(keepAliveMs) {}
+
+  /**
+   * @brief Records a command and reports whether it must be written
+   * @param mode Caller-defined command mode (e.g. voltage vs velocity)
+   * @param value Commanded value
+   * @param nowMs Current time in milliseconds
+   * @return true if the device should be written
+   */
+  bool should_write(uint8_t mode, int32_t value, uint32_t nowMs);
+
+  /**
+   * @brief Seeds the cache with a state the device is already known to be in
+   */
+  void assume(uint8_t mode, int32_t value, uint32_t nowMs);
+
+  /**
+   * @brief Forgets the cached command so the next one is always written
+   */
+  void invalidate() { valid = false; }
+
+  /**
+   * @brief Whether a command has been cached
+   */
+  bool is_valid() const { return valid; }
+
+  /**
+   * @brief Last cached value (meaningful only if is_valid())
+   */
+  int32_t value() const { return lastValue; }
+
+  const WriteStats& stats() const { return writeStats; }
+
+private:
+  uint32_t keepAliveMs;
+  bool valid = false;
+  uint8_t lastMode = 0;
+  int32_t lastValue = 0;
+  uint32_t lastWriteMs = 0;
+  WriteStats writeStats;
+};
+
+/**
+ * @class CachedMotorOutput
+ * @brief Command cache in front of a pros::Motor or pros::MotorGroup
+ */
+template <typename MotorType> class CachedMotorOutput {
+public:
+  /**
+   * @brief Constructor
+   * @param motor Device to write to
+   * @param keepAliveMs Re-send an unchanged command after this long (0 = never)
+   */
+  explicit CachedMotorOutput(MotorType& motor, uint32_t keepAliveMs = 0)
+      : motor(motor),
+        cache(keepAliveMs) {}
+
+  /**
+   * @brief Cached pros::Motor::move() (-127 to 127)
+   */
+  void move(int32_t voltage) {
+    if (cache.should_write(MOVE, voltage, pros::millis())) {
+      motor.move(voltage);
+    }
+  }
+
+  /**
+   * @brief Cached pros::Motor::move_velocity() (RPM)
+   */
+  void move_velocity(int32_t velocity) {
+    if (cache.should_write(VELOCITY, velocity, pros::millis())) {
+      motor.move_velocity(velocity);
+    }
+  }
+
+  /**
+   * @brief Cached pros::Motor::move_voltage() (mV)
+   */
+  void move_voltage(int32_t millivolts) {
+    if (cache.should_write(VOLTAGE, millivolts, pros::millis())) {
+      motor.move_voltage(millivolts);
+    }
+  }
+
+  /**
+   * @brief Forces the next command through, e.g. after LemLib drove the motor directly
+   */
+  void invalidate() { cache.invalidate(); }
+
+  WriteStats stats() const { return cache.stats(); }
+
+  MotorType& device() { return motor; }
+
+private:
+  enum Mode : uint8_t { MOVE, VELOCITY, VOLTAGE };
+
+  MotorType& motor;
+  CommandCache cache;
+};
+
+using CachedMotor = CachedMotorOutput<pros::Motor>;
+using CachedMotorGroup = CachedMotorOutput<pros::MotorGroup>;
+
+/**
+ * @brief Physical write for a plain digital output
+ */
+inline void write_digital(pros::adi::DigitalOut& out, bool state) { out.set_value(state); }
+
+/**
+ * @brief Physical write for a pneumatic, keeping its own extended flag in sync
+ */
+inline void write_digital(pros::adi::Pneumatics& out, bool state) {
+  if (state) {
+    out.extend();
+  } else {
+    out.retract();
+  }
+}
+
+/**
+ * @class CachedDigitalOutput
+ * @brief Command cache in front of a pros::adi::DigitalOut or pros::adi::Pneumatics
+ */
+template <typename OutputType> class CachedDigitalOutput {
+public:
+  /**
+   * @brief Constructor
+   * @param output Device to write to
+   * @param initialState State the device was constructed in
+   * @param keepAliveMs Re-send an unchanged state after this long (0 = never)
+   */
+  CachedDigitalOutput(OutputType& output, bool initialState, uint32_t keepAliveMs = 0)
+      : output(output),
+        cache(keepAliveMs) {
+    cache.assume(0, initialState, 0);
+  }
+
+  /**
+   * @brief Sets the output, writing only if the state changes
+   */
+  void set(bool state) {
+    if (cache.should_write(0, state, pros::millis())) {
+      write_digital(output, state);
+    }
+  }
+
+  /**
+   * @brief Flips the output
+   */
+  void toggle() { set(!get()); }
+
+  /**
+   * @brief Last commanded state
+   */
+  bool get() const { return cache.value() != 0; }
+
+  WriteStats stats() const { return cache.stats(); }
+
+  OutputType& device() { return output; }
+
+private:
+  OutputType& output;
+  CommandCache cache;
+};
+
+using CachedDigitalOut = CachedDigitalOutput<pros::adi::DigitalOut>;
+using CachedPneumatics = CachedDigitalOutput<pros::adi::Pneumatics>;
+
+#endif // CACHED_ACTUATORS_HPP
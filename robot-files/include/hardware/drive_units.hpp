@@ -0,0 +1,61 @@
+/**
+ * @file drive_units.hpp
+ * @brief Conversions between motor RPM and wheel ground speed
+ *
+ * pros::Motor velocities (get_actual_velocity, move_velocity) are in RPM of
+ * the cartridge output shaft, where full scale depends on the cartridge. The
+ * drivetrain is described the LemLib way, by wheel diameter and wheel RPM.
+ * Raw encoder ticks (get_raw_position) count 50 per motor revolution, which
+ * the cartridge reduces to 1800, 900 or 300 per output revolution.
+ */
+
+#ifndef DRIVE_UNITS_HPP
+#define DRIVE_UNITS_HPP
+
+#include <cmath>
+
+#include "pros/abstract_motor.hpp"
+
+/**
+ * @brief Free speed of a cartridge, which is also move_velocity's full scale
+ */
+inline float cartridge_rpm(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red: return 100;
+    case pros::MotorGears::green: return 200;
+    default: return 600;
+  }
+}
+
+/**
+ * @brief Inches per second of ground speed per motor RPM
+ * @param wheelDiameter Wheel diameter (inches)
+ * @param wheelRpm Wheel speed when the motors run at cartridge free speed
+ * @param gearing Motor cartridge
+ */
+inline float inches_per_second_per_rpm(float wheelDiameter, float wheelRpm, pros::MotorGears gearing) {
+  return static_cast<float>(M_PI) * wheelDiameter / 60 * wheelRpm / cartridge_rpm(gearing);
+}
+
+/**
+ * @brief Raw encoder ticks per cartridge output revolution
+ */
+inline float cartridge_ticks_per_rev(pros::MotorGears gearing) {
+  switch (gearing) {
+    case pros::MotorGears::red: return 1800;
+    case pros::MotorGears::green: return 900;
+    default: return 300;
+  }
+}
+
+/**
+ * @brief Inches of ground travel per raw encoder tick
+ * @param wheelDiameter Wheel diameter (inches)
+ * @param wheelRpm Wheel speed when the motors run at cartridge free speed
+ * @param gearing Motor cartridge
+ */
+inline float inches_per_tick(float wheelDiameter, float wheelRpm, pros::MotorGears gearing) {
+  return static_cast<float>(M_PI) * wheelDiameter * wheelRpm / cartridge_rpm(gearing) / cartridge_ticks_per_rev(gearing);
+}
+
+#endif // DRIVE_UNITS_HPP
@@ -0,0 +1,61 @@
+/**
+ * @file pulse_override.hpp
+ * @brief Lets a high-priority task briefly take a motor from the subsystem that owns it
+ *
+ * A subsystem writes its motor every tick through a CachedMotor from the
+ * mechanism lane. An eject pulse must start on its own, more precise clock,
+ * so it writes the device directly. While a pulse holds the motor, the
+ * owner's commands are only remembered. When the pulse ends, the owner's
+ * latest command is put back and its cache is resynchronised.
+ */
+
+#ifndef PULSE_OVERRIDE_HPP
+#define PULSE_OVERRIDE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "hardware/cached_actuators.hpp"
+#include "pros/rtos.hpp"
+
+/**
+ * @class PulseOverride
+ * @brief Arbitrates one motor between its owner and a pulse
+ */
+class PulseOverride {
+public:
+  /**
+   * @brief Constructor
+   * @param output The owner's cached output for the motor
+   */
+  explicit PulseOverride(CachedMotor& output)
+      : output(output) {}
+
+  /**
+   * @brief Owner command (-127 to 127); held back while a pulse runs
+   */
+  void move(int32_t voltage);
+
+  /**
+   * @brief Takes the motor and drives it at the given power (any task)
+   */
+  void begin(int32_t voltage);
+
+  /**
+   * @brief Gives the motor back at the owner's latest command (any task)
+   */
+  void end();
+
+  /**
+   * @brief Whether a pulse holds the motor
+   */
+  bool active() const { return held; }
+
+private:
+  CachedMotor& output;
+  pros::Mutex mutex;
+  int32_t commanded = 0; ///< Owner's latest command
+  std::atomic<bool> held{false};
+};
+
+#endif // PULSE_OVERRIDE_HPP
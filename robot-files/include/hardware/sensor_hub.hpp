@@ -0,0 +1,201 @@
+/**
+ * @file sensor_hub.hpp
+ * @brief Background task that reads every configured sensor once per cycle
+ *
+ * Rather than each consumer querying devices whenever it likes, SensorHub
+ * samples all of them together on one task and publishes an immutable,
+ * timestamped SensorSnapshot. Every consumer reading the same snapshot sees
+ * the same instant, and each device is only queried once per cycle.
+ */
+
+#ifndef SENSOR_HUB_HPP
+#define SENSOR_HUB_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pros/gps.hpp"
+#include "pros/imu.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/rotation.hpp"
+#include "scheduler/loop_timer.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @struct DeviceHealth
+ * @brief Connection state of one device as of the snapshot
+ */
+struct DeviceHealth {
+  bool present = false;      ///< Device was configured (non-null)
+  bool connected = false;    ///< Last read succeeded
+  bool stale = false;        ///< No fresh data for longer than the stale timeout
+  uint32_t lastGoodMs = 0;   ///< When the device last returned fresh data
+};
+
+/**
+ * @struct MotorGroupSample
+ * @brief Batched readings from every motor in a group
+ */
+struct MotorGroupSample {
+  static constexpr std::size_t MAX_MOTORS = 4;
+
+  uint8_t count = 0;                              ///< Motors in the group (up to MAX_MOTORS)
+  uint32_t deviceTimestampMs = 0;                 ///< Motor-side timestamp of the raw positions
+  std::array<int32_t, MAX_MOTORS> rawPosition{};  ///< Encoder ticks, from get_raw_position_all()
+  std::array<double, MAX_MOTORS> position{};      ///< Encoder units, from get_position_all()
+  std::array<double, MAX_MOTORS> velocity{};      ///< RPM, from get_actual_velocity_all()
+  std::array<int32_t, MAX_MOTORS> currentMa{};    ///< mA, from get_current_draw_all()
+  std::array<double, MAX_MOTORS> temperatureC{};  ///< Degrees C, from get_temperature_all()
+  DeviceHealth health;
+};
+
+/**
+ * @brief Mean raw encoder position (ticks) over the motors in a group; 0 for an empty group
+ */
+inline float mean_raw_position(const MotorGroupSample& sample) {
+  if (sample.count == 0) {
+    return 0;
+  }
+  double total = 0;
+  for (std::size_t i = 0; i < sample.count; i++) {
+    total += sample.rawPosition[i];
+  }
+  return static_cast<float>(total / sample.count);
+}
+
+/**
+ * @struct RotationSample
+ * @brief Reading from a V5 rotation sensor
+ */
+struct RotationSample {
+  int32_t positionCdeg = 0; ///< Centidegrees
+  int32_t velocityCdps = 0; ///< Centidegrees per second
+  uint64_t readUs = 0;      ///< When the position was read; the sensor itself stamps nothing
+  DeviceHealth health;
+};
+
+/**
+ * @struct ImuSample
+ * @brief Reading from a V5 inertial sensor
+ */
+struct ImuSample {
+  double rotationDeg = 0; ///< Unbounded heading
+  double headingDeg = 0;  ///< Heading in [0, 360)
+  double gyroZDps = 0;    ///< Yaw rate
+  DeviceHealth health;
+};
+
+/**
+ * @struct GpsSample
+ * @brief Reading from a V5 GPS sensor, converted to inches
+ */
+struct GpsSample {
+  double x = 0;          ///< Field x (inches, field centre origin)
+  double y = 0;          ///< Field y (inches)
+  double headingDeg = 0; ///< Compass heading
+  double errorIn = 0;    ///< Sensor's own RMS position error estimate (inches)
+  DeviceHealth health;
+};
+
+/**
+ * @struct BatterySample
+ * @brief Reading from the robot battery
+ */
+struct BatterySample {
+  int32_t voltageMv = 0;  ///< Latest reading
+  float filteredMv = 0;   ///< Low-passed, so motor current spikes do not jerk compensation around
+  int32_t currentMa = 0;  ///< Latest reading
+  DeviceHealth health;
+};
+
+/**
+ * @struct SensorSnapshot
+ * @brief Everything SensorHub read in one cycle
+ */
+struct SensorSnapshot {
+  static constexpr std::size_t MAX_IMUS = 2;
+
+  uint32_t cycle = 0;      ///< Increments every cycle
+  uint64_t timestampUs = 0; ///< When the cycle started reading
+  uint32_t readTimeUs = 0; ///< How long reading every device took
+  MotorGroupSample leftDrive;
+  MotorGroupSample rightDrive;
+  RotationSample verticalRotation;
+  RotationSample horizontalRotation;
+  std::array<ImuSample, MAX_IMUS> imu; ///< Indexed like the constructor's IMUs
+  GpsSample gps;
+  BatterySample battery;
+};
+
+/**
+ * @class SensorHub
+ * @brief Samples configured devices on a fixed period and publishes snapshots
+ *
+ * Devices are passed in like lemlib::OdomSensors; pass nullptr for any device
+ * the robot does not have. Readers call snapshot() from any task without
+ * locking.
+ */
+class SensorHub {
+public:
+  /**
+   * @brief Constructor
+   * @param leftDrive Left drive motor group, or nullptr
+   * @param rightDrive Right drive motor group, or nullptr
+   * @param verticalRotation Vertical tracking wheel sensor, or nullptr
+   * @param horizontalRotation Horizontal tracking wheel sensor, or nullptr
+   * @param imu Inertial sensor, or nullptr
+   * @param imu2 Second inertial sensor, or nullptr
+   * @param gps GPS sensor, or nullptr
+   */
+  SensorHub(pros::MotorGroup* leftDrive, pros::MotorGroup* rightDrive, pros::Rotation* verticalRotation,
+            pros::Rotation* horizontalRotation, pros::Imu* imu, pros::Imu* imu2 = nullptr,
+            pros::Gps* gps = nullptr);
+
+  /**
+   * @brief Starts the sampling task; does nothing if already started
+   * @param periodMs Sampling period
+   * @param taskPriority PROS task priority
+   */
+  void start(uint32_t periodMs, uint32_t taskPriority);
+
+  /**
+   * @brief Reads every device once and publishes the result
+   *
+   * Called by the sampling task; exposed so a caller can force a sample.
+   * Must not run concurrently with the sampling task.
+   */
+  void sample();
+
+  /**
+   * @brief Latest published snapshot
+   */
+  SensorSnapshot snapshot() const;
+
+  /**
+   * @brief Sampling loop timing statistics
+   */
+  LoopStats loop_stats() const;
+
+private:
+  void read_motor_group(pros::MotorGroup* group, MotorGroupSample& sample, uint32_t nowMs);
+  void read_rotation(pros::Rotation* sensor, RotationSample& sample, uint32_t nowMs);
+  void read_imu(pros::Imu* sensor, ImuSample& sample, uint32_t nowMs);
+  void read_gps(pros::Gps* sensor, GpsSample& sample, uint32_t nowMs);
+  void read_battery(BatterySample& sample, uint32_t nowMs);
+
+  pros::MotorGroup* leftDrive;
+  pros::MotorGroup* rightDrive;
+  pros::Rotation* verticalRotation;
+  pros::Rotation* horizontalRotation;
+  std::array<pros::Imu*, SensorSnapshot::MAX_IMUS> imus;
+  pros::Gps* gps;
+
+  SensorSnapshot working; ///< Owned by the sampling task; carries health between cycles
+  SnapshotBuffer<SensorSnapshot> published;
+  LoopTimer loop;
+  std::atomic<bool> started;
+};
+
+#endif // SENSOR_HUB_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file voltage_compensation.hpp
+ * @brief Battery-voltage compensation and error-magnitude gain scheduling
+ *
+ * pros::Motor::move() takes a fraction of the *battery* voltage, so the same
+ * command gives less torque at 11.5 V late in a run than at 12.8 V fresh off
+ * the charger. Scaling commands by nominal / battery makes a command mean the
+ * same voltage whatever the charge, which keeps autonomous timing and tuned
+ * gains reproducible.
+ *
+ * Everything is constexpr; src/hardware/voltage_compensation.cpp checks a
+ * table of expected scaling at compile time.
+ */
+
+#ifndef VOLTAGE_COMPENSATION_HPP
+#define VOLTAGE_COMPENSATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+/**
+ * @brief Multiplier taking a command tuned at nominal voltage to the present battery voltage
+ * @param batteryMv Battery voltage; 0 or less means unknown and gives 1
+ * @param nominalMv Voltage the gains were tuned at
+ * @param minMv Floor on the battery voltage, so a bad reading or brownout cannot blow up commands
+ */
+constexpr float battery_scale(float batteryMv, float nominalMv, float minMv) {
+  if (batteryMv <= 0) {
+    return 1;
+  }
+  return nominalMv / std::max(batteryMv, minMv);
+}
+
+/**
+ * @struct CompensatedSides
+ * @brief move() commands for both drive sides after compensation
+ */
+struct CompensatedSides {
+  float left = 0;
+  float right = 0;
+};
+
+/**
+ * @brief Scales both sides' move() commands and desaturates them together
+ *
+ * If scaling pushes a side past full scale, both sides shrink by the same
+ * ratio, so the difference between them (the turn) keeps its share instead
+ * of being clipped off one side.
+ */
+constexpr CompensatedSides compensate_sides(float left, float right, float scale) {
+  left *= scale;
+  right *= scale;
+  const float largest = std::max(left < 0 ? -left : left, right < 0 ? -right : right);
+  if (largest > 127) {
+    left *= 127 / largest;
+    right *= 127 / largest;
+  }
+  return {left, right};
+}
+
+/**
+ * @struct GainSchedule
+ * @brief Piecewise-linear gain multiplier by error magnitude
+ *
+ * Lets a loop run a different effective gain far from the target (where
+ * output saturates anyway) than close to it. Breakpoints must be sorted by
+ * error; outside them the end values hold.
+ */
+template <size_t N> struct GainSchedule {
+  std::array<float, N> error; ///< |error| breakpoints, ascending
+  std::array<float, N> scale; ///< Multiplier at each breakpoint
+
+  /**
+   * @brief Multiplier for an error (sign ignored)
+   */
+  constexpr float at(float value) const {
+    const float magnitude = value < 0 ? -value : value;
+    if (magnitude <= error[0]) {
+      return scale[0];
+    }
+    for (size_t i = 1; i < N; i++) {
+      if (magnitude <= error[i]) {
+        const float f = (magnitude - error[i - 1]) / (error[i] - error[i - 1]);
+        return scale[i - 1] + (scale[i] - scale[i - 1]) * f;
+      }
+    }
+    return scale[N - 1];
+  }
+};
+
+#endif // VOLTAGE_COMPENSATION_HPP
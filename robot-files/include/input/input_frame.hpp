@@ -0,0 +1,81 @@
+/**
+ * @file input_frame.hpp
+ * @brief One coherent snapshot of controller state, with button edges
+ *
+ * Captured once per tick and handed to every subsystem's control(), so the
+ * same buttons are not re-read from the controller by each subsystem and all
+ * subsystems act on the same view of the input.
+ */
+
+#ifndef INPUT_FRAME_HPP
+#define INPUT_FRAME_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "pros/misc.h" // for controller_digital_e_t, controller_analog_e_t
+
+/**
+ * @struct InputFrame
+ * @brief Button levels and edges as bitfields plus the four joystick axes
+ *
+ * Bit i of each mask is button (pros::E_CONTROLLER_DIGITAL_L1 + i).
+ */
+struct InputFrame {
+  static constexpr int FIRST_BUTTON = pros::E_CONTROLLER_DIGITAL_L1;
+  static constexpr int BUTTON_COUNT = pros::E_CONTROLLER_DIGITAL_A - pros::E_CONTROLLER_DIGITAL_L1 + 1;
+  static constexpr int AXIS_COUNT = 4;
+
+  uint16_t held = 0;     ///< Buttons currently down
+  uint16_t pressed = 0;  ///< Buttons that went down since the previous frame
+  uint16_t released = 0; ///< Buttons that went up since the previous frame
+  std::array<int8_t, AXIS_COUNT> axes = {}; ///< Indexed by pros::controller_analog_e_t
+  uint32_t timestampMs = 0;                 ///< When the frame was captured
+
+  /**
+   * @brief Bit for a button in the held/pressed/released masks
+   */
+  static constexpr uint16_t mask(pros::controller_digital_e_t button) {
+    return static_cast<uint16_t>(1u << (button - FIRST_BUTTON));
+  }
+
+  /**
+   * @brief Builds the next frame from raw levels, deriving edges against the previous frame
+   * @param previous Frame captured on the previous tick
+   * @param held Buttons currently down
+   * @param axes Current joystick values
+   * @param timestampMs Capture time
+   */
+  static constexpr InputFrame next(const InputFrame& previous, uint16_t held,
+                                   const std::array<int8_t, AXIS_COUNT>& axes, uint32_t timestampMs) {
+    InputFrame frame;
+    frame.held = held;
+    frame.pressed = static_cast<uint16_t>(held & ~previous.held);
+    frame.released = static_cast<uint16_t>(~held & previous.held);
+    frame.axes = axes;
+    frame.timestampMs = timestampMs;
+    return frame;
+  }
+
+  /**
+   * @brief Whether a button is currently down
+   */
+  constexpr bool is_held(pros::controller_digital_e_t button) const { return held & mask(button); }
+
+  /**
+   * @brief Whether a button went down since the previous frame (rising edge)
+   */
+  constexpr bool was_pressed(pros::controller_digital_e_t button) const { return pressed & mask(button); }
+
+  /**
+   * @brief Whether a button went up since the previous frame (falling edge)
+   */
+  constexpr bool was_released(pros::controller_digital_e_t button) const { return released & mask(button); }
+
+  /**
+   * @brief Joystick value in [-127, 127]
+   */
+  constexpr int axis(pros::controller_analog_e_t channel) const { return axes[channel]; }
+};
+
+#endif // INPUT_FRAME_HPP
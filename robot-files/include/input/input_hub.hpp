@@ -0,0 +1,73 @@
+/**
+ * @file input_hub.hpp
+ * @brief Polls the controller once per tick and hands out InputFrames
+ */
+
+#ifndef INPUT_HUB_HPP
+#define INPUT_HUB_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "input/input_frame.hpp"
+#include "pros/misc.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @class InputHub
+ * @brief Single point of controller access shared by every subsystem
+ *
+ * poll() is the only place the controller is queried. Subsystems scheduled at
+ * a slower period than the poll subscribe as a reader: each reader keeps its
+ * own latched edges, so a button tapped between two 50 ms pneumatic ticks is
+ * still seen exactly once.
+ *
+ * Nothing here takes a lock. Frames go out through a SnapshotBuffer and each
+ * reader's edges are latched with atomic or/exchange, so a task deleted
+ * mid-call (PROS does this to the competition tasks) can never leave the hub
+ * blocked for everyone else. poll() must only be called from one task.
+ */
+class InputHub {
+public:
+  static constexpr std::size_t MAX_READERS = 8;
+
+  /**
+   * @brief Constructor
+   * @param controller Controller to poll
+   */
+  explicit InputHub(pros::Controller& controller);
+
+  /**
+   * @brief Registers a reader with its own edge latch
+   * @return Reader id to pass to read(), or -1 if MAX_READERS is exceeded
+   */
+  int subscribe();
+
+  /**
+   * @brief Reads every button and axis once and publishes the new frame (single task only)
+   */
+  void poll();
+
+  /**
+   * @brief Most recent frame, with edges since the previous poll
+   */
+  InputFrame latest();
+
+  /**
+   * @brief Most recent frame, with every edge since this reader's previous read
+   * @param reader Id returned by subscribe()
+   */
+  InputFrame read(int reader);
+
+private:
+  pros::Controller& controller;
+  InputFrame current; ///< Last frame poll() built; only poll() touches it
+  SnapshotBuffer<InputFrame> frames;
+  std::array<std::atomic<uint16_t>, MAX_READERS> pendingPressed = {};
+  std::array<std::atomic<uint16_t>, MAX_READERS> pendingReleased = {};
+  std::atomic<std::size_t> readerCount{0};
+};
+
+#endif // INPUT_HUB_HPP
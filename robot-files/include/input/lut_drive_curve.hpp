@@ -0,0 +1,52 @@
+/**
+ * @file lut_drive_curve.hpp
+ * @brief Lookup-table drive curve with lemlib::ExpoDriveCurve semantics
+ */
+
+#ifndef LUT_DRIVE_CURVE_HPP
+#define LUT_DRIVE_CURVE_HPP
+
+#include <array>
+
+#include "lemlib/chassis/chassis.hpp" // for lemlib::DriveCurve (driveCurve.hpp has no include guard)
+
+/**
+ * @class LutDriveCurve
+ * @brief Drive curve precomputed for every joystick value
+ *
+ * Joystick input is always an integer in [-127, 127], so the exponential in
+ * lemlib::ExpoDriveCurve only ever produces 255 distinct outputs. They are all
+ * computed once at construction by an ExpoDriveCurve with the same deadband,
+ * minimum output and curve gain, so the two are equivalent by construction
+ * and the per-tick cost is one array load.
+ */
+class LutDriveCurve : public lemlib::DriveCurve {
+public:
+  static constexpr int INPUT_LIMIT = 127;
+  static constexpr int TABLE_SIZE = 2 * INPUT_LIMIT + 1;
+
+  /**
+   * @brief Constructor - see lemlib::ExpoDriveCurve for parameter meaning
+   * @param deadband range where input is considered to be zero
+   * @param minOutput the minimum output that can be returned
+   * @param curve how "curved" the graph is
+   */
+  LutDriveCurve(float deadband, float minOutput, float curve);
+
+  /**
+   * @brief Curved output for an integer joystick value - the hot path
+   * @param input joystick value; clamped to [-127, 127]
+   * @return output truncated to int, exactly as Chassis::arcade/tank use it
+   */
+  int lookup(int input) const;
+
+  /**
+   * @brief lemlib::DriveCurve interface; rounds to the nearest table entry
+   */
+  float curve(float input) override;
+
+private:
+  std::array<float, TABLE_SIZE> table;
+};
+
+#endif // LUT_DRIVE_CURVE_HPP
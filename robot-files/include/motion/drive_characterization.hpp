@@ -0,0 +1,127 @@
+/**
+ * @file drive_characterization.hpp
+ * @brief Quasistatic and step-voltage tests for fitting drive feedforward
+ *
+ * Each test drives both sides with a known voltage (a slow ramp, so
+ * acceleration is negligible, or a sudden step, so it dominates) and logs
+ * the commanded voltage with the wheel velocity SensorHub measured. save()
+ * writes a CSV with acceleration differentiated from velocity;
+ * tools/feedforward_fitter.cpp turns it into kS/kV/kA per side.
+ *
+ * Samples go into a fixed in-memory log during the tests, so SD card writes
+ * never stall the sampling loop.
+ */
+
+#ifndef DRIVE_CHARACTERIZATION_HPP
+#define DRIVE_CHARACTERIZATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/sensor_hub.hpp"
+#include "pros/motor_group.hpp"
+
+/**
+ * @brief Which test a sample belongs to
+ */
+enum class CharacterizationTest : uint8_t {
+  QUASISTATIC_FORWARD = 0,
+  QUASISTATIC_REVERSE,
+  STEP_FORWARD,
+  STEP_REVERSE
+};
+
+/**
+ * @struct CharacterizationSample
+ * @brief One logged instant of one test
+ */
+struct CharacterizationSample {
+  CharacterizationTest test = CharacterizationTest::QUASISTATIC_FORWARD;
+  uint64_t timestampUs = 0; ///< SensorHub snapshot time
+  float leftVolts = 0;      ///< Commanded
+  float rightVolts = 0;     ///< Commanded
+  float leftVelocity = 0;   ///< Measured wheel ground speed (in/s)
+  float rightVelocity = 0;  ///< Measured wheel ground speed (in/s)
+};
+
+/**
+ * @class DriveCharacterization
+ * @brief Runs characterization tests and logs the results
+ *
+ * Tests block the calling task. Give the robot room: the quasistatic tests
+ * drive several feet, and between tests the robot should be repositioned.
+ */
+class DriveCharacterization {
+public:
+  static constexpr size_t MAX_SAMPLES = 4000; ///< 40 s at 10 ms
+
+  /**
+   * @brief Constructor
+   * @param left Left drive motors
+   * @param right Right drive motors
+   * @param sensorHub Hub sampling both groups
+   * @param wheelDiameter Drive wheel diameter (inches)
+   * @param wheelRpm Wheel RPM at cartridge free speed
+   */
+  DriveCharacterization(pros::MotorGroup& left, pros::MotorGroup& right, const SensorHub& sensorHub,
+                        float wheelDiameter, float wheelRpm);
+
+  /**
+   * @brief Ramps voltage linearly from 0
+   * @param forwards Drive forwards (true) or backwards (false)
+   * @param voltsPerSecond Ramp rate
+   * @param durationMs How long to ramp
+   * @param samplePeriodMs Logging period
+   */
+  void run_quasistatic(bool forwards, float voltsPerSecond, uint32_t durationMs, uint32_t samplePeriodMs);
+
+  /**
+   * @brief Applies a constant voltage from rest
+   * @param forwards Drive forwards (true) or backwards (false)
+   * @param volts Step size
+   * @param durationMs How long to hold it
+   * @param samplePeriodMs Logging period
+   */
+  void run_step(bool forwards, float volts, uint32_t durationMs, uint32_t samplePeriodMs);
+
+  /**
+   * @brief Writes the log as CSV
+   * @param path File to write (e.g. on /usd)
+   * @return false if there is no SD card or the file could not be written
+   */
+  bool save(const char* path) const;
+
+  /**
+   * @brief Samples logged so far (stops growing at MAX_SAMPLES)
+   */
+  size_t sample_count() const;
+
+  /**
+   * @brief Discards the log
+   */
+  void clear();
+
+private:
+  /**
+   * @brief Drives both sides at a voltage (mV)
+   */
+  void command(int32_t millivolts);
+
+  /**
+   * @brief Logs the latest snapshot against the commanded voltage
+   */
+  void record(CharacterizationTest test, float volts);
+
+  pros::MotorGroup& left;
+  pros::MotorGroup& right;
+  const SensorHub& sensorHub;
+  float wheelDiameter;
+  float wheelRpm;
+
+  std::array<CharacterizationSample, MAX_SAMPLES> samples;
+  size_t count = 0;
+  uint32_t lastCycle = 0; ///< Snapshot cycle already logged
+};
+
+#endif // DRIVE_CHARACTERIZATION_HPP
@@ -0,0 +1,45 @@
+/**
+ * @file feedforward.hpp
+ * @brief Permanent-magnet DC motor feedforward: V = kS*sgn(v) + kV*v + kA*a
+ *
+ * The gains come from tools/feedforward_fitter.cpp run on a log recorded by
+ * DriveCharacterization. With them a motion gets the voltage it needs up
+ * front instead of waiting for error to build up in a PID loop.
+ *
+ * No PROS dependency.
+ */
+
+#ifndef FEEDFORWARD_HPP
+#define FEEDFORWARD_HPP
+
+/**
+ * @brief pros::Motor::move() output units per volt (127 = 12 V)
+ */
+constexpr float OUTPUT_PER_VOLT = 127.0f / 12.0f;
+
+/**
+ * @struct SimpleMotorFeedforward
+ * @brief Feedforward gains of one side of the drive
+ */
+struct SimpleMotorFeedforward {
+  float kS = 0; ///< Volts to overcome static friction
+  float kV = 0; ///< Volts per in/s
+  float kA = 0; ///< Volts per in/s^2
+
+  /**
+   * @brief Voltage for a wheel velocity and acceleration
+   */
+  constexpr float calculate(float velocity, float acceleration = 0) const {
+    const float direction = velocity > 0 ? 1.0f : (velocity < 0 ? -1.0f : 0.0f);
+    return kS * direction + kV * velocity + kA * acceleration;
+  }
+
+  /**
+   * @brief Same, in move() output units (-127 to 127 for +-12 V)
+   */
+  constexpr float output(float velocity, float acceleration = 0) const {
+    return calculate(velocity, acceleration) * OUTPUT_PER_VOLT;
+  }
+};
+
+#endif // FEEDFORWARD_HPP
@@ -0,0 +1,262 @@
+/**
+ * @file motion_chassis.hpp
+ * @brief lemlib::Chassis extended with profiled movements and path tracking
+ *
+ * LemLib's moveToPoint and turnToHeading run pure PID on the remaining error,
+ * which saturates at the start of a long move and then decelerates however
+ * the gains allow. The profiled variants here instead follow a time-optimal
+ * trapezoidal (or S-curve) reference: the per-side kS/kV/kA feedforward
+ * drives the planned velocity and acceleration, and the existing PID only
+ * corrects the tracking error. Packed paths are followed in place, by pure pursuit or by RAMSETE in
+ * time. All of these share LemLib's motion queue, so they mix freely with the
+ * stock motions, waitUntil() and waitUntilDone().
+ *
+ * In OutputMode::VOLTAGE these motions bypass the firmware's velocity
+ * controller: each side gets move_voltage() from a VelocityLoop closed on
+ * SensorHub's timestamped encoder reads.
+ */
+
+#ifndef MOTION_CHASSIS_HPP
+#define MOTION_CHASSIS_HPP
+
+#include "hardware/voltage_compensation.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "motion/feedforward.hpp"
+#include "motion/motion_profile.hpp"
+#include "motion/ramsete.hpp"
+#include "motion/velocity_loop.hpp"
+
+class EkfOdometry;
+class SensorHub;
+
+/**
+ * @struct ProfiledMoveParams
+ * @brief Optional parameters for MotionChassis::profiledMoveToPoint
+ */
+struct ProfiledMoveParams {
+  bool forwards = true;   ///< Drive forwards (true) or backwards (false)
+  float maxSpeed = 127;   ///< Output limit, 0-127
+  float maxVelocity = 0;  ///< Overrides the default velocity limit when > 0
+  float maxAcceleration = 0; ///< Overrides the default acceleration limit when > 0
+};
+
+/**
+ * @struct ProfiledTurnParams
+ * @brief Optional parameters for MotionChassis::profiledTurnToHeading
+ */
+struct ProfiledTurnParams {
+  lemlib::AngularDirection direction = lemlib::AngularDirection::AUTO; ///< Turn direction
+  float maxSpeed = 127;   ///< Output limit, 0-127
+  float maxVelocity = 0;  ///< Overrides the default velocity limit when > 0
+  float maxAcceleration = 0; ///< Overrides the default acceleration limit when > 0
+};
+
+/**
+ * @struct OutputCompensation
+ * @brief Battery compensation and PID gain scheduling for MotionChassis outputs
+ */
+struct OutputCompensation {
+  const SensorHub* sensorHub = nullptr; ///< Battery voltage and drive encoders; nullptr disables compensation and voltage mode
+  float nominalMv = 12000;              ///< Voltage the gains and feedforward were tuned at
+  float minMv = 9000;                   ///< Floor on the battery reading
+  GainSchedule<3> lateralSchedule = {{0, 1, 2}, {1, 1, 1}}; ///< Lateral PID multiplier by |error| (inches)
+  GainSchedule<3> angularSchedule = {{0, 1, 2}, {1, 1, 1}}; ///< Angular PID multiplier by |error| (degrees)
+};
+
+/**
+ * @brief How MotionChassis motions drive the motors
+ */
+enum class OutputMode {
+  MOVE,   ///< move() with battery compensation; followTrajectory uses move_velocity()
+  VOLTAGE ///< move_voltage() from the outer VelocityLoop
+};
+
+/**
+ * @class MotionChassis
+ * @brief Chassis with profiled point/heading movements and packed-path following
+ */
+class MotionChassis : public lemlib::Chassis {
+public:
+  /**
+   * @brief Constructor
+   *
+   * The first six parameters are forwarded to lemlib::Chassis.
+   * @param lateralLimits Default profile limits for profiledMoveToPoint (inches)
+   * @param angularLimits Default profile limits for profiledTurnToHeading (degrees)
+   * @param leftFeedforward Characterized feedforward of the left side
+   * @param rightFeedforward Characterized feedforward of the right side
+   * @param ramsete Controller used by followTrajectory
+   * @param compensation Battery compensation and gain schedules for the move()-driven motions
+   * @param velocityGains Feedback gains of the per-side velocity loops used in OutputMode::VOLTAGE
+   */
+  MotionChassis(lemlib::Drivetrain drivetrain, lemlib::ControllerSettings linearSettings,
+                lemlib::ControllerSettings angularSettings, lemlib::OdomSensors sensors,
+                lemlib::DriveCurve* throttleCurve, lemlib::DriveCurve* steerCurve,
+                ProfileConstraints lateralLimits, ProfileConstraints angularLimits,
+                SimpleMotorFeedforward leftFeedforward, SimpleMotorFeedforward rightFeedforward,
+                RamseteController ramsete, OutputCompensation compensation = {},
+                VelocityLoopGains velocityGains = {});
+
+  /**
+   * @brief Drives straight to a point along a motion profile
+   *
+   * The profile runs along the line from the start pose to the target; the
+   * angular PID keeps the robot pointed at the target while far from it.
+   * After the profile ends the lateral exit conditions decide when to stop.
+   * waitUntil() distances are inches along that line.
+   * @param x Target x (inches)
+   * @param y Target y (inches)
+   * @param timeout Longest time the motion may run (ms)
+   * @param params Optional parameters
+   * @param async Return immediately and run in the background (true by default)
+   */
+  void profiledMoveToPoint(float x, float y, int timeout, ProfiledMoveParams params = {}, bool async = true);
+
+  /**
+   * @brief Turns in place to a heading along a motion profile
+   *
+   * After the profile ends the angular exit conditions decide when to stop.
+   * waitUntil() distances are degrees turned.
+   * @param theta Target heading (degrees)
+   * @param timeout Longest time the motion may run (ms)
+   * @param params Optional parameters
+   * @param async Return immediately and run in the background (true by default)
+   */
+  void profiledTurnToHeading(float theta, int timeout, ProfiledTurnParams params = {}, bool async = true);
+
+  /**
+   * @brief Follows a path asset with pure pursuit
+   *
+   * Packed assets (see packed_path.hpp) are read in place: the robot moves on
+   * the first tick with no parsing, at the precomputed target velocities
+   * (acceleration limited by the lateral profile limit) converted to output
+   * with the per-side feedforward. Text assets fall back to lemlib::Chassis::follow.
+   * waitUntil() distances are inches along the path.
+   * @param path Path asset; must outlive the motion (ASSET() objects do)
+   * @param lookahead Lookahead distance (inches)
+   * @param timeout Longest time the motion may run (ms)
+   * @param forwards Follow the path driving forwards (true by default)
+   * @param async Return immediately and run in the background (true by default)
+   */
+  void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+
+  /**
+   * @brief Tracks a packed path in time with RAMSETE
+   *
+   * The path is time-parameterised (acceleration limited by the lateral
+   * profile limit) and the robot is held to where it should be at each
+   * instant, not just to the line. Wheel speeds are converted to motor RPM
+   * with the drivetrain's wheel diameter, wheel RPM and the motors' cartridge,
+   * and sent with move_velocity, or go to the velocity loops in
+   * OutputMode::VOLTAGE. Does nothing for text assets.
+   * waitUntil() distances are inches along the path.
+   * @param path Packed path asset; must outlive the motion (ASSET() objects do)
+   * @param timeout Longest time the motion may run (ms)
+   * @param forwards Follow the path driving forwards (true by default)
+   * @param async Return immediately and run in the background (true by default)
+   */
+  void followTrajectory(const asset& path, int timeout, bool forwards = true, bool async = true);
+
+  /**
+   * @brief Replaces the lateral PID gains used by every motion
+   *
+   * For gains found at runtime (autotuning, gains loaded from the SD card).
+   * Only call while no motion is running.
+   */
+  void setLateralGains(float kP, float kI, float kD);
+
+  /**
+   * @brief Replaces the angular PID gains used by every motion
+   *
+   * Only call while no motion is running.
+   */
+  void setAngularGains(float kP, float kI, float kD);
+
+  /**
+   * @brief Sets the pose, restarting the attached pose estimator from it
+   *
+   * Hides lemlib::Chassis::setPose so that an estimator feeding the pose
+   * (see setPoseEstimator) cannot overwrite it with its old estimate.
+   * @param x X position (inches)
+   * @param y Y position (inches)
+   * @param theta Heading (degrees, or radians if radians is true)
+   * @param radians Whether theta is in radians
+   */
+  void setPose(float x, float y, float theta, bool radians = false);
+
+  /**
+   * @brief Sets the pose, restarting the attached pose estimator from it
+   */
+  void setPose(lemlib::Pose pose, bool radians = false);
+
+  /**
+   * @brief Attaches the estimator that owns the pose, or nullptr for LemLib's odometry
+   */
+  void setPoseEstimator(EkfOdometry* estimator);
+
+  /**
+   * @brief Selects how the motions above drive the motors
+   *
+   * LemLib's own motions are unaffected and always use move(). VOLTAGE needs
+   * a SensorHub in the OutputCompensation; without one MOVE is used. Only
+   * call while no motion is running.
+   */
+  void setOutputMode(OutputMode mode);
+
+  /**
+   * @brief Current output mode
+   */
+  OutputMode getOutputMode() const;
+
+private:
+  /**
+   * @struct SideCommand
+   * @brief What one side should do this period
+   */
+  struct SideCommand {
+    float velocity = 0;     ///< Planned wheel velocity (in/s)
+    float acceleration = 0; ///< Planned wheel acceleration (in/s^2)
+    float correction = 0;   ///< Feedback on top, in move() units
+  };
+
+  /**
+   * @brief Drives both sides in the current output mode
+   *
+   * MOVE sends feedforward plus correction through moveCompensated. VOLTAGE
+   * runs each side's VelocityLoop on the latest encoder reads, adds the
+   * correction converted to volts and sends move_voltage().
+   */
+  void driveSides(SideCommand left, SideCommand right);
+
+  /**
+   * @brief Resets the velocity loops; call when a motion starts
+   */
+  void resetOutput();
+
+
+  /**
+   * @brief Sends both sides through battery compensation
+   *
+   * Commands are in move() units at nominal voltage. If scaling pushes a side
+   * past full scale both are reduced by the same ratio, so curvature holds
+   * (compensate_sides(), whose expected behaviour is checked at compile time).
+   */
+  void moveCompensated(float left, float right);
+
+  ProfileConstraints lateralLimits;
+  ProfileConstraints angularLimits;
+  SimpleMotorFeedforward leftFeedforward;
+  SimpleMotorFeedforward rightFeedforward;
+  RamseteController ramsete;
+  OutputCompensation compensation;
+  EkfOdometry* poseEstimator = nullptr;
+  OutputMode outputMode = OutputMode::MOVE;
+  VelocityLoop leftVelocityLoop;
+  VelocityLoop rightVelocityLoop;
+  EncoderVelocityEstimator leftVelocity;
+  EncoderVelocityEstimator rightVelocity;
+  float inchesPerTick = 0;
+  uint32_t lastOutputMs = 0;
+};
+
+#endif // MOTION_CHASSIS_HPP
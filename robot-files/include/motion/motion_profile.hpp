@@ -0,0 +1,93 @@
+/**
+ * @file motion_profile.hpp
+ * @brief Time-optimal trapezoidal and jerk-limited (S-curve) motion profiles
+ *
+ * Pure math with no PROS dependency. A profile moves from rest to rest over a
+ * signed distance as fast as the velocity/acceleration (and optionally jerk)
+ * limits allow, and can be sampled at any time for the reference position,
+ * velocity and acceleration a tracking controller should follow.
+ */
+
+#ifndef MOTION_PROFILE_HPP
+#define MOTION_PROFILE_HPP
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @struct ProfileConstraints
+ * @brief Kinematic limits for a profile
+ *
+ * Units are whatever the caller uses for distance (inches, degrees, ...) per
+ * second, per second squared and per second cubed.
+ */
+struct ProfileConstraints {
+  float maxVelocity;
+  float maxAcceleration;
+  float maxJerk = 0; ///< 0 gives a trapezoidal profile; > 0 gives a jerk-limited S-curve
+};
+
+/**
+ * @struct ProfileState
+ * @brief Reference state at one instant
+ */
+struct ProfileState {
+  float position = 0;
+  float velocity = 0;
+  float acceleration = 0;
+};
+
+/**
+ * @class MotionProfile
+ * @brief Rest-to-rest profile made of up to seven constant-jerk segments
+ *
+ * A trapezoid is the special case of three constant-acceleration segments
+ * (accelerate, cruise, decelerate). When the distance is too short to reach
+ * the velocity limit the cruise segment disappears and the peak velocity is
+ * lowered so the profile stays time-optimal under the limits.
+ */
+class MotionProfile {
+public:
+  /**
+   * @brief Builds the profile
+   * @param distance Signed distance to travel
+   * @param constraints Kinematic limits (magnitudes)
+   */
+  MotionProfile(float distance, ProfileConstraints constraints);
+
+  /**
+   * @brief Reference state at time t; clamped to the start/end outside [0, duration()]
+   * @param t Seconds since the profile started
+   */
+  ProfileState sample(float t) const;
+
+  /**
+   * @brief Total time of the profile in seconds
+   */
+  float duration() const;
+
+  /**
+   * @brief Peak velocity actually reached (magnitude)
+   */
+  float peak_velocity() const;
+
+private:
+  struct Segment {
+    float duration = 0;
+    float jerk = 0;
+    ProfileState start; ///< State at the beginning of the segment
+  };
+
+  /**
+   * @brief Appends a segment starting where the previous one ends
+   */
+  void push(float duration, float jerk, float acceleration);
+
+  std::array<Segment, 7> segments;
+  std::size_t segmentCount = 0;
+  float sign = 1;
+  float totalDuration = 0;
+  float peakVelocity = 0;
+};
+
+#endif // MOTION_PROFILE_HPP
@@ -0,0 +1,127 @@
+/**
+ * @file output_latency.hpp
+ * @brief Measures command-to-motion delay of the two drive output paths
+ *
+ * Each trial commands a velocity step from rest, either as move_velocity()
+ * for the firmware's velocity controller or through our VelocityLoop with
+ * move_voltage(), and polls the drive encoders every millisecond. Onset is
+ * the first encoder read (by device timestamp) past a small distance; rise is
+ * the first velocity estimate past 63% of the target. Both are measured from
+ * the first command, so the paths compare directly.
+ *
+ * Trials go into a fixed in-memory log, so SD card writes never disturb the
+ * timing.
+ */
+
+#ifndef OUTPUT_LATENCY_HPP
+#define OUTPUT_LATENCY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "motion/velocity_loop.hpp"
+#include "pros/motor_group.hpp"
+
+/**
+ * @brief Which output path a trial used
+ */
+enum class OutputPath : uint8_t {
+  MOTOR_VELOCITY = 0, ///< move_velocity(), the firmware's velocity loop
+  VOLTAGE             ///< move_voltage() from VelocityLoop
+};
+
+/**
+ * @struct LatencyTrial
+ * @brief Result of one step
+ */
+struct LatencyTrial {
+  OutputPath path = OutputPath::MOTOR_VELOCITY;
+  bool moved = false; ///< Onset was seen before the trial ended
+  bool rose = false;  ///< Rise was seen before the trial ended
+  float onsetMs = 0;
+  float riseMs = 0;
+};
+
+/**
+ * @struct LatencySummary
+ * @brief Trials of one path, aggregated
+ */
+struct LatencySummary {
+  size_t trials = 0;
+  size_t moved = 0; ///< Trials with an onset; the onset figures cover these
+  size_t rose = 0;  ///< Trials with a rise; the rise figures cover these
+  float meanOnsetMs = 0;
+  float maxOnsetMs = 0;
+  float meanRiseMs = 0;
+  float maxRiseMs = 0;
+};
+
+/**
+ * @class OutputLatencyTest
+ * @brief Runs latency trials and logs the results
+ *
+ * Trials block the calling task and drive the robot straight; alternate
+ * forwards and backwards to stay in place.
+ */
+class OutputLatencyTest {
+public:
+  static constexpr size_t MAX_TRIALS = 64;
+
+  /**
+   * @brief Constructor
+   * @param left Left drive motors
+   * @param right Right drive motors
+   * @param wheelDiameter Drive wheel diameter (inches)
+   * @param wheelRpm Wheel RPM at cartridge free speed
+   * @param leftLoop Velocity loop for the left side in the VOLTAGE path
+   * @param rightLoop Velocity loop for the right side in the VOLTAGE path
+   */
+  OutputLatencyTest(pros::MotorGroup& left, pros::MotorGroup& right, float wheelDiameter, float wheelRpm,
+                    VelocityLoop leftLoop, VelocityLoop rightLoop);
+
+  /**
+   * @brief Steps from rest to a velocity and back to rest
+   * @param path Output path to use
+   * @param forwards Drive forwards (true) or backwards (false)
+   * @param velocity Step size (in/s)
+   * @param durationMs How long to hold it
+   * @param onsetDistance Travel that counts as motion (inches)
+   */
+  void run_trial(OutputPath path, bool forwards, float velocity, uint32_t durationMs, float onsetDistance);
+
+  /**
+   * @brief Aggregates the logged trials of one path
+   */
+  LatencySummary summary(OutputPath path) const;
+
+  /**
+   * @brief Writes every trial as CSV
+   * @param path File to write (e.g. on /usd)
+   * @return false if there is no SD card or the file could not be written
+   */
+  bool save(const char* path) const;
+
+  /**
+   * @brief Trials logged so far (stops growing at MAX_TRIALS)
+   */
+  size_t trial_count() const;
+
+  /**
+   * @brief Discards the log
+   */
+  void clear();
+
+private:
+  pros::MotorGroup& left;
+  pros::MotorGroup& right;
+  float wheelDiameter;
+  float wheelRpm;
+  VelocityLoop leftLoop;
+  VelocityLoop rightLoop;
+
+  std::array<LatencyTrial, MAX_TRIALS> trials;
+  size_t count = 0;
+};
+
+#endif // OUTPUT_LATENCY_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file packed_path.hpp
+ * @brief Versioned binary path format and a zero-copy reader for it
+ *
+ * LemLib's text paths ("x, y, speed" lines) are parsed into a vector every
+ * time follow() starts. Packed paths are produced offline by
+ * tools/path_compiler.cpp instead, with heading, curvature, target velocity
+ * and cumulative distance already computed, and are read in place from the
+ * linked asset.
+ *
+ * Layout (little-endian, as on both the brain and any host PC):
+ *   PackedPathHeader
+ *   FIELD_COUNT arrays of pointCount floats, in PackedPathField order
+ *
+ * Assets are linked by objcopy with byte alignment, so values are read with
+ * memcpy rather than through float pointers.
+ *
+ * No PROS dependency, so the compiler can share it.
+ */
+
+#ifndef PACKED_PATH_HPP
+#define PACKED_PATH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @struct PackedPathHeader
+ * @brief Fixed header at the start of every packed path
+ */
+struct PackedPathHeader {
+  static constexpr uint32_t MAGIC = 0x50504B43; ///< "CKPP"
+  static constexpr uint16_t VERSION = 1;
+
+  uint32_t magic = MAGIC;
+  uint16_t version = VERSION;
+  uint16_t fieldCount = 0;    ///< Arrays following the header
+  uint32_t pointCount = 0;    ///< Floats per array
+  float totalDistance = 0;    ///< Path length (inches)
+  float maxVelocity = 0;      ///< Highest target velocity in the path (in/s)
+  uint32_t reserved = 0;
+};
+
+static_assert(sizeof(PackedPathHeader) == 24, "packed path header layout changed");
+
+/**
+ * @brief The arrays of a packed path, in file order
+ */
+enum class PackedPathField : uint16_t {
+  X = 0,         ///< inches
+  Y,             ///< inches
+  HEADING,       ///< Path tangent, degrees (LemLib convention: 0 = +y, clockwise positive)
+  CURVATURE,     ///< 1/inches, positive curving clockwise (to the right)
+  VELOCITY,      ///< Target velocity (in/s), already limited for curvature and stopping
+  DISTANCE,      ///< Cumulative distance from the first point (inches)
+  FIELD_COUNT
+};
+
+/**
+ * @class PackedPath
+ * @brief Read-only view over a packed path buffer
+ *
+ * Holds only a pointer into the buffer, which must outlive the view.
+ */
+class PackedPath {
+public:
+  /**
+   * @brief Checks only the magic number, to tell packed assets from text ones
+   */
+  static bool is_packed(const uint8_t* data, size_t size) {
+    uint32_t magic = 0;
+    if (data == nullptr || size < sizeof(magic)) {
+      return false;
+    }
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == PackedPathHeader::MAGIC;
+  }
+
+  /**
+   * @brief Wraps a buffer; check valid() before using the view
+   */
+  PackedPath(const uint8_t* data, size_t size) {
+    if (!is_packed(data, size) || size < sizeof(PackedPathHeader)) {
+      return;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    const size_t fields = static_cast<size_t>(PackedPathField::FIELD_COUNT);
+    const size_t needed = sizeof(PackedPathHeader) + fields * header.pointCount * sizeof(float);
+    if (header.version != PackedPathHeader::VERSION || header.fieldCount != fields || header.pointCount == 0 ||
+        size < needed) {
+      return;
+    }
+    arrays = data + sizeof(PackedPathHeader);
+  }
+
+  /**
+   * @brief Whether the buffer held a complete path of a supported version
+   */
+  bool valid() const { return arrays != nullptr; }
+
+  /**
+   * @brief Number of points (0 when invalid)
+   */
+  size_t size() const { return valid() ? header.pointCount : 0; }
+
+  /**
+   * @brief Path length in inches
+   */
+  float total_distance() const { return header.totalDistance; }
+
+  /**
+   * @brief One value of one point; index must be < size()
+   */
+  float get(PackedPathField field, size_t index) const {
+    float value;
+    std::memcpy(&value, arrays + (static_cast<size_t>(field) * header.pointCount + index) * sizeof(float),
+                sizeof(value));
+    return value;
+  }
+
+  float x(size_t index) const { return get(PackedPathField::X, index); }
+  float y(size_t index) const { return get(PackedPathField::Y, index); }
+  float heading(size_t index) const { return get(PackedPathField::HEADING, index); }
+  float curvature(size_t index) const { return get(PackedPathField::CURVATURE, index); }
+  float velocity(size_t index) const { return get(PackedPathField::VELOCITY, index); }
+  float distance(size_t index) const { return get(PackedPathField::DISTANCE, index); }
+
+private:
+  PackedPathHeader header;
+  const uint8_t* arrays = nullptr;
+};
+
+#endif // PACKED_PATH_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file path_cursor.hpp
+ * @brief Monotonic closest-point and lookahead search for pure pursuit
+ *
+ * Rescanning the whole path for the closest point every tick costs time
+ * proportional to path length, which adds up on long skills paths. The robot
+ * only ever moves forward along the path, so PathCursor keeps its position
+ * and searches a bounded window ahead of it. It keeps advancing past the
+ * window while points keep getting closer, so a robot that got far ahead is
+ * still caught up. The cursor never moves backwards, so over a whole run it
+ * visits each point a bounded number of times: amortised O(1) per tick
+ * whatever the path length.
+ *
+ * No PROS dependency; tools/path_cursor_benchmark.cpp times it on the host.
+ */
+
+#ifndef PATH_CURSOR_HPP
+#define PATH_CURSOR_HPP
+
+#include <cstddef>
+
+#include "motion/packed_path.hpp"
+
+/**
+ * @struct LookaheadPoint
+ * @brief Where the lookahead circle crosses the path
+ */
+struct LookaheadPoint {
+  float x = 0;
+  float y = 0;
+  size_t segment = 0; ///< Index of the segment start point
+};
+
+/**
+ * @class PathCursor
+ * @brief Progress along one path during one follow
+ */
+class PathCursor {
+public:
+  static constexpr size_t DEFAULT_WINDOW = 32;
+
+  /**
+   * @brief Constructor
+   * @param path Path to track; must outlive the cursor
+   * @param window Points searched ahead of the cursor each tick
+   */
+  explicit PathCursor(const PackedPath& path, size_t window = DEFAULT_WINDOW);
+
+  /**
+   * @brief Advances to the closest point to (x, y) and returns its index
+   */
+  size_t closest(float x, float y);
+
+  /**
+   * @brief Lookahead point for a robot at (x, y)
+   *
+   * Takes the first crossing at or after both the closest point and the
+   * previous lookahead segment, searching the window or two radii of path,
+   * whichever is longer. Holds the previous point if none is found, and
+   * snaps to the end of the path once it is inside the circle.
+   * Call closest() first in the same tick.
+   */
+  LookaheadPoint lookahead(float x, float y, float radius);
+
+  /**
+   * @brief Starts over from the beginning of the path
+   */
+  void reset();
+
+  /**
+   * @brief Index of the current closest point
+   */
+  size_t index() const;
+
+private:
+  float distance_squared(size_t index, float x, float y) const;
+
+  const PackedPath& path;
+  size_t window;
+  size_t cursor = 0;
+  LookaheadPoint lastLookahead;
+};
+
+#endif // PATH_CURSOR_HPP
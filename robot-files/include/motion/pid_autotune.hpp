@@ -0,0 +1,162 @@
+/**
+ * @file pid_autotune.hpp
+ * @brief Relay-feedback plant identification and PID gain search
+ *
+ * The drive is driven with a relay (bang-bang output of +-d around a
+ * setpoint), which settles into a limit cycle whose amplitude and period give
+ * the ultimate gain Ku and period Tu. From those, plus the motor time constant
+ * kA/kV from characterization, an integrating plant with dead time
+ *
+ *   position / output = K e^(-Ls) / (s (tau s + 1))
+ *
+ * is identified. Candidate gains are then simulated against that plant with
+ * LemLib's discrete PID (integral and derivative per 10 ms update, output
+ * clamped to +-127), keeping the fastest-settling pair whose overshoot stays
+ * within the limit.
+ *
+ * No PROS dependency, so all of it runs against a simulated plant on a PC.
+ */
+
+#ifndef PID_AUTOTUNE_HPP
+#define PID_AUTOTUNE_HPP
+
+#include <cstddef>
+
+/**
+ * @struct PidGains
+ * @brief Gains in LemLib's units (integral and derivative per update)
+ */
+struct PidGains {
+  float kP = 0;
+  float kI = 0;
+  float kD = 0;
+};
+
+/**
+ * @struct RelayResult
+ * @brief Limit cycle measured by a relay test
+ */
+struct RelayResult {
+  bool ok = false;         ///< Enough consistent cycles were seen
+  float amplitude = 0;     ///< Peak error amplitude
+  float period = 0;        ///< Ultimate period Tu (s)
+  float ultimateGain = 0;  ///< Ku
+  size_t cycles = 0;       ///< Full cycles averaged
+  float outputAmplitude = 0; ///< Relay output d
+  float hysteresis = 0;      ///< Relay hysteresis band
+  float samplePeriod = 0;    ///< Mean time between updates (s)
+};
+
+/**
+ * @class RelayAnalyzer
+ * @brief Relay controller that measures the limit cycle it produces
+ */
+class RelayAnalyzer {
+public:
+  static constexpr size_t SKIPPED_CYCLES = 1; ///< Start-up transient cycles ignored
+
+  /**
+   * @brief Constructor
+   * @param outputAmplitude Relay output d
+   * @param hysteresis Error band the relay ignores, to reject sensor noise
+   */
+  RelayAnalyzer(float outputAmplitude, float hysteresis);
+
+  /**
+   * @brief Feeds one measurement and returns the relay output to apply
+   * @param time Seconds, increasing
+   * @param error Setpoint minus measurement
+   */
+  float update(float time, float error);
+
+  /**
+   * @brief Full cycles measured so far, after the skipped ones
+   */
+  size_t cycles() const;
+
+  /**
+   * @brief Averaged limit cycle; ok is false until at least one cycle was measured
+   */
+  RelayResult result() const;
+
+private:
+  float outputAmplitude;
+  float hysteresis;
+  float output;
+  float cycleMax = 0;
+  float cycleMin = 0;
+  float lastRiseTime = -1;
+  float firstTime = -1;
+  float lastTime = 0;
+  size_t updates = 0;
+  size_t risingEdges = 0;
+  float amplitudeSum = 0;
+  float periodSum = 0;
+  size_t measured = 0;
+};
+
+/**
+ * @struct PlantModel
+ * @brief Integrating plant with a first-order lag and dead time
+ */
+struct PlantModel {
+  float gain = 0;         ///< K: steady velocity per unit output
+  float timeConstant = 0; ///< tau (s)
+  float deadTime = 0;     ///< L (s)
+};
+
+/**
+ * @brief Fits K and L to a relay result for a known time constant
+ *
+ * The hysteresis makes the relay lead, so the loop oscillates where the
+ * plant lags by less than 180 degrees; and the relay only sees the error at
+ * its updates. Both are taken out, so that L is the plant's own dead time
+ * and not the test's.
+ *
+ * @param relay Measured limit cycle (must be ok)
+ * @param timeConstant tau, e.g. kA / kV from characterization; 0 if unknown
+ */
+PlantModel identify_integrating_plant(const RelayResult& relay, float timeConstant);
+
+/**
+ * @struct StepMetrics
+ * @brief Closed-loop step response quality
+ */
+struct StepMetrics {
+  bool settled = false;
+  float settleTime = 0; ///< Seconds until the error stays inside the tolerance
+  float overshoot = 0;  ///< Fraction of the step
+};
+
+/**
+ * @struct TuningGoal
+ * @brief What the search optimises for
+ */
+struct TuningGoal {
+  float step = 24;          ///< Step size to simulate
+  float tolerance = 1;      ///< Settled band around the target
+  float maxOvershoot = 0.02f; ///< Fraction of the step
+  float dt = 0.01f;         ///< Control period (s); LemLib runs at 10 ms
+  float maxTime = 4;        ///< Simulated time limit (s)
+  float outputLimit = 127;
+};
+
+/**
+ * @brief Simulates a step with LemLib's discrete PID on the model
+ */
+StepMetrics simulate_step(const PlantModel& plant, const PidGains& gains, const TuningGoal& goal);
+
+/**
+ * @brief Searches kP/kD for the fastest settle within the overshoot limit
+ *
+ * kI stays 0: the plant already integrates. The search is seeded from the
+ * relay's Ku and Tu. A candidate must also meet the goal on a slightly
+ * faster, slower-reacting plant than the model, so that identification
+ * error does not turn the fastest pair on the model into overshoot.
+ * @param metrics Receives the winner's response if not null
+ * @return Best gains, or all zero if nothing met the goal
+ */
+PidGains tune_pid(const PlantModel& plant, const RelayResult& relay, const TuningGoal& goal,
+                  StepMetrics* metrics = nullptr);
+
+#endif // PID_AUTOTUNE_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file ramsete.hpp
+ * @brief RAMSETE nonlinear trajectory-tracking controller
+ *
+ * Given the robot's pose and the trajectory's reference pose, velocity and
+ * angular velocity, returns the chassis velocities that drive the error to
+ * zero. Unlike pure pursuit it tracks *when* the robot should be somewhere,
+ * and its gain grows with speed so cross-track error stays bounded.
+ *
+ * Standard position throughout: inches, radians, counter-clockwise positive.
+ * No PROS dependency.
+ */
+
+#ifndef RAMSETE_HPP
+#define RAMSETE_HPP
+
+/**
+ * @struct ChassisSpeeds
+ * @brief Linear and angular velocity of a differential drive
+ */
+struct ChassisSpeeds {
+  float velocity = 0; ///< in/s, forwards positive
+  float omega = 0;    ///< rad/s, counter-clockwise positive
+};
+
+/**
+ * @struct WheelSpeeds
+ * @brief Ground speed of each side of a differential drive
+ */
+struct WheelSpeeds {
+  float left = 0;  ///< in/s
+  float right = 0; ///< in/s
+};
+
+/**
+ * @class RamseteController
+ * @brief Stateless RAMSETE law
+ */
+class RamseteController {
+public:
+  /**
+   * @brief Constructor
+   * @param b Aggressiveness (> 0), 1/in^2. The usual 2 1/m^2 is about 0.0013 1/in^2
+   * @param zeta Damping, between 0 and 1 (usually 0.7)
+   */
+  RamseteController(float b, float zeta);
+
+  /**
+   * @brief Chassis velocities to command this tick
+   * @param x, y, theta Current pose
+   * @param refX, refY, refTheta Reference pose
+   * @param refVelocity Reference linear velocity (in/s)
+   * @param refOmega Reference angular velocity (rad/s)
+   */
+  ChassisSpeeds calculate(float x, float y, float theta, float refX, float refY, float refTheta, float refVelocity,
+                          float refOmega) const;
+
+  /**
+   * @brief Splits chassis velocities into side speeds
+   * @param speeds Chassis velocities
+   * @param trackWidth Distance between the left and right wheels (inches)
+   */
+  static WheelSpeeds to_wheel_speeds(ChassisSpeeds speeds, float trackWidth);
+
+private:
+  float b;
+  float zeta;
+};
+
+#endif // RAMSETE_HPP
@@ -0,0 +1,74 @@
+/**
+ * @file trajectory.hpp
+ * @brief Time-parameterised trajectory built from a packed path
+ *
+ * A packed path says how fast the robot may go at each point, but not when it
+ * should be there. Trajectory adds the time: it limits acceleration going
+ * forward from rest (the packed velocities already handle stopping), then
+ * integrates time along the path. sample() then gives the reference pose,
+ * linear velocity and angular velocity at any instant, for RAMSETE to track.
+ *
+ * Poses here are in standard position (radians, counter-clockwise from +x),
+ * the frame RAMSETE is derived in; lemlib::Chassis::getPose(true, true)
+ * returns the same frame.
+ *
+ * No PROS dependency.
+ */
+
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "motion/packed_path.hpp"
+
+/**
+ * @struct TrajectoryState
+ * @brief Reference at one instant
+ */
+struct TrajectoryState {
+  float time = 0;     ///< Seconds from the start
+  float x = 0;        ///< inches
+  float y = 0;        ///< inches
+  float theta = 0;    ///< radians, counter-clockwise from +x
+  float velocity = 0; ///< in/s along the path
+  float omega = 0;    ///< rad/s, counter-clockwise positive
+  float distance = 0; ///< inches along the path
+};
+
+/**
+ * @class Trajectory
+ * @brief Timing for every point of a packed path
+ *
+ * Stores two floats per point (the acceleration-limited velocity and the
+ * arrival time); the path itself is still read in place.
+ */
+class Trajectory {
+public:
+  /**
+   * @brief Builds the timing
+   * @param path Path to time; must outlive the trajectory
+   * @param maxAcceleration Acceleration limit (in/s^2) ramping up from rest
+   */
+  Trajectory(const PackedPath& path, float maxAcceleration);
+
+  /**
+   * @brief Reference at time t, interpolated between points; clamped to the ends
+   */
+  TrajectoryState sample(float t) const;
+
+  /**
+   * @brief Time to reach the last point (seconds)
+   */
+  float duration() const;
+
+private:
+  TrajectoryState state_at(size_t index) const;
+
+  const PackedPath& path;
+  std::vector<float> velocities; ///< Acceleration-limited velocity at each point
+  std::vector<float> times;      ///< Arrival time at each point
+};
+
+#endif // TRAJECTORY_HPP
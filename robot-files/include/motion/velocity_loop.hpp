@@ -0,0 +1,109 @@
+/**
+ * @file velocity_loop.hpp
+ * @brief Outer wheel-velocity loop for driving the motors in voltage mode
+ *
+ * move() is open-loop: it applies a fraction of the battery voltage, and
+ * nothing holds the wheel speed against load or a sagging battery. Only
+ * move_velocity() closes a loop, in the firmware's own velocity PID, which
+ * adds a control period or more between a command and the wheels responding
+ * and whose gains are not ours to tune. VelocityLoop closes it here instead:
+ * move_voltage() driven by the characterized feedforward plus feedback on
+ * wheel velocity differentiated from timestamped encoder reads by
+ * EncoderVelocityEstimator.
+ *
+ * No PROS dependency.
+ */
+
+#ifndef VELOCITY_LOOP_HPP
+#define VELOCITY_LOOP_HPP
+
+#include <cstdint>
+
+#include "motion/feedforward.hpp"
+
+/**
+ * @class EncoderVelocityEstimator
+ * @brief Velocity from successive position reads, using the device's own timestamps
+ *
+ * Differentiating against the time the motor took the reading, not the time
+ * the task happened to run, keeps scheduling jitter out of the estimate.
+ * Reads with an unchanged timestamp carry no new data and are ignored.
+ */
+class EncoderVelocityEstimator {
+public:
+  /**
+   * @brief Constructor
+   * @param filterAlpha Low-pass weight of each new difference (1 = unfiltered)
+   */
+  explicit EncoderVelocityEstimator(float filterAlpha = 1);
+
+  /**
+   * @brief Feeds one read
+   * @param position Position (inches)
+   * @param timestampMs Device timestamp of the read
+   * @return true if the read was new and the estimate changed
+   */
+  bool update(float position, uint32_t timestampMs);
+
+  /**
+   * @brief Latest estimate (inches per second)
+   */
+  float velocity() const;
+
+  /**
+   * @brief Forgets history; the next read only primes the estimator
+   */
+  void reset();
+
+private:
+  float filterAlpha;
+  bool primed = false;
+  float lastPosition = 0;
+  uint32_t lastTimestampMs = 0;
+  float estimate = 0;
+};
+
+/**
+ * @struct VelocityLoopGains
+ * @brief Feedback gains of the outer velocity loop
+ */
+struct VelocityLoopGains {
+  float kP = 0;            ///< Volts per in/s of velocity error
+  float kI = 0;            ///< Volts per inch of accumulated velocity error
+  float integralLimit = 0; ///< Largest integral contribution (volts)
+};
+
+/**
+ * @class VelocityLoop
+ * @brief Feedforward plus PI on wheel velocity, output in volts
+ */
+class VelocityLoop {
+public:
+  /**
+   * @brief Constructor
+   * @param feedforward Characterized feedforward of this side
+   * @param gains Feedback gains
+   */
+  VelocityLoop(SimpleMotorFeedforward feedforward, VelocityLoopGains gains);
+
+  /**
+   * @brief Voltage to apply this period
+   * @param targetVelocity Planned wheel velocity (in/s)
+   * @param targetAcceleration Planned wheel acceleration (in/s^2)
+   * @param measuredVelocity Estimated wheel velocity (in/s)
+   * @param dt Seconds since the last call
+   */
+  float calculate(float targetVelocity, float targetAcceleration, float measuredVelocity, float dt);
+
+  /**
+   * @brief Clears the integral
+   */
+  void reset();
+
+private:
+  SimpleMotorFeedforward feedforward;
+  VelocityLoopGains gains;
+  float integral = 0; ///< Volts
+};
+
+#endif // VELOCITY_LOOP_HPP
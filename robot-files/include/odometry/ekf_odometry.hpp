@@ -0,0 +1,221 @@
+/**
+ * @file ekf_odometry.hpp
+ * @brief Extended Kalman filter pose estimator over SensorHub snapshots
+ *
+ * LemLib's odometry trusts one source per quantity: the tracking wheels for
+ * distance and the IMU (or the wheels) for heading. This filter instead
+ * weighs every source by its own noise and fuses all of them: both tracking
+ * wheels, the drive motor encoders, an optional GPS and one heading from
+ * HeadingFusion over up to SensorSnapshot::MAX_IMUS IMU gyros.
+ *
+ * State is [x, y, theta, forward, lateral, omega]: field position (inches),
+ * compass heading (radians, clockwise, unbounded like the IMU's rotation)
+ * and robot-frame velocities (in/s, rad/s). Prediction is constant velocity;
+ * the wheels and motors measure velocities, the IMUs and GPS measure pose.
+ * Every measurement is a scalar update, so there is no matrix inverse, and
+ * the whole filter is fixed-size with no allocation after construction.
+ *
+ * Offsets follow lemlib::TrackingWheel: distance from the tracking centre,
+ * negative for a vertical wheel on the left or a horizontal wheel in front.
+ */
+
+#ifndef EKF_ODOMETRY_HPP
+#define EKF_ODOMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/sensor_hub.hpp"
+#include "lemlib/pose.hpp"
+#include "odometry/heading_fusion.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @struct EkfWheel
+ * @brief A tracking wheel on a rotation sensor
+ */
+struct EkfWheel {
+  float diameter = 0; ///< Inches; 0 = no wheel
+  float offset = 0;   ///< Inches from the tracking centre (LemLib's sign convention)
+};
+
+/**
+ * @struct EkfNoise
+ * @brief Standard deviations the filter weighs each source by
+ */
+struct EkfNoise {
+  float forwardAcceleration = 100; ///< Process noise on forward velocity (in/s^2)
+  float lateralAcceleration = 20;  ///< Process noise on lateral velocity (in/s^2); a tank drive barely slides
+  float angularAcceleration = 10;  ///< Process noise on omega (rad/s^2)
+  float trackingWheel = 1;         ///< Tracking wheel velocity (in/s)
+  float motorEncoder = 4;          ///< Drive motor velocity (in/s); large, since drive wheels slip
+  float imuHeading = 0.01f;        ///< Fused gyro heading (rad)
+  float gpsPosition = 1;           ///< Floor on the GPS position (inches); the sensor's own error is used above it
+  float gpsHeading = 0.035f;       ///< GPS heading (rad)
+  float gate = 4;                  ///< Innovations beyond this many standard deviations are rejected
+};
+
+/**
+ * @struct EkfConfig
+ * @brief Robot geometry and which sources to use
+ */
+struct EkfConfig {
+  EkfWheel vertical;            ///< Rotation sensor measuring forward travel
+  EkfWheel horizontal;          ///< Rotation sensor measuring sideways travel
+  float trackWidth = 0;         ///< Drive track width (inches)
+  float motorInchesPerTick = 0; ///< Drive ground travel per raw motor tick; 0 = ignore the motors
+  float wheelWindowMs = 20;     ///< Tracking wheel differencing window; a multiple of the rotation sensors' data period
+  bool useGps = false;          ///< GPS field frame is the odometry frame (field centre origin)
+  float gyroSign = 1;           ///< Multiplies the IMUs' z rate to make it clockwise-positive
+  EkfNoise noise;
+  HeadingFusionConfig heading;
+};
+
+/**
+ * @struct EkfStats
+ * @brief Filter health counters
+ */
+struct EkfStats {
+  uint32_t updates = 0;  ///< Snapshots processed
+  uint32_t accepted = 0; ///< Scalar measurements applied
+  uint32_t rejected = 0; ///< Scalar measurements gated out as outliers
+};
+
+/**
+ * @class EkfOdometry
+ * @brief Fuses SensorHub snapshots into a pose
+ *
+ * update() and the accessors belong to one task (the odometry task).
+ * request_reset() may be called from one other task at a time; the reset
+ * takes effect on the next update().
+ */
+class EkfOdometry {
+public:
+  static constexpr std::size_t STATES = 6;
+  enum StateIndex : std::size_t { X = 0, Y, THETA, FORWARD, LATERAL, OMEGA };
+
+  /**
+   * @brief Constructor
+   */
+  explicit EkfOdometry(EkfConfig config);
+
+  /**
+   * @brief Asks the odometry task to restart from a pose
+   * @param pose Inches and degrees, like lemlib::Chassis::setPose
+   */
+  void request_reset(const lemlib::Pose& pose);
+
+  /**
+   * @brief Starts a gyro's bias estimate from a saved value (before the odometry task starts)
+   * @param index IMU slot in SensorSnapshot::imu
+   * @param biasDps Clockwise-positive, after EkfConfig::gyroSign
+   */
+  void seed_gyro_bias(std::size_t index, float biasDps);
+
+  /**
+   * @brief Current bias estimate of a gyro (deg/s)
+   */
+  float gyro_bias(std::size_t index) const;
+
+  /**
+   * @brief Replaces the tracking wheel geometry, e.g. with a saved calibration (before the odometry task starts)
+   */
+  void set_wheels(const EkfWheel& vertical, const EkfWheel& horizontal);
+
+  /**
+   * @brief Processes one snapshot; repeated snapshots are ignored
+   */
+  void update(const SensorSnapshot& snapshot);
+
+  /**
+   * @brief Applies an external absolute pose measurement (odometry task only)
+   *
+   * For estimators that already rejected their own outliers, such as the
+   * relocalizer, so the innovation is not gated: a robot that was pushed is
+   * exactly where a large one is right.
+   *
+   * @param pose Measured pose (inches, degrees on the filter's unbounded turn count)
+   * @param positionSigma Standard deviation of x and y (inches)
+   * @param headingSigma Standard deviation of theta (degrees)
+   */
+  void correct_pose(const lemlib::Pose& pose, float positionSigma, float headingSigma);
+
+  /**
+   * @brief Pose in LemLib units (inches, degrees)
+   */
+  lemlib::Pose pose() const;
+
+  /**
+   * @brief Field-frame velocity in LemLib units (in/s, deg/s)
+   */
+  lemlib::Pose velocity() const;
+
+  /**
+   * @brief Variance of one state (units squared of that state)
+   */
+  float variance(StateIndex index) const;
+
+  const EkfStats& stats() const { return counters; }
+
+private:
+  using Vector = std::array<float, STATES>;
+  using Matrix = std::array<Vector, STATES>;
+
+  /**
+   * @brief Sensor values the next update differentiates against
+   */
+  struct Previous {
+    bool valid = false;
+    float value = 0;
+    uint32_t timestampMs = 0; ///< Motors: device timestamp
+    uint64_t timestampUs = 0; ///< Rotation sensors: read time
+    float velocity = 0;       ///< Motors: last measured side velocity (in/s)
+  };
+
+  /**
+   * @brief Pose handed over by request_reset (lemlib::Pose has no default constructor)
+   */
+  struct ResetRequest {
+    float x = 0;
+    float y = 0;
+    float theta = 0;
+  };
+
+  void reset(const lemlib::Pose& pose);
+  void predict(float dt);
+
+  /**
+   * @brief Applies one scalar measurement z = h x + noise
+   * @param gated Reject innovations beyond EkfNoise::gate standard deviations
+   * @return false if the innovation was gated out
+   */
+  bool correct(const Vector& h, float innovation, float variance, bool gated = true);
+
+  void correct_wheel(const RotationSample& sample, const EkfWheel& wheel, Previous& previous, StateIndex axis);
+  void correct_motors(const MotorGroupSample& sample, Previous& previous, float sideOffset);
+  void correct_heading(const SensorSnapshot& snapshot, float dt);
+  void correct_gps(const GpsSample& sample);
+
+  EkfConfig config;
+  Vector state{};
+  Matrix covariance{};
+
+  bool primed = false;
+  uint32_t lastCycle = 0;
+  uint64_t lastTimestampUs = 0;
+  Previous verticalPrevious;
+  Previous horizontalPrevious;
+  Previous leftPrevious;
+  Previous rightPrevious;
+  uint64_t movingTimestampUs = 0; ///< Last snapshot the drive was seen moving
+  HeadingFusion headingFusion;
+  EkfStats counters;
+
+  SnapshotBuffer<ResetRequest> resetPose;
+  std::atomic<uint32_t> resetRequests{0};
+  uint32_t resetsApplied = 0;
+};
+
+#endif // EKF_ODOMETRY_HPP
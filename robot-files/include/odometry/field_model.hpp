@@ -0,0 +1,91 @@
+/**
+ * @file field_model.hpp
+ * @brief Compile-time model of the field surfaces a distance sensor can see
+ *
+ * The field is a list of line segments in the odometry frame, which for
+ * relocalization must be the field frame: inches from the field centre,
+ * axes as the GPS reports them. Everything is constexpr, so the model costs
+ * no RAM beyond .rodata and cast() can be checked by static_assert.
+ */
+
+#ifndef FIELD_MODEL_HPP
+#define FIELD_MODEL_HPP
+
+#include <array>
+#include <cstddef>
+
+/**
+ * @struct FieldSegment
+ * @brief One straight wall face (inches)
+ */
+struct FieldSegment {
+  float x0 = 0;
+  float y0 = 0;
+  float x1 = 0;
+  float y1 = 0;
+};
+
+/**
+ * @struct FieldModel
+ * @brief A fixed set of segments that rays are cast against
+ */
+template <std::size_t N> struct FieldModel {
+  std::array<FieldSegment, N> segments;
+
+  /**
+   * @brief Distance along a ray to the first segment it hits
+   * @param x Ray origin (inches)
+   * @param y Ray origin (inches)
+   * @param dx Unit direction
+   * @param dy Unit direction
+   * @param maxRange Returned when nothing is hit closer
+   */
+  constexpr float cast(float x, float y, float dx, float dy, float maxRange) const {
+    float nearest = maxRange;
+    for (const FieldSegment& segment : segments) {
+      const float ex = segment.x1 - segment.x0;
+      const float ey = segment.y1 - segment.y0;
+      const float denominator = dx * ey - dy * ex;
+      if (denominator == 0) {
+        continue; // parallel
+      }
+      const float ax = segment.x0 - x;
+      const float ay = segment.y0 - y;
+      const float t = (ax * ey - ay * ex) / denominator;
+      const float s = (ax * dy - ay * dx) / denominator;
+      if (t > 0 && t < nearest && s >= 0 && s <= 1) {
+        nearest = t;
+      }
+    }
+    return nearest;
+  }
+};
+
+/**
+ * @brief The four faces of an axis-aligned box, for walls and game elements
+ */
+constexpr std::array<FieldSegment, 4> make_box(float centreX, float centreY, float width, float height) {
+  const float left = centreX - width / 2;
+  const float right = centreX + width / 2;
+  const float bottom = centreY - height / 2;
+  const float top = centreY + height / 2;
+  return {{{left, bottom, right, bottom}, {right, bottom, right, top}, {right, top, left, top}, {left, top, left, bottom}}};
+}
+
+constexpr float FIELD_INSIDE_WIDTH = 140.4f; ///< Between the inner faces of the perimeter
+
+/**
+ * @brief What the distance sensors are matched against
+ *
+ * Only the perimeter for now. Game elements tall enough to block a sensor
+ * belong here too (append make_box faces and grow N); anything left out
+ * shows up as short readings that the outlier term in MclConfig absorbs.
+ */
+constexpr FieldModel<4> FIELD{make_box(0, 0, FIELD_INSIDE_WIDTH, FIELD_INSIDE_WIDTH)};
+
+static_assert(FIELD.cast(0, 0, 1, 0, 1000) > FIELD_INSIDE_WIDTH / 2 - 0.01f &&
+                  FIELD.cast(0, 0, 1, 0, 1000) < FIELD_INSIDE_WIDTH / 2 + 0.01f,
+              "a ray from the centre meets the wall half a field away");
+static_assert(FIELD.cast(0, 60, 0, 1, 5) == 5, "a ray that hits nothing within range returns the range");
+
+#endif // FIELD_MODEL_HPP
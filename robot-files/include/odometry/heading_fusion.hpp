@@ -0,0 +1,127 @@
+/**
+ * @file heading_fusion.hpp
+ * @brief Dual-gyro heading with online bias estimation and fault rejection
+ *
+ * A single IMU's heading drifts with its gyro bias, which changes with
+ * temperature over a skills run. HeadingFusion integrates the raw yaw rate of
+ * each gyro itself, re-estimating every bias whenever the robot is known to be
+ * still, and averages the bias-corrected rates weighted by each gyro's
+ * measured noise. A gyro that returns errors is dropped at once; when two
+ * gyros disagree for too long, the one further from the wheel-derived yaw
+ * rate is dropped until it agrees again.
+ *
+ * Rates are clockwise-positive degrees per second, like LemLib's heading.
+ * No PROS dependency; tools/heading_fusion_sim.cpp runs it on synthetic
+ * drifting gyro traces.
+ */
+
+#ifndef HEADING_FUSION_HPP
+#define HEADING_FUSION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct GyroReading
+ * @brief One gyro's yaw rate for one update
+ */
+struct GyroReading {
+  float rateDps = 0;  ///< Clockwise-positive
+  bool valid = false; ///< The read succeeded and the device is connected
+};
+
+/**
+ * @struct HeadingFusionConfig
+ * @brief Tuning of the bias estimator and fault detection
+ */
+struct HeadingFusionConfig {
+  float biasTimeConstant = 0.5f;  ///< Seconds of stillness the bias estimate averages over
+  float stillRate = 1;            ///< Corrected rate (deg/s) above which "stationary" is not believed
+  float disagreeRate = 5;         ///< Gyros further apart than this (deg/s) are inconsistent
+  uint32_t faultSamples = 20;     ///< Consecutive blamed updates before a gyro is dropped
+  uint32_t recoverSamples = 200;  ///< Consecutive clean updates before a dropped gyro returns
+  float initialNoise = 0.1f;      ///< Assumed rate noise (deg/s) until measured
+  float minNoise = 0.01f;         ///< Floor on the measured noise, so no gyro takes all the weight
+};
+
+/**
+ * @class HeadingFusion
+ * @brief Fuses up to MAX_GYROS yaw-rate gyros into one heading
+ */
+class HeadingFusion {
+public:
+  static constexpr std::size_t MAX_GYROS = 2;
+
+  /**
+   * @brief Constructor
+   */
+  explicit HeadingFusion(HeadingFusionConfig config = {});
+
+  /**
+   * @brief Integrates one update
+   * @param readings Every gyro's rate; unused slots are simply invalid
+   * @param dt Seconds since the last update
+   * @param stationary The wheels say the robot is not moving
+   * @param referenceRate Wheel-derived yaw rate (deg/s) to break ties, or NaN if unknown
+   * @return Fused heading (degrees)
+   */
+  float update(const std::array<GyroReading, MAX_GYROS>& readings, float dt, bool stationary, float referenceRate);
+
+  /**
+   * @brief Restarts the heading, keeping the bias and health estimates
+   */
+  void reset(float headingDeg);
+
+  /**
+   * @brief Starts a gyro from a known bias, e.g. one saved before a restart
+   *
+   * The estimate then keeps tracking at the normal rate instead of replacing
+   * the seed with the first still samples.
+   */
+  void seed_bias(std::size_t index, float biasDps);
+
+  /**
+   * @brief Fused heading (degrees, clockwise, unbounded)
+   */
+  float heading() const { return fusedHeading; }
+
+  /**
+   * @brief Fused yaw rate of the last update (deg/s)
+   */
+  float rate() const { return fusedRate; }
+
+  /**
+   * @brief Current bias estimate of a gyro (deg/s)
+   */
+  float bias(std::size_t index) const { return channels[index].bias; }
+
+  /**
+   * @brief Whether a gyro is currently trusted
+   */
+  bool healthy(std::size_t index) const { return channels[index].healthy; }
+
+  /**
+   * @brief Whether any gyro is trusted; if not, the heading follows the reference rate
+   */
+  bool any_healthy() const;
+
+private:
+  struct Channel {
+    float bias = 0;
+    float variance = 0; ///< Of the corrected rate while still (deg/s)^2
+    uint32_t stillSamples = 0; ///< Updates the bias has been estimated over
+    bool healthy = true;
+    uint32_t blamed = 0; ///< Consecutive updates found at fault
+    uint32_t clean = 0;  ///< Consecutive updates not at fault
+  };
+
+  void blame(Channel& channel, bool atFault);
+
+  HeadingFusionConfig config;
+  std::array<Channel, MAX_GYROS> channels;
+  float fusedHeading = 0;
+  float fusedRate = 0;
+};
+
+#endif // HEADING_FUSION_HPP
@@ -0,0 +1,145 @@
+/**
+ * @file monte_carlo_localization.hpp
+ * @brief Particle filter that relocalizes against the field walls
+ *
+ * Odometry only integrates: once the robot is pushed or its wheels slip, the
+ * error stays. This filter keeps a cloud of candidate poses, moves them with
+ * the odometry deltas (plus noise proportional to the motion) and weighs each
+ * one by how well up to MAX_BEAMS distance sensor readings match rays cast
+ * from it against FIELD. Its estimate is independent of the odometry's
+ * accumulated error, so the odometry can be pulled towards it.
+ *
+ * Particles are stored structure-of-arrays in fixed, 16-byte aligned arrays,
+ * so the per-particle loops are straight float streams the compiler can
+ * vectorize and nothing is allocated after construction. No PROS dependency;
+ * tools/mcl_benchmark.cpp measures particles per millisecond on a PC.
+ *
+ * Poses use LemLib's conventions: inches, and degrees clockwise from +y.
+ */
+
+#ifndef MONTE_CARLO_LOCALIZATION_HPP
+#define MONTE_CARLO_LOCALIZATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct DistanceMount
+ * @brief Where a distance sensor sits on the robot
+ */
+struct DistanceMount {
+  float x = 0;     ///< Inches right of the tracking centre
+  float y = 0;     ///< Inches forward of the tracking centre
+  float angle = 0; ///< Degrees clockwise from the robot's forward
+};
+
+/**
+ * @struct DistanceBeam
+ * @brief One distance sensor reading
+ */
+struct DistanceBeam {
+  float range = 0;      ///< Inches
+  float confidence = 0; ///< 0 to 1
+  bool valid = false;   ///< Read succeeded and something was in range
+};
+
+/**
+ * @struct MclConfig
+ * @brief Sensor layout and noise models
+ */
+struct MclConfig {
+  static constexpr std::size_t MAX_BEAMS = 4;
+
+  std::array<DistanceMount, MAX_BEAMS> mounts{};
+  float maxRange = 78;               ///< Inches; the V5 distance sensor reads to 2 m
+  float minConfidence = 0.5f;        ///< Readings below this are ignored
+  float rangeNoise = 0.6f;           ///< Range standard deviation (inches) at zero range
+  float rangeNoiseFraction = 0.05f;  ///< Plus this fraction of the range
+  float outlierProbability = 0.1f;   ///< Chance a reading hit something not in FIELD (a robot, a game element)
+  float translationNoise = 0.05f;    ///< Per inch travelled, standard deviation (inches)
+  float rotationNoise = 0.05f;       ///< Per degree turned, standard deviation (degrees)
+  float minTranslationNoise = 0.05f; ///< Inches per step, so a still robot's cloud can still settle
+  float minRotationNoise = 0.1f;     ///< Degrees per step
+  float initialSpread = 2;           ///< Inches of spread around a reset pose
+  float initialHeadingSpread = 2;    ///< Degrees of spread around a reset pose
+  float recoveryFraction = 0.02f;    ///< Share of particles scattered over the field on resampling (kidnapping)
+  float resampleThreshold = 0.5f;    ///< Resample when the effective particle count drops below this share
+};
+
+/**
+ * @struct MclEstimate
+ * @brief Weighted mean of the particle cloud
+ */
+struct MclEstimate {
+  float x = 0;
+  float y = 0;
+  float theta = 0;          ///< Degrees, on the same unbounded turn count as the last reset
+  float positionSpread = 0; ///< Standard deviation of the cloud (inches)
+  float headingSpread = 0;  ///< Standard deviation of the cloud (degrees)
+  uint32_t beamsUsed = 0;   ///< Readings the last correct() weighed the particles by
+};
+
+/**
+ * @class MonteCarloLocalization
+ * @brief Fixed-size particle filter over FIELD
+ */
+class MonteCarloLocalization {
+public:
+  static constexpr std::size_t PARTICLES = 256;
+  static constexpr std::size_t MAX_BEAMS = MclConfig::MAX_BEAMS;
+
+  /**
+   * @brief Constructor
+   * @param seed Random seed; any nonzero value
+   */
+  explicit MonteCarloLocalization(MclConfig config, uint32_t seed = 1);
+
+  /**
+   * @brief Scatters the particles around a pose
+   */
+  void reset(float x, float y, float thetaDeg);
+
+  /**
+   * @brief Moves every particle by one odometry step
+   * @param forward Inches travelled along the robot's heading at the start of the step
+   * @param right Inches travelled to the robot's right
+   * @param turn Degrees turned clockwise
+   */
+  void predict(float forward, float right, float turn);
+
+  /**
+   * @brief Weighs the particles by a set of readings, resampling if needed
+   * @return Number of readings used
+   */
+  uint32_t correct(const std::array<DistanceBeam, MAX_BEAMS>& beams);
+
+  /**
+   * @brief Current weighted mean and spread
+   */
+  MclEstimate estimate() const;
+
+private:
+  void resample();
+  float uniform();
+  float gaussian();
+
+  MclConfig config;
+  uint32_t rngState;
+  uint32_t lastBeamsUsed = 0;
+
+  alignas(16) std::array<float, PARTICLES> x{};
+  alignas(16) std::array<float, PARTICLES> y{};
+  alignas(16) std::array<float, PARTICLES> theta{}; ///< Radians, clockwise from +y
+  alignas(16) std::array<float, PARTICLES> weight{};
+
+  // Scratch for correct() and resample(), kept here so the task stack stays small
+  alignas(16) std::array<float, PARTICLES> sinTheta{};
+  alignas(16) std::array<float, PARTICLES> cosTheta{};
+  alignas(16) std::array<float, PARTICLES> scratchX{};
+  alignas(16) std::array<float, PARTICLES> scratchY{};
+  alignas(16) std::array<float, PARTICLES> scratchTheta{};
+  alignas(16) std::array<float, PARTICLES> expectedRange{};
+};
+
+#endif // MONTE_CARLO_LOCALIZATION_HPP
@@ -0,0 +1,95 @@
+/**
+ * @file pose_channel.hpp
+ * @brief Wait-free pose publication for any number of readers
+ *
+ * UI, logging and subsystem code that polls the pose should read it from a
+ * PoseChannel instead of calling lemlib::Chassis::getPose(), so none of them
+ * compete with the odometry and motion tasks. Exactly one task publishes; all
+ * reads are lock-free copies.
+ *
+ * The channel also keeps the last HISTORY poses, so a consumer whose data is
+ * stamped with its own time (a camera frame, a distance reading) can ask
+ * where the robot was at that moment, and one that acts later than it reads
+ * (a controller with output latency) can ask where the robot will be.
+ */
+
+#ifndef POSE_CHANNEL_HPP
+#define POSE_CHANNEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "lemlib/pose.hpp"
+#include "util/history_buffer.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @struct PoseSample
+ * @brief Pose, velocity and time of one odometry update
+ *
+ * Units match LemLib: inches, degrees, inches/s and degrees/s.
+ */
+struct PoseSample {
+  float x = 0;
+  float y = 0;
+  float theta = 0;
+  float vx = 0;    ///< Field-frame x velocity
+  float vy = 0;    ///< Field-frame y velocity
+  float omega = 0; ///< Angular velocity
+  uint64_t timestampUs = 0; ///< When the pose was valid
+  uint32_t sequence = 0;    ///< Increments with every publish; 0 = never published
+
+  /**
+   * @brief The pose part as a lemlib::Pose
+   */
+  lemlib::Pose pose() const { return lemlib::Pose(x, y, theta); }
+
+  /**
+   * @brief The velocity part as a lemlib::Pose
+   */
+  lemlib::Pose velocity() const { return lemlib::Pose(vx, vy, omega); }
+};
+
+/**
+ * @class PoseChannel
+ * @brief Single-writer pose channel built on SnapshotBuffer
+ */
+class PoseChannel {
+public:
+  static constexpr std::size_t HISTORY = 64;             ///< Poses kept; 320 ms at the 5 ms EKF rate
+  static constexpr uint64_t MAX_EXTRAPOLATION_US = 100000; ///< Furthest past the newest pose sample_at() predicts
+
+  /**
+   * @brief Publishes a new pose (single writer only)
+   * @param pose Current pose
+   * @param velocity Current field-frame velocity
+   * @param timestampUs When the pose was valid
+   */
+  void publish(const lemlib::Pose& pose, const lemlib::Pose& velocity, uint64_t timestampUs);
+
+  /**
+   * @brief Latest published pose; never blocks
+   */
+  PoseSample read() const;
+
+  /**
+   * @brief Pose at an arbitrary time; never blocks
+   *
+   * Between two published poses the pose and velocity are interpolated.
+   * After the newest one the pose is extrapolated along its velocity, for at
+   * most MAX_EXTRAPOLATION_US. Before the oldest one still kept, the oldest
+   * is returned as is.
+   *
+   * @param timestampUs Time to evaluate at, on the pros::micros() clock
+   * @return The pose, stamped with the time it was evaluated for (or the
+   * oldest kept pose's own time); sequence 0 if nothing was published yet
+   */
+  PoseSample sample_at(uint64_t timestampUs) const;
+
+private:
+  SnapshotBuffer<PoseSample> buffer;
+  HistoryBuffer<PoseSample, HISTORY> history;
+  uint32_t sequence = 0; ///< Writer-owned
+};
+
+#endif // POSE_CHANNEL_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file relocalizer.hpp
+ * @brief Background task running MonteCarloLocalization on distance sensors
+ *
+ * Every period the task reads up to four pros::Distance sensors, moves the
+ * particles by the distance the odometry says the robot travelled since the
+ * last period, weighs them by the readings and publishes how far the
+ * odometry is from the particle estimate. The EKF odometry task folds that
+ * offset back in with EkfOdometry::correct_pose; LemLib's odometry has no
+ * safe way to take it, so the relocalizer only runs with the EKF.
+ *
+ * Motion comes from the published velocities rather than pose differences,
+ * so corrections applied to the pose never feed back into the particles.
+ * A pose jump the velocities do not explain (setPose at the start of an
+ * autonomous) re-seeds the particles around the new pose.
+ */
+
+#ifndef RELOCALIZER_HPP
+#define RELOCALIZER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "odometry/monte_carlo_localization.hpp"
+#include "odometry/pose_channel.hpp"
+#include "pros/distance.hpp"
+#include "scheduler/loop_timer.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @struct MclCorrection
+ * @brief Where the particles put the robot, relative to the odometry
+ *
+ * The offsets are taken at the moment the sensors were read, so adding them
+ * to the current pose stays right while the robot keeps moving.
+ */
+struct MclCorrection {
+  float dx = 0;             ///< Particle estimate minus odometry (inches)
+  float dy = 0;
+  float dtheta = 0;         ///< Degrees
+  float positionSpread = 0; ///< Particle cloud standard deviation (inches)
+  float headingSpread = 0;  ///< Degrees
+  uint32_t beamsUsed = 0;   ///< Distance readings the estimate was weighed by
+  uint64_t timestampUs = 0; ///< When the sensors were read
+  uint32_t sequence = 0;    ///< Increments with every correction; 0 = none yet
+};
+
+/**
+ * @class Relocalizer
+ * @brief Owns the particle filter and its task
+ */
+class Relocalizer {
+public:
+  static constexpr std::size_t MAX_BEAMS = MonteCarloLocalization::MAX_BEAMS;
+
+  /**
+   * @brief Constructor
+   * @param poses Odometry output the particles follow
+   * @param sensors Distance sensors in the order of config.mounts; nullptr where there is none
+   * @param config Sensor mounts and noise models
+   */
+  Relocalizer(const PoseChannel& poses, std::array<pros::Distance*, MAX_BEAMS> sensors, MclConfig config);
+
+  /**
+   * @brief Starts the task; does nothing if already started
+   */
+  void start(uint32_t periodMs, uint32_t taskPriority);
+
+  /**
+   * @brief Latest correction; never blocks
+   */
+  MclCorrection correction() const;
+
+  /**
+   * @brief Task timing statistics
+   */
+  LoopStats loop_stats() const;
+
+private:
+  void step();
+  std::array<DistanceBeam, MAX_BEAMS> read_beams();
+
+  const PoseChannel& poses;
+  std::array<pros::Distance*, MAX_BEAMS> sensors;
+  MonteCarloLocalization filter;
+
+  bool seeded = false;
+  PoseSample last; ///< Odometry at the previous step
+  uint32_t sequence = 0;
+
+  SnapshotBuffer<MclCorrection> published;
+  LoopTimer loop;
+  std::atomic<bool> started{false};
+};
+
+#endif // RELOCALIZER_HPP
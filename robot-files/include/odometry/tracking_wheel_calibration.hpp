@@ -0,0 +1,73 @@
+/**
+ * @file tracking_wheel_calibration.hpp
+ * @brief Solves tracking wheel offsets and diameters from calibration runs
+ *
+ * Spinning in place moves a tracking wheel only through its offset: every
+ * radian turned rolls it -offset inches (LemLib's sign convention, as the
+ * EKF uses). A straight drive of known length then pins down the effective
+ * diameter, which the offsets scale with. Together they give each wheel's
+ * true geometry instead of the nominal diameter and a hard-coded offset.
+ *
+ * The solver has no PROS dependency. The result is saved as a small text
+ * file, like the autotuned gains, and loaded at startup.
+ */
+
+#ifndef TRACKING_WHEEL_CALIBRATION_HPP
+#define TRACKING_WHEEL_CALIBRATION_HPP
+
+#include <cstddef>
+
+#include "odometry/ekf_odometry.hpp"
+
+/**
+ * @struct WheelTravel
+ * @brief What each sensor measured over one calibration segment
+ */
+struct WheelTravel {
+  float verticalDeg = 0;   ///< Vertical tracking wheel rotation
+  float horizontalDeg = 0; ///< Horizontal tracking wheel rotation
+  float turnDeg = 0;       ///< IMU heading change, clockwise
+};
+
+/**
+ * @struct TrackingWheelFit
+ * @brief Solved geometry of both tracking wheels
+ */
+struct TrackingWheelFit {
+  EkfWheel vertical;
+  EkfWheel horizontal;
+  bool diameterFitted = false; ///< false: the straight line was missing and the nominal diameters were kept
+  float spinResidual = 0;      ///< RMS misfit of the spins (inches of wheel travel)
+  bool valid = false;          ///< Enough turning was seen and the diameters are plausible
+};
+
+/**
+ * @brief Fits both wheels' offsets, and their diameters if a line was driven
+ *
+ * The horizontal wheel cannot be rolled a known distance by a tank drive, so
+ * its diameter gets the same correction factor as the vertical wheel's; both
+ * are assumed to be the same wheel model.
+ *
+ * @param spins Spin-in-place segments; turn both ways so IMU scale errors cancel
+ * @param spinCount Number of spins
+ * @param line Straight segment, or nullptr to keep the nominal diameters
+ * @param lineDistance True length of the straight segment (inches)
+ * @param nominalVertical Nominal vertical wheel (diameter used without a line)
+ * @param nominalHorizontal Nominal horizontal wheel
+ */
+TrackingWheelFit fit_tracking_wheels(const WheelTravel* spins, std::size_t spinCount, const WheelTravel* line,
+                                     float lineDistance, EkfWheel nominalVertical, EkfWheel nominalHorizontal);
+
+/**
+ * @brief Writes a fit for load_tracking_wheels()
+ * @return false if there is no SD card or the write failed
+ */
+bool save_tracking_wheels(const char* path, const TrackingWheelFit& fit);
+
+/**
+ * @brief Reads a saved fit over the given wheels; leaves them untouched if there is none
+ * @return true if both wheels were loaded
+ */
+bool load_tracking_wheels(const char* path, EkfWheel& vertical, EkfWheel& horizontal);
+
+#endif // TRACKING_WHEEL_CALIBRATION_HPP
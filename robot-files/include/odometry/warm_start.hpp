@@ -0,0 +1,79 @@
+/**
+ * @file warm_start.hpp
+ * @brief Odometry state persisted to the SD card for a fast restart
+ *
+ * A full IMU calibration blocks initialize() for seconds, and a brain that
+ * reboots in the queue or on the field pays it again. The EKF integrates the
+ * raw gyro rates against its own bias estimates, so it does not need the
+ * IMU's internal calibration at all, only a good starting bias. This file
+ * keeps those biases, the tracking-wheel geometry they were estimated with
+ * and the last known pose, so a restart can pick up where it left off once
+ * a short stillness check agrees with them.
+ *
+ * LemLib's odometry does rely on the IMU's internal calibration, which the
+ * IMU keeps for as long as it stays powered. Without the EKF the record's
+ * biases are 0, so the same check confirms the gyros still read zero at rest.
+ *
+ * The record is a fixed-size binary struct with a magic number, version and
+ * checksum; anything that fails those is treated as no record.
+ */
+
+#ifndef WARM_START_HPP
+#define WARM_START_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/sensor_hub.hpp"
+
+/**
+ * @struct WarmStartRecord
+ * @brief Everything a warm start restores
+ */
+struct WarmStartRecord {
+  static constexpr uint32_t MAGIC = 0x54535757; // "WWST"
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t magic = MAGIC;
+  uint32_t version = VERSION;
+  std::array<float, SensorSnapshot::MAX_IMUS> gyroBias{}; ///< deg/s, clockwise-positive, as HeadingFusion uses
+  float verticalOffset = 0;   ///< Tracking wheel geometry the biases and pose were tracked with (inches)
+  float horizontalOffset = 0;
+  float x = 0;                ///< Last known pose (inches, degrees)
+  float y = 0;
+  float theta = 0;
+  uint32_t checksum = 0;      ///< Of every byte before it
+};
+
+/**
+ * @struct StillnessCheck
+ * @brief Running mean and spread of one gyro while the robot should be still
+ */
+struct StillnessCheck {
+  uint32_t samples = 0;
+  double sum = 0;
+  double sumSquares = 0;
+
+  void add(float rate) {
+    samples++;
+    sum += rate;
+    sumSquares += static_cast<double>(rate) * rate;
+  }
+
+  float mean() const;
+  float deviation() const;
+};
+
+/**
+ * @brief Fills in the checksum and writes the record
+ * @return false if there is no SD card or the write failed
+ */
+bool save_warm_start(const char* path, WarmStartRecord record);
+
+/**
+ * @brief Reads a record, rejecting a missing, torn or outdated file
+ */
+bool load_warm_start(const char* path, WarmStartRecord& record);
+
+#endif // WARM_START_HPP
@@ -0,0 +1,65 @@
+/**
+ * @file clock.hpp
+ * @brief Time source abstraction for the subsystem scheduler
+ *
+ * The scheduler only ever asks a Clock for the time, so the same schedule can
+ * be driven by the V5 system timer on the robot or by a VirtualClock that a
+ * host-side harness advances by hand.
+ */
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <cstdint>
+
+/**
+ * @class Clock
+ * @brief Monotonic microsecond time source
+ */
+class Clock {
+public:
+  virtual ~Clock() = default;
+
+  /**
+   * @brief Current time in microseconds
+   */
+  virtual uint64_t now_us() = 0;
+};
+
+/**
+ * @class ProsClock
+ * @brief Clock backed by pros::micros()
+ */
+class ProsClock : public Clock {
+public:
+  uint64_t now_us() override;
+};
+
+/**
+ * @class VirtualClock
+ * @brief Manually advanced clock for verifying schedules off-robot
+ *
+ * Time only moves when advance_us()/advance_ms() is called, so a callback can
+ * simulate its own execution time by advancing the clock it was scheduled on.
+ */
+class VirtualClock : public Clock {
+public:
+  uint64_t now_us() override { return timeUs; }
+
+  /**
+   * @brief Moves time forward
+   * @param us Microseconds to advance
+   */
+  void advance_us(uint64_t us) { timeUs += us; }
+
+  /**
+   * @brief Moves time forward
+   * @param ms Milliseconds to advance
+   */
+  void advance_ms(uint32_t ms) { timeUs += static_cast<uint64_t>(ms) * 1000; }
+
+private:
+  uint64_t timeUs = 0;
+};
+
+#endif // CLOCK_HPP
@@ -0,0 +1,141 @@
+/**
+ * @file loop_timer.hpp
+ * @brief Fixed-period loop timing with jitter and overrun accounting
+ *
+ * pros::delay(10) at the bottom of a loop gives a period of 10 ms plus however
+ * long the loop body took. LoopTimer instead sleeps until an absolute deadline
+ * with pros::Task::delay_until so the loop runs at a true fixed period, and
+ * records how late each tick actually started so lost control bandwidth can be
+ * measured on the robot.
+ */
+
+#ifndef LOOP_TIMER_HPP
+#define LOOP_TIMER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct LoopStats
+ * @brief Timing statistics for a fixed-period loop
+ *
+ * Pure bookkeeping with no PROS dependency, so the same accounting can be fed
+ * from a real clock on the robot or a virtual clock on the host.
+ */
+struct LoopStats {
+  /**
+   * @brief Upper edges (exclusive) of the start-jitter histogram buckets, in microseconds
+   *
+   * The final histogram bucket collects every tick at or beyond the last edge.
+   */
+  static constexpr std::array<uint32_t, 7> JITTER_BUCKET_EDGES_US = {100, 250, 500, 1000, 2000, 5000, 10000};
+  static constexpr std::size_t JITTER_BUCKETS = JITTER_BUCKET_EDGES_US.size() + 1;
+
+  uint32_t ticks = 0;        ///< Number of ticks recorded
+  uint32_t overruns = 0;     ///< Ticks whose body finished after the next tick's deadline
+  uint32_t missedTicks = 0;  ///< Whole periods skipped to resynchronise after an overrun
+  uint32_t lastJitterUs = 0; ///< Start jitter of the most recent tick
+  uint32_t maxJitterUs = 0;  ///< Worst start jitter seen
+  uint32_t lastBodyUs = 0;   ///< Body execution time of the most recent tick
+  uint32_t maxBodyUs = 0;    ///< Worst body execution time seen
+  uint64_t totalJitterUs = 0;
+  uint64_t totalBodyUs = 0;
+  std::array<uint32_t, JITTER_BUCKETS> jitterHistogram = {};
+
+  /**
+   * @brief Records one completed tick
+   * @param jitterUs How late the tick started relative to its deadline
+   * @param bodyUs How long the tick body ran
+   * @param overran Whether the body ran past the following deadline
+   * @param skipped Whole periods skipped before the following tick
+   */
+  void record(uint32_t jitterUs, uint32_t bodyUs, bool overran, uint32_t skipped);
+
+  /**
+   * @brief Clears all counters and the histogram
+   */
+  void reset();
+
+  /**
+   * @brief Mean start jitter over all recorded ticks, in microseconds
+   */
+  uint32_t mean_jitter_us() const;
+
+  /**
+   * @brief Mean body execution time over all recorded ticks, in microseconds
+   */
+  uint32_t mean_body_us() const;
+
+  /**
+   * @brief Histogram bucket index for a given start jitter
+   */
+  static std::size_t bucket_for(uint32_t jitterUs);
+};
+
+/**
+ * @class LoopTimer
+ * @brief Paces a loop at a fixed period using pros::Task::delay_until
+ *
+ * Usage:
+ * @code {.cpp}
+ * LoopTimer loop(10);
+ * loop.start();
+ * while (true) {
+ *   doWork();
+ *   loop.wait(); // sleeps until the next 10 ms boundary
+ * }
+ * @endcode
+ *
+ * If the body overruns by one or more whole periods, the missed deadlines are
+ * skipped rather than run back-to-back, so a stall never turns into a burst of
+ * catch-up ticks.
+ */
+class LoopTimer {
+public:
+  /**
+   * @brief Constructor
+   * @param periodMs Loop period in milliseconds
+   */
+  explicit LoopTimer(uint32_t periodMs);
+
+  /**
+   * @brief Anchors the schedule to the current time - call once before the loop
+   */
+  void start();
+
+  /**
+   * @brief Ends the current tick and sleeps until the next deadline
+   *
+   * Records the body time of the tick that just finished, then the start
+   * jitter of the tick that is about to begin.
+   */
+  void wait();
+
+  /**
+   * @brief Snapshot of the timing statistics
+   *
+   * Safe to call from another task for diagnostics; counters are copied
+   * without locking, so a snapshot taken mid-update may mix two ticks.
+   */
+  LoopStats stats() const;
+
+  /**
+   * @brief Clears the timing statistics without disturbing the schedule
+   */
+  void reset_stats();
+
+  /**
+   * @brief Configured loop period in milliseconds
+   */
+  uint32_t period() const;
+
+private:
+  uint32_t periodMs;
+  uint32_t wakeMs;      ///< delay_until anchor; deadline of the current tick in ms
+  uint64_t deadlineUs;  ///< Deadline of the current tick in microseconds
+  uint64_t tickStartUs; ///< Actual start time of the current tick
+  LoopStats loopStats;
+};
+
+#endif // LOOP_TIMER_HPP
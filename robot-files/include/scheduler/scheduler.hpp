@@ -0,0 +1,100 @@
+/**
+ * @file scheduler.hpp
+ * @brief Multi-rate subsystem registry with deterministic ordering
+ *
+ * Each subsystem is registered with its own period and priority. Every tick,
+ * all entries that are due run in priority order (highest first, ties in
+ * registration order), so a 50 ms pneumatic poll no longer costs the same as a
+ * 5 ms drive update. Scheduler has no PROS dependency; SchedulerTask runs it
+ * on a pros::Task.
+ */
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "scheduler/clock.hpp"
+
+/**
+ * @struct ScheduledEntry
+ * @brief One registered subsystem callback and its run statistics
+ */
+struct ScheduledEntry {
+  const char* name;               ///< Name for diagnostics
+  uint32_t periodMs;              ///< How often the callback should run
+  int priority;                   ///< Higher runs first within a tick
+  std::function<void()> callback; ///< Work to run when due
+
+  uint64_t nextDueUs = 0;  ///< Next time the entry is due
+  uint32_t runs = 0;       ///< Number of times the callback ran
+  uint32_t missed = 0;     ///< Whole periods skipped because the entry ran late
+  uint32_t lastExecUs = 0; ///< Execution time of the last run
+  uint32_t maxExecUs = 0;  ///< Worst execution time seen
+};
+
+/**
+ * @class Scheduler
+ * @brief Runs registered callbacks at their declared periods
+ *
+ * @code {.cpp}
+ * VirtualClock clock;
+ * Scheduler scheduler(clock);
+ * scheduler.add("drive", 5, 3, [] { ... });
+ * scheduler.add("pneumatics", 50, 1, [] { ... });
+ * scheduler.reset();
+ * for (int i = 0; i < 20; i++) {
+ *   scheduler.tick();
+ *   clock.advance_ms(scheduler.base_period_ms());
+ * }
+ * @endcode
+ */
+class Scheduler {
+public:
+  /**
+   * @brief Constructor
+   * @param clock Time source used for due times and execution timing
+   */
+  explicit Scheduler(Clock& clock);
+
+  /**
+   * @brief Registers a callback
+   * @param name Name for diagnostics
+   * @param periodMs Period in milliseconds (must be non-zero)
+   * @param priority Higher values run first when several entries are due together
+   * @param callback Work to run each period
+   */
+  void add(const char* name, uint32_t periodMs, int priority, std::function<void()> callback);
+
+  /**
+   * @brief Marks every entry as due now - call before the first tick
+   */
+  void reset();
+
+  /**
+   * @brief Runs every entry that is due, in priority order
+   * @return Number of callbacks that ran
+   */
+  uint32_t tick();
+
+  /**
+   * @brief Greatest common divisor of all registered periods
+   *
+   * Ticking at this period hits every entry's deadline exactly.
+   */
+  uint32_t base_period_ms() const;
+
+  /**
+   * @brief Registered entries in execution order
+   */
+  const std::vector<ScheduledEntry>& entries() const;
+
+private:
+  Clock& clock;
+  std::vector<ScheduledEntry> schedule;
+  uint32_t basePeriodMs;
+};
+
+#endif // SCHEDULER_HPP
@@ -0,0 +1,92 @@
+/**
+ * @file scheduler_task.hpp
+ * @brief Runs a Scheduler on a PROS task at its base period
+ */
+
+#ifndef SCHEDULER_TASK_HPP
+#define SCHEDULER_TASK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "pros/rtos.hpp"
+#include "scheduler/clock.hpp"
+#include "scheduler/loop_timer.hpp"
+#include "scheduler/scheduler.hpp"
+
+/**
+ * @class SchedulerTask
+ * @brief One execution lane: a Scheduler paced by a LoopTimer
+ *
+ * Subsystems that must not be delayed by slower work go on their own lane with
+ * a higher task priority. A lane always runs on a task it spawns itself
+ * (start()) and exits after stop(). It never borrows a competition task:
+ * PROS deletes those on disable or comms loss, which would leave the lane
+ * marked running with nothing ticking it. Only one tick loop ever runs at a
+ * time: a start() right after stop() waits for the previous one to finish
+ * its tick and exit.
+ */
+class SchedulerTask {
+public:
+  /**
+   * @brief Constructor
+   * @param name Task name for diagnostics
+   * @param taskPriority PROS task priority used by start()
+   */
+  SchedulerTask(const char* name, uint32_t taskPriority);
+
+  /**
+   * @brief Registers a callback on this lane - see Scheduler::add()
+   */
+  void add(const char* name, uint32_t periodMs, int priority, std::function<void()> callback);
+
+  /**
+   * @brief Spawns a task that runs the lane; does nothing if already running
+   *
+   * If a stopped tick loop has not exited yet, blocks the caller until it has
+   * (at most one lane period).
+   */
+  void start();
+
+  /**
+   * @brief Asks the lane to exit after its current tick
+   */
+  void stop();
+
+  /**
+   * @brief Whether the lane is currently running
+   */
+  bool is_running() const;
+
+  /**
+   * @brief Lane timing statistics (jitter, overruns) - see LoopTimer::stats()
+   */
+  LoopStats loop_stats() const;
+
+  /**
+   * @brief The underlying scheduler, for per-entry statistics
+   */
+  const Scheduler& scheduler() const;
+
+private:
+  /**
+   * @brief Tick loop of the task start() spawns; exits once running is cleared
+   */
+  void execute();
+
+  /**
+   * @brief Blocks until no tick loop is left over from before the last stop()
+   */
+  void wait_for_exit() const;
+
+  const char* name;
+  uint32_t taskPriority;
+  ProsClock clock;
+  Scheduler lane;
+  LoopTimer loop;
+  std::atomic<bool> running;
+  std::atomic<bool> active; ///< A tick loop is inside execute(); cleared as it returns
+};
+
+#endif // SCHEDULER_TASK_HPP
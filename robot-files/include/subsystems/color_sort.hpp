@@ -0,0 +1,137 @@
+/**
+ * @file color_sort.hpp
+ * @brief Classifies pieces on the conveyor by color and ejects the other alliance's
+ *
+ * An optical sensor looks at the conveyor from its own high-priority task,
+ * at the sensor's shortest integration time. A piece counts as present when
+ * it is close to the sensor (proximity), and its color counts only when the
+ * light is saturated enough to come from the piece rather than the belt.
+ * Once CONFIRM_SAMPLES readings in a row agree, the piece is classified.
+ *
+ * A piece of the wrong color gets an eject pulse on the end effector (and
+ * optionally the intake) when it reaches the eject point. A ConveyorTracker
+ * follows it there by the end effector's position from where it first
+ * reached the sensor, so the timing holds at any conveyor speed. The pulse
+ * overrides whatever the mechanism lane commands and hands the motors back
+ * when it ends. Several pieces can be in flight at once.
+ */
+
+#ifndef COLOR_SORT_HPP
+#define COLOR_SORT_HPP
+
+#include <atomic>
+#include <cstdint>
+
+#include "globals.hpp"
+#include "pros/optical.hpp"
+#include "scheduler/loop_timer.hpp"
+#include "subsystems/conveyor_tracker.hpp"
+#include "subsystems/endeffector.hpp"
+#include "subsystems/intake.hpp"
+#include "util/snapshot_buffer.hpp"
+
+/**
+ * @struct HueBand
+ * @brief Hue range in degrees; lower > upper wraps through 0 (red is 350 to 20)
+ */
+struct HueBand {
+  float lower = 0;
+  float upper = 0;
+};
+
+/**
+ * @struct ColorGate
+ * @brief What a reading must look like to count as a piece of a color
+ */
+struct ColorGate {
+  HueBand red;
+  HueBand blue;
+  float minSaturation = 0; ///< 0 to 1
+  int32_t minProximity = 0; ///< 0 to 255, higher is closer
+};
+
+/**
+ * @brief Whether a hue (any angle) lies in a band, wrapping through 0
+ */
+bool hue_in_band(float hue, HueBand band);
+
+/**
+ * @brief Color of one reading
+ * @return NONE if nothing is close enough, the light is too grey or the hue is in neither band
+ */
+globals::SensorColors classify_color(float hue, float saturation, int32_t proximity, const ColorGate& gate);
+
+/**
+ * @struct ColorSortStats
+ * @brief Counters and timing of the sort
+ */
+struct ColorSortStats {
+  uint32_t pieces = 0;       ///< Pieces classified
+  uint32_t ejected = 0;      ///< Eject pulses fired
+  uint32_t unclassified = 0; ///< Pieces that left the sensor without a confident color
+  uint32_t dropped = 0;      ///< Ejections lost because too many were pending
+  uint32_t reversed = 0;     ///< Pieces the belt carried back to the sensor before they were ejected
+  uint32_t lastLatencyUs = 0; ///< Piece reaching the sensor to its classification
+  uint32_t meanLatencyUs = 0;
+  uint32_t maxLatencyUs = 0;
+  globals::SensorColors lastColor = globals::SensorColors::NONE;
+};
+
+/**
+ * @class ColorSort
+ * @brief Owns the optical sensor, the classification task and the eject schedule
+ */
+class ColorSort {
+public:
+  /**
+   * @brief Constructor
+   * @param intake Driven during the pulse when COLOR_SORT_CONSTANTS::EJECT_WITH_INTAKE
+   * @param endEffector Reversed to eject
+   */
+  ColorSort(Intake& intake, EndEffector& endEffector);
+
+  /**
+   * @brief Configures the sensor and starts the task; does nothing if already started
+   */
+  void start(uint32_t periodMs, uint32_t taskPriority);
+
+  /**
+   * @brief Latest statistics; never blocks
+   */
+  ColorSortStats stats() const;
+
+  /**
+   * @brief Task timing statistics
+   */
+  LoopStats loop_stats() const;
+
+private:
+  void step();
+  void classify(uint64_t nowUs);
+  void run_pulses(uint64_t nowUs);
+
+  Intake& intake;
+  EndEffector& endEffector;
+  pros::Optical optical;
+  ColorGate gate;
+
+  // The piece in front of the sensor
+  bool tracking = false;
+  bool decided = false;
+  uint64_t arrivalUs = 0;
+  float arrivalPosition = 0; ///< Belt position when it reached the sensor
+  globals::SensorColors candidate = globals::SensorColors::NONE;
+  int agreeing = 0;
+
+  ConveyorTracker conveyor; ///< Wrong-color pieces on their way to the eject point
+  bool pulsing = false;
+  uint64_t pulseEndUs = 0;
+
+  ColorSortStats counters;
+  uint64_t totalLatencyUs = 0;
+  SnapshotBuffer<ColorSortStats> published;
+  LoopTimer loop;
+  std::atomic<bool> started{false};
+};
+
+#endif // COLOR_SORT_HPP
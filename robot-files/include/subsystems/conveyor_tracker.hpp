@@ -0,0 +1,105 @@
+/**
+ * @file conveyor_tracker.hpp
+ * @brief Follows pieces along the conveyor by belt travel instead of time
+ *
+ * A fixed delay between seeing a piece and ejecting it is only right at the
+ * speed it was measured at. The end effector runs at 127 or 90, sags as its
+ * motor heats up, and stops while a piece waits to be scored. Belt travel
+ * is the same at any speed, so each piece records the belt position where
+ * it was seen and is due when the belt has carried it to the eject point.
+ *
+ * Firing has to lead the piece by the eject latency: the time for the
+ * command to reach the motor and the rollers to reverse, plus how far the
+ * motor's reported position lags the belt. The measured belt speed turns
+ * that time into distance.
+ *
+ * No PROS dependency; tools/conveyor_replay.cpp replays encoder traces
+ * through it on the host.
+ */
+
+#ifndef CONVEYOR_TRACKER_HPP
+#define CONVEYOR_TRACKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct ConveyorConfig
+ * @brief Conveyor geometry and timing
+ */
+struct ConveyorConfig {
+  float exitDistance = 0;       ///< Belt travel from the sensor to the eject point (inches)
+  float leadTime = 0;           ///< Eject latency to fire ahead of the piece by (seconds)
+  float velocityWindow = 0.02f; ///< History the belt speed is measured over (seconds); spans two motor updates
+  float reentryDistance = 1;    ///< Reversed this far back past the sensor, a piece is the sensor's again (inches)
+};
+
+/**
+ * @class ConveyorTracker
+ * @brief Belt position, belt speed and the pieces riding on it
+ */
+class ConveyorTracker {
+public:
+  static constexpr std::size_t MAX_PIECES = 4;
+
+  explicit ConveyorTracker(ConveyorConfig config)
+      : config(config) {}
+
+  /**
+   * @brief Records a belt position sample; call once per cycle
+   * @param timeUs Sample time
+   * @param position Belt travel (inches), increasing as pieces move towards the eject point
+   */
+  void update(uint64_t timeUs, float position);
+
+  /**
+   * @brief Starts following a piece
+   * @param position Belt position when it reached the sensor
+   * @return false if MAX_PIECES are already being followed
+   */
+  bool add(float position);
+
+  /**
+   * @brief Stops following the oldest piece if it reaches the eject point within the lead time
+   * @return true if it is time to fire
+   */
+  bool take_due();
+
+  /**
+   * @brief Stops following pieces the belt carried back past the sensor
+   * @return How many were dropped; the sensor will see them again
+   */
+  std::size_t drop_reversed();
+
+  /**
+   * @brief Forgets every piece
+   */
+  void clear() { count = 0; }
+
+  float position() const { return latestPosition; }
+  float velocity() const { return latestVelocity; } ///< Inches per second
+  std::size_t pending() const { return count; }
+
+private:
+  static constexpr std::size_t HISTORY = 8;
+
+  struct Sample {
+    uint64_t timeUs = 0;
+    float position = 0;
+  };
+
+  ConveyorConfig config;
+
+  std::array<Sample, HISTORY> history{};
+  std::size_t historyHead = 0; ///< Next slot to write
+  std::size_t historyCount = 0;
+  float latestPosition = 0;
+  float latestVelocity = 0;
+
+  std::array<float, MAX_PIECES> pieces{}; ///< Belt position each piece was seen at, oldest first
+  std::size_t first = 0;
+  std::size_t count = 0;
+};
+
+#endif // CONVEYOR_TRACKER_HPP
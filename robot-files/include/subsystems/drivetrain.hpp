@@ -6,7 +6,7 @@
  * - 6 VEX V5 motors (3 left, 3 right) for differential drive
  * - LemLib chassis integration for autonomous navigation
  * - Odometry tracking using 2 tracking wheels + IMU sensor
- * - Exponential drive curves for smooth operator control
+ * - Exponential drive curves (precomputed lookup tables) for smooth operator control
  * - Real-time position display on brain screen
  */
 
@@ -15,7 +15,18 @@
 
 #include "lemlib/api.hpp" // for lemlib::Chassis, ExpoDriveCurve, ControllerSettings, TrackingWheel
 #include "constants.hpp"   // for port and tuning constants
-#include "globals.hpp"     // for globals::controller
+#include "input/input_frame.hpp" // for InputFrame
+#include "input/lut_drive_curve.hpp" // for LutDriveCurve
+#include "hardware/cached_actuators.hpp" // for CachedMotorGroup
+#include "hardware/sensor_hub.hpp" // for SensorHub
+#include "odometry/ekf_odometry.hpp" // for EkfOdometry
+#include "odometry/pose_channel.hpp" // for PoseChannel
+#include "odometry/relocalizer.hpp" // for Relocalizer
+#include "odometry/tracking_wheel_calibration.hpp" // for WheelTravel
+#include "odometry/warm_start.hpp" // for WarmStartRecord
+#include "vision/vision_tracker.hpp" // for VisionTracker
+#include "motion/motion_chassis.hpp" // for MotionChassis
+#include "motion/pid_autotune.hpp" // for RelayResult
 
 /**
  * @class Drivetrain
@@ -44,29 +55,46 @@ class Drivetrain {
 
   /**
    * @brief Operator control drive method - call every loop iteration
+   * @param input Controller snapshot for this tick
    *
    * Reads controller joysticks and applies arcade drive control:
    * - Left stick Y-axis: Forward/backward throttle
    * - Right stick X-axis: Turning/rotation
    * - Applies exponential curves for smooth control
    * - Special handling: Enhanced turning sensitivity when throttle is near zero
+   * - With VOLTAGE_DRIVE_CONSTANTS::ENABLED, writes move_voltage instead of move
+   * - While CONTROLLER_BUTTONS::DRIVETRAIN::AIM_ASSIST is held, adds a turn
+   *   towards the nearest tracked game piece ahead
    */
-  void drive();
+  void drive(const InputFrame& input);
 
   /**
    * @brief Main run method - call this in the robot loop
+   * @param input Controller snapshot for this tick
    *
    * This method handles all drivetrain operations during teleoperated mode.
    * It calls drive() and can be extended to include additional functionality.
    */
-  void run();
+  void run(const InputFrame& input);
 
   /**
    * @brief Initialize drivetrain - calibrates sensors and starts telemetry
    *
    * Performs:
    * - Sensor calibration (IMU, tracking wheels)
+   * - Applies the tracking wheel geometry saved by calibrate_tracking_wheels(), if any
+   * - With ODOMETRY_CONSTANTS::USE_EKF, starts the EKF odometry task, which
+   *   owns the chassis pose, instead of LemLib's odometry
+   * - Either way, the IMUs skip calibration when the SD card's warm start
+   *   record checks out, and otherwise calibrate in the background without
+   *   blocking initialize(); LemLib's odometry starts once they are done
    * - Sets motor brake modes to BRAKE (coast would be E_MOTOR_BRAKE_COAST)
+   * - Loads autotuned PID gains from the SD card, if saved
+   * - Starts the SensorHub sampling task
+   * - Starts the pose publisher feeding the PoseChannel
+   * - With USE_EKF and any PORT_VALUES::DISTANCE_* sensor, starts the
+   *   relocalizer and folds its corrections into the EKF's pose
+   * - With PORT_VALUES::AI_VISION, starts the game piece tracker
    * - Starts background task for LCD position display
    * - Prepares chassis for operation
    *
@@ -74,6 +102,68 @@ class Drivetrain {
    */
   void init();
 
+  /**
+   * @brief Runs the drive characterization tests and saves the log to the SD card
+   *
+   * Quasistatic ramps then voltage steps, forwards and backwards, pausing
+   * between tests (CHARACTERIZATION_CONSTANTS). Blocks for about half a minute;
+   * feed the resulting CSV to tools/feedforward_fitter.cpp and copy the gains
+   * into DRIVETRAIN_CONSTANTS::FEEDFORWARD.
+   * @return false if the log could not be written
+   */
+  bool characterize();
+
+  /**
+   * @brief Autotunes the lateral and angular PID gains
+   *
+   * Runs a relay test on each axis (the robot oscillates in place around its
+   * start pose), identifies the plant and searches for the gains that settle
+   * fastest within AUTOTUNE_CONSTANTS::MAX_OVERSHOOT. The gains are applied
+   * immediately and saved to AUTOTUNE_CONSTANTS::GAINS_PATH, which init()
+   * loads on later boots, so no rebuild is needed.
+   * @return false if a relay test failed or the gains could not be saved
+   */
+  bool autotune();
+
+  /**
+   * @brief Compares command-to-motion latency of move_velocity and the voltage path
+   *
+   * Alternates forwards and backwards velocity steps through each path
+   * (LATENCY_CONSTANTS), prints the onset and rise times of both to the
+   * terminal and saves every trial to LATENCY_CONSTANTS::LOG_PATH.
+   * @return false if the log could not be written
+   */
+  bool measure_output_latency();
+
+  /**
+   * @brief Measures the tracking wheels' true offsets and diameters
+   *
+   * Recalibrates IMU 1 with the robot still, spins in place SPIN_TURNS each
+   * way, then, with a front distance sensor, drives straight at the wall
+   * from TRACKING_CALIBRATION_CONSTANTS::LINE_START_GAP (tape-measured) to
+   * LINE_STOP_GAP. The fit is printed to the terminal and saved to
+   * TRACKING_CALIBRATION_CONSTANTS::PATH, which init() applies on the next
+   * boot; the running odometry keeps its geometry until then. Without a
+   * front distance sensor only the offsets are fitted.
+   * @return false if the fit was implausible or could not be saved
+   */
+  bool calibrate_tracking_wheels();
+
+  /**
+   * @brief Drives onto the nearest tracked game piece ahead, re-aiming as its estimate improves
+   *
+   * Blocks until the motion ends. Pieces more than
+   * VISION_TRACKER_CONSTANTS::DRIVE_MAX_BEARING off the heading are ignored.
+   * @param timeoutMs Longest the whole motion may take
+   * @return false if no piece is tracked (or there is no camera)
+   */
+  bool drive_to_nearest_piece(int timeoutMs);
+
+  /**
+   * @brief Accessor for the game piece tracker
+   */
+  const VisionTracker& get_vision() const;
+
   /**
    * @brief Accessor for LemLib chassis object
    * @return Reference to the internal chassis object for autonomous control
@@ -82,8 +172,10 @@ class Drivetrain {
    * - chassis.moveToPoint(x, y, timeout)
    * - chassis.turnToHeading(angle, timeout)
    * - chassis.setPose(x, y, heading)
+   * - chassis.profiledMoveToPoint(x, y, timeout)
+   * - chassis.profiledTurnToHeading(angle, timeout)
    */
-  lemlib::Chassis& get_chassis();
+  MotionChassis& get_chassis();
 
   /**
    * @brief Get left motor group for debugging
@@ -97,24 +189,117 @@ class Drivetrain {
    */
   pros::MotorGroup& get_right_motors();
 
+  /**
+   * @brief Accessor for the drivetrain sensor hub
+   * @return Reference to the hub publishing timestamped snapshots of every drivetrain sensor
+   */
+  SensorHub& get_sensor_hub();
+
+  /**
+   * @brief Accessor for the published pose
+   * @return Reference to the channel; read() it instead of calling chassis.getPose()
+   *         from UI, logging or subsystem code so readers never contend with odometry,
+   *         or sample_at() it for the pose at a sensor's timestamp or a predicted time
+   */
+  const PoseChannel& get_pose_channel() const;
+
+  /**
+   * @brief Forces the next driver command through the output caches
+   *
+   * Call when driver control resumes after LemLib has been commanding the
+   * motors directly (e.g. at the start of opcontrol).
+   */
+  void invalidate_output_cache();
+
+  /**
+   * @brief Left side write statistics (issued vs. suppressed by the command cache)
+   */
+  WriteStats get_left_output_stats() const;
+
+  /**
+   * @brief Right side write statistics (issued vs. suppressed by the command cache)
+   */
+  WriteStats get_right_output_stats() const;
+
 private:
+  /**
+   * @brief Turn input steering towards the nearest tracked piece ahead (0 if none)
+   */
+  int aim_assist_turn();
+
+  /**
+   * @brief Relay-oscillates one axis around the current pose and measures the limit cycle
+   */
+  RelayResult run_relay(bool angular);
+
+  /**
+   * @brief Applies gains saved by autotune(), if the SD card has them
+   */
+  void load_tuned_gains();
+
+  /**
+   * @brief Spins in place until IMU 1 has turned the given amount, then settles
+   * @param degrees Clockwise-positive
+   */
+  WheelTravel measure_spin(float degrees);
+
+  /**
+   * @brief Drives straight at the wall until the front distance sensor reads LINE_STOP_GAP, then settles
+   * @param distance Set to the distance driven, measured by the front distance sensor (inches)
+   * @return false if the sensor lost the wall or the drive timed out
+   */
+  bool measure_line(WheelTravel& travel, float& distance);
+
+  /**
+   * @brief Applies the geometry saved by calibrate_tracking_wheels() to LemLib and the EKF (before either runs)
+   */
+  void load_tracking_wheel_geometry();
+
+  /**
+   * @brief Checks the saved warm start record against a short stillness check
+   *
+   * Seeds the EKF's gyro biases when it is in use; the caller restores the pose.
+   *
+   * @param record Filled with the saved record
+   * @return false if a full IMU calibration is needed
+   */
+  bool try_warm_start(WarmStartRecord& record);
+
+  /**
+   * @brief Calibrates the IMUs on a background task, then starts LemLib's odometry if it is in use
+   */
+  void calibrate_imus_in_background();
+
+  /**
+   * @brief Starts the low-priority task writing the warm start record to the SD card
+   */
+  void start_warm_start_saver();
+
   // ====================
   // MOTORS
   // ====================
   pros::MotorGroup leftMotorGroup;  ///< Left side motor group (ports from PORT_VALUES::LEFT_* constants)
   pros::MotorGroup rightMotorGroup; ///< Right side motor group (ports from PORT_VALUES::RIGHT_* constants)
+  CachedMotorGroup leftOutput;      ///< Driver-control writes to the left side; unchanged commands are dropped
+  CachedMotorGroup rightOutput;     ///< Driver-control writes to the right side; unchanged commands are dropped
 
   // ====================
   // SENSORS
   // ====================
   pros::Imu imu1; ///< Primary IMU for heading tracking (PORT_VALUES::IMU_1)
-  // pros::Imu imu2; ///< Secondary IMU for sensor fusion (more accurate heading)
+  pros::Imu imu2; ///< Secondary IMU, fused with imu1 by the EKF (PORT_VALUES::IMU_2, 0 = none)
+  pros::Gps gps;  ///< Optional field GPS (PORT_VALUES::GPS, 0 = none)
+  pros::Distance distanceFront; ///< Relocalization distance sensors (PORT_VALUES::DISTANCE_*, 0 = none)
+  pros::Distance distanceBack;
+  pros::Distance distanceLeft;
+  pros::Distance distanceRight;
+  pros::AIVision aiVision; ///< Game piece camera (PORT_VALUES::AI_VISION, 0 = none)
 
   // ====================
   // DRIVE CURVES
   // ====================
-  lemlib::ExpoDriveCurve throttleCurve; ///< Exponential curve for forward/backward control (OPERATOR_CONSTANTS::THROTTLE)
-  lemlib::ExpoDriveCurve steerCurve;    ///< Exponential curve for turning control (OPERATOR_CONSTANTS::STEER)
+  LutDriveCurve throttleCurve; ///< Forward/backward curve (OPERATOR_CONSTANTS::THROTTLE with USE_CURVES, else linear)
+  LutDriveCurve steerCurve;    ///< Turning curve (OPERATOR_CONSTANTS::STEER with USE_CURVES, else linear)
 
   // ====================
   // PID CONTROLLERS
@@ -130,13 +315,22 @@ class Drivetrain {
 
   lemlib::TrackingWheel verticalTrackingWheel;   ///< Vertical tracking wheel object (measures forward/back)
   lemlib::TrackingWheel horizontalTrackingWheel; ///< Horizontal tracking wheel object (measures lateral movement)
+  EkfWheel verticalGeometry;   ///< Geometry both tracking wheel objects use: CHASIS_VALUES or the saved calibration
+  EkfWheel horizontalGeometry;
+
+  SensorHub sensorHub; ///< Reads motors, rotation sensors and IMU once per cycle and publishes snapshots
+  PoseChannel poseChannel; ///< Latest pose/velocity, published once per odometry update
+  EkfOdometry odometry;    ///< Fuses the SensorHub snapshots into the pose when ODOMETRY_CONSTANTS::USE_EKF
+  Relocalizer relocalizer; ///< Particle filter on the distance sensors, correcting the pose against the walls
+  VisionTracker vision;    ///< Game pieces seen by the camera, tracked in the field frame
+  SnapshotBuffer<WarmStartRecord> warmState; ///< Published by the odometry task, saved by the warm start saver
 
   // ====================
   // LEMLIB COMPONENTS
   // ====================
   lemlib::OdomSensors sensors;     ///< Container for all odometry sensors (tracking wheels + IMU)
   lemlib::Drivetrain drivetrain;   ///< LemLib drivetrain configuration (motors, dimensions, wheel size)
-  lemlib::Chassis chassis;         ///< Main LemLib chassis object - handles movement and odometry
+  MotionChassis chassis;           ///< LemLib chassis plus profiled motions - handles movement and odometry
 };
 
 #endif
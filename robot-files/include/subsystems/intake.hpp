@@ -7,7 +7,9 @@
 #define INTAKE_HPP
 
 #include "pros/motors.hpp"
-#include "pros/misc.hpp"
+#include "hardware/cached_actuators.hpp"
+#include "hardware/pulse_override.hpp"
+#include "input/input_frame.hpp"
 
 class Intake {
 public:
@@ -29,19 +31,36 @@ class Intake {
 
   /**
    * @brief Control intake based on controller input
-   * @param master Controller reference
+   * @param input Controller snapshot for this tick
    */
-  void control(pros::Controller& master);
+  void control(const InputFrame& input);
 
   /**
    * @brief Run method to be called from the main robot loop.
-   *
-   * Internally uses the global controller and links buttons to actions.
+   * @param input Controller snapshot for this tick
    */
-  void run();
+  void run(const InputFrame& input);
+
+  /**
+   * @brief Takes the motor for an eject pulse, overriding control() until end_eject() (any task)
+   * @param velocity Motor velocity (-127 to 127)
+   */
+  void begin_eject(int velocity);
+
+  /**
+   * @brief Ends an eject pulse, restoring the latest commanded velocity (any task)
+   */
+  void end_eject();
+
+  /**
+   * @brief Motor write statistics (issued vs. suppressed by the command cache)
+   */
+  WriteStats get_output_stats() const;
 
 private:
   pros::Motor intakeMotor;
+  CachedMotor intakeOutput; ///< All writes go through here; repeated commands are dropped
+  PulseOverride ejectOverride; ///< Holds back control() while the color sort ejects
 };
 
 #endif // INTAKE_HPP
\ No newline at end of file
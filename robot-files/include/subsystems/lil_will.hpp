@@ -7,7 +7,8 @@
 #define LIL_WILL_HPP
 
 #include "pros/adi.hpp"
-#include "pros/misc.hpp"
+#include "hardware/cached_actuators.hpp"
+#include "input/input_frame.hpp"
 
 class LilWill {
 public:
@@ -33,20 +34,24 @@ class LilWill {
 
   /**
    * @brief Control lil will based on controller input
-   * @param master Controller reference
+   * @param input Controller snapshot for this tick
    */
-  void control(pros::Controller& master);
+  void control(const InputFrame& input);
 
   /**
    * @brief Run method to be called from the main robot loop.
-   *
-   * Internally uses the global controller and links buttons to actions.
+   * @param input Controller snapshot for this tick
    */
-  void run();
+  void run(const InputFrame& input);
+
+  /**
+   * @brief Solenoid write statistics (issued vs. suppressed by the command cache)
+   */
+  WriteStats get_output_stats() const;
 
 private:
   pros::adi::Pneumatics lilWillPneumatic;
-  bool isExtended;
+  CachedPneumatics lilWillOutput; ///< Tracks the extended state; only writes on change
 };
 
 #endif // LIL_WILL_HPP
\ No newline at end of file
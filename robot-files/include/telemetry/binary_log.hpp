@@ -0,0 +1,112 @@
+/**
+ * @file binary_log.hpp
+ * @brief Zero-allocation binary logger for the control loops
+ *
+ * LemLib's logger formats every message on the calling task: fmt::format, an
+ * argument store, two strings and a heap-allocated Message per call, and it
+ * only checks the level after all that. BinaryLog::log() instead copies the
+ * raw argument bytes behind a fixed header into a preallocated ring: one
+ * atomic increment, a timestamp and a memcpy, with no lock, no formatting
+ * and no allocation. Calls below TELEMETRY_CONSTANTS::MIN_LEVEL compile to
+ * nothing.
+ *
+ * A low-priority drain task empties the ring. It either formats each record
+ * with its field list from record_format.hpp and prints it, or writes the
+ * records to the SD card unformatted for tools/telemetry_decoder.cpp. If the
+ * drain falls a whole ring behind, the oldest records are overwritten and
+ * the drain logs how many were lost.
+ */
+
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "constants.hpp"
+#include "telemetry/record_format.hpp"
+
+/**
+ * @struct BinaryLogStats
+ * @brief Ring counters
+ */
+struct BinaryLogStats {
+  uint32_t written = 0; ///< Records logged
+  uint32_t drained = 0; ///< Records the drain task has handed to its sink
+  uint32_t dropped = 0; ///< Overwritten before the drain task reached them
+};
+
+/**
+ * @class BinaryLog
+ * @brief The ring and its drain task
+ *
+ * Any task may log. Only the drain task reads.
+ */
+class BinaryLog {
+public:
+  static constexpr std::size_t CAPACITY = 512;
+
+  /**
+   * @brief Logs one record if Level is compiled in
+   *
+   * The arguments must match the record's field list exactly, e.g.
+   * log<LogLevel::INFO, RecordId::COLOR_EJECT>(velocity, static_cast<uint32_t>(pending)).
+   */
+  template <LogLevel Level, RecordId Id, typename... Args> void log(const Args&... args) {
+    static_assert(fields_match<Args...>(RECORD_FORMATS[static_cast<std::size_t>(Id)].fields),
+                  "arguments do not match the record's field list");
+    if constexpr (static_cast<int>(Level) >= TELEMETRY_CONSTANTS::MIN_LEVEL) {
+      constexpr std::size_t size = (sizeof(Args) + ... + 0);
+      static_assert(size <= MAX_PAYLOAD, "record payload is too large");
+      std::array<uint8_t, size == 0 ? 1 : size> payload;
+      std::size_t offset = 0;
+      ((std::memcpy(payload.data() + offset, &args, sizeof(Args)), offset += sizeof(Args)), ...);
+      write(Id, Level, payload.data(), size);
+    }
+  }
+
+  /**
+   * @brief Starts the drain task; does nothing if already started
+   *
+   * Opens TELEMETRY_CONSTANTS::PATH when TO_SD is set and a card is in,
+   * otherwise prints formatted records to the terminal.
+   */
+  void start(uint32_t periodMs, uint32_t taskPriority);
+
+  /**
+   * @brief Copies out the oldest unread record (drain task only)
+   * @param payload At least MAX_PAYLOAD bytes
+   * @return false if there is none yet
+   */
+  bool pop(RecordHeader& header, uint8_t* payload);
+
+  /**
+   * @brief Ring counters
+   */
+  BinaryLogStats stats() const;
+
+private:
+  struct Slot {
+    /// Ticket + 1 once the record is complete, 0 while it is being written
+    std::atomic<uint32_t> sequence{0};
+    RecordHeader header;
+    std::array<uint8_t, MAX_PAYLOAD> payload{};
+  };
+
+  void write(RecordId id, LogLevel level, const uint8_t* payload, std::size_t size);
+  void drain(FILE* file);
+
+  std::array<Slot, CAPACITY> slots{};
+  std::atomic<uint32_t> head{0}; ///< Next ticket to hand out
+  uint32_t tail = 0;             ///< Next ticket to read; drain task only
+  std::atomic<uint32_t> drained{0};
+  std::atomic<uint32_t> dropped{0};
+  uint32_t reportedDrops = 0;
+  std::atomic<bool> started{false};
+};
+
+#endif // BINARY_LOG_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file record_format.hpp
+ * @brief Layout and catalogue of binary telemetry records
+ *
+ * A record is a fixed header (record id, level, payload size, timestamp)
+ * followed by the raw bytes of its arguments, copied in call order. The text
+ * lives here instead of in the record: each id has a name and a field list
+ * such as "x:f y:f theta:f", and a record is only turned into text when the
+ * drain task or the host decoder (tools/telemetry_decoder.cpp) gets round to
+ * it. The field list also types the arguments, and BinaryLog::log() checks
+ * them against it at compile time.
+ *
+ * Field types: f float, d double, i int32_t, u uint32_t, b bool.
+ *
+ * To add a record, append its id before COUNT and its entry at the same
+ * position in RECORD_FORMATS. Ids are written to the SD card, so never
+ * reorder or reuse them; bump FORMAT_VERSION if an existing field list
+ * changes.
+ *
+ * No PROS dependency, so the host decoder shares it.
+ */
+
+#ifndef RECORD_FORMAT_HPP
+#define RECORD_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @enum LogLevel
+ * @brief Severity; levels below TELEMETRY_CONSTANTS::MIN_LEVEL compile out
+ */
+enum class LogLevel : uint8_t { DEBUG = 0, INFO = 1, WARN = 2, ERROR = 3 };
+
+/**
+ * @enum RecordId
+ * @brief Every record the robot can log
+ */
+enum class RecordId : uint16_t {
+  DROPPED = 0,     ///< Written by the drain task when the ring overflowed
+  EKF_POSE,
+  MCL_CORRECTION,
+  COLOR_PIECE,
+  COLOR_EJECT,
+  VISION_FRAME,
+  COUNT
+};
+
+/**
+ * @struct RecordFormat
+ * @brief How to read a record's payload
+ */
+struct RecordFormat {
+  RecordId id;
+  const char* name;
+  const char* fields; ///< "name:type" pairs separated by spaces
+};
+
+inline constexpr RecordFormat RECORD_FORMATS[] = {
+    {RecordId::DROPPED, "dropped", "count:u"},
+    {RecordId::EKF_POSE, "ekf_pose", "x:f y:f theta:f"},
+    {RecordId::MCL_CORRECTION, "mcl_correction", "dx:f dy:f dtheta:f spread:f beams:u"},
+    {RecordId::COLOR_PIECE, "color_piece", "color:i latency_us:u eject:b"},
+    {RecordId::COLOR_EJECT, "color_eject", "velocity:f pending:u"},
+    {RecordId::VISION_FRAME, "vision_frame", "detections:i targets:u"},
+};
+
+/**
+ * @struct RecordHeader
+ * @brief Precedes every payload, in the ring and in the file
+ */
+struct RecordHeader {
+  uint16_t id = 0;
+  uint8_t level = 0;
+  uint8_t size = 0;         ///< Payload bytes that follow
+  uint32_t timestampUs = 0; ///< Low 32 bits of pros::micros(); wraps after 71 minutes
+};
+
+/**
+ * @struct FileHeader
+ * @brief Start of a binary telemetry file
+ */
+struct FileHeader {
+  char magic[4] = {'T', 'L', 'O', 'G'};
+  uint16_t version = 0;     ///< FORMAT_VERSION when written
+  uint16_t recordCount = 0; ///< RecordId::COUNT when written
+};
+
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr std::size_t MAX_PAYLOAD = 24;
+
+static_assert(sizeof(RecordHeader) == 8, "RecordHeader is written to the SD card as is");
+static_assert(sizeof(RECORD_FORMATS) / sizeof(RECORD_FORMATS[0]) == static_cast<std::size_t>(RecordId::COUNT),
+              "every RecordId needs a RECORD_FORMATS entry");
+
+/**
+ * @brief Whether RECORD_FORMATS is indexed by id
+ */
+constexpr bool formats_in_order() {
+  for (std::size_t i = 0; i < static_cast<std::size_t>(RecordId::COUNT); i++) {
+    if (static_cast<std::size_t>(RECORD_FORMATS[i].id) != i) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(formats_in_order(), "RECORD_FORMATS must list the ids in order");
+
+/**
+ * @brief Type code of a field list entry, 0 past the end
+ */
+constexpr char field_type(const char* fields, std::size_t index) {
+  for (; *fields != '\0'; fields++) {
+    if (*fields == ':' && index-- == 0) {
+      return fields[1];
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Number of fields in a field list
+ */
+constexpr std::size_t field_count(const char* fields) {
+  std::size_t count = 0;
+  for (; *fields != '\0'; fields++) {
+    count += *fields == ':';
+  }
+  return count;
+}
+
+/**
+ * @brief Type code a C++ argument is logged as, 0 if it cannot be
+ */
+template <typename T> constexpr char type_code() {
+  if constexpr (std::is_same_v<T, float>) {
+    return 'f';
+  } else if constexpr (std::is_same_v<T, double>) {
+    return 'd';
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return 'i';
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return 'u';
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return 'b';
+  } else {
+    return 0;
+  }
+}
+
+/**
+ * @brief Whether an argument list matches a record's field list
+ */
+template <typename... Args> constexpr bool fields_match(const char* fields) {
+  std::size_t index = 0;
+  return field_count(fields) == sizeof...(Args) && ((field_type(fields, index++) == type_code<Args>()) && ...);
+}
+
+/**
+ * @brief Name of a level
+ */
+const char* level_name(uint8_t level);
+
+/**
+ * @brief Formats a record as one line of text, without a newline
+ *
+ * "  12.345 INFO  ekf_pose x=1.000 y=2.000 theta=90.000". Unknown ids and
+ * payloads shorter than their field list are formatted as such rather than
+ * read past.
+ *
+ * @return Characters written, as snprintf
+ */
+int format_record(const RecordHeader& header, const uint8_t* payload, char* out, std::size_t outSize);
+
+#endif // RECORD_FORMAT_HPP
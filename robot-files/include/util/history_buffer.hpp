@@ -0,0 +1,96 @@
+/**
+ * @file history_buffer.hpp
+ * @brief Single-writer, multi-reader ring of the last N published values
+ *
+ * SnapshotBuffer keeps only the newest value; HistoryBuffer keeps the newest
+ * N so readers can look back in time. Each slot carries its own sequence, as
+ * in SnapshotBuffer. A reader never waits on a slot: one being written (the
+ * reader preempted the writer) or rewritten since the reader started (the
+ * writer lapped a slow reader) simply counts as gone, which on the
+ * single-core brain is the only safe answer.
+ */
+
+#ifndef HISTORY_BUFFER_HPP
+#define HISTORY_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class HistoryBuffer
+ * @brief Publishes copies of T and keeps the last N of them readable
+ *
+ * Exactly one task may call publish(). read() never blocks and never takes a
+ * lock. T must be trivially copyable.
+ */
+template <typename T, std::size_t N> class HistoryBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "HistoryBuffer requires a trivially copyable type");
+  static_assert(N >= 2, "HistoryBuffer needs room for at least two values");
+
+public:
+  static constexpr std::size_t CAPACITY = N;
+
+  /**
+   * @brief Publishes a new value, overwriting the oldest (single writer only)
+   */
+  void publish(const T& value) {
+    const uint32_t index = publishCount.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % N];
+
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.index = index;
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    publishCount.store(index + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies out a recent value
+   * @param age 0 for the newest value, 1 for the one before, ...
+   * @param out Receives the value; untouched on failure
+   * @return false if that value was never published or has been overwritten
+   */
+  bool read(std::size_t age, T& out) const {
+    const uint32_t count = publishCount.load(std::memory_order_acquire);
+    if (age >= N || age >= count) {
+      return false;
+    }
+    const uint32_t index = count - 1 - static_cast<uint32_t>(age);
+    const Slot& slot = slots[index % N];
+
+    const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before & 1u) {
+      return false;
+    }
+    T copy = slot.value;
+    const uint32_t slotIndex = slot.index;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != before || slotIndex != index) {
+      return false;
+    }
+    out = copy;
+    return true;
+  }
+
+  /**
+   * @brief Number of values published so far
+   */
+  uint32_t count() const { return publishCount.load(std::memory_order_acquire); }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence{0};
+    uint32_t index = 0; ///< Which publish the value came from
+    T value{};
+  };
+
+  std::array<Slot, N> slots;
+  std::atomic<uint32_t> publishCount{0};
+};
+
+#endif // HISTORY_BUFFER_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file snapshot_buffer.hpp
+ * @brief Single-writer, multi-reader seqlocked double buffer
+ *
+ * A plain seqlock is unsafe on the single-core V5 brain: a high-priority
+ * reader that interrupts the writer mid-update spins forever, because the
+ * writer can never run to finish. Here the writer always fills the slot that
+ * is NOT published and then flips the published index, so the published slot
+ * is never mid-write while a reader could be preempting the writer. The
+ * per-slot sequence only catches the opposite case (the writer preempted a
+ * slow reader and came back around to its slot), which a retry resolves
+ * immediately.
+ */
+
+#ifndef SNAPSHOT_BUFFER_HPP
+#define SNAPSHOT_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class SnapshotBuffer
+ * @brief Publishes immutable copies of T to any number of readers
+ *
+ * Exactly one task may call publish(). read() never blocks and never takes a
+ * lock. T must be trivially copyable.
+ */
+template <typename T> class SnapshotBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "SnapshotBuffer requires a trivially copyable type");
+
+public:
+  /**
+   * @brief Publishes a new value (single writer only)
+   */
+  void publish(const T& value) {
+    const uint32_t target = published.load(std::memory_order_relaxed) ^ 1u;
+    Slot& slot = slots[target];
+
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    published.store(target, std::memory_order_release);
+    publishCount.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Copies out the most recently published value
+   */
+  T read() const {
+    while (true) {
+      const Slot& slot = slots[published.load(std::memory_order_acquire)];
+      const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before & 1u) {
+        continue;
+      }
+      T copy = slot.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before) {
+        return copy;
+      }
+    }
+  }
+
+  /**
+   * @brief Number of values published so far (0 means read() returns a default T)
+   */
+  uint32_t count() const { return publishCount.load(std::memory_order_acquire); }
+
+private:
+  struct Slot {
+    std::atomic<uint32_t> sequence{0};
+    T value{};
+  };
+
+  std::array<Slot, 2> slots;
+  std::atomic<uint32_t> published{0};
+  std::atomic<uint32_t> publishCount{0};
+};
+
+#endif // SNAPSHOT_BUFFER_HPP
@@ -0,0 +1,94 @@
+/**
+ * @file piece_tracker.hpp
+ * @brief Fixed-capacity tracker associating game piece detections across frames
+ *
+ * Each camera frame gives a handful of detections with no identity. The
+ * tracker keeps them in the field frame (the pipeline projects them through
+ * the pose at the frame's capture time), so a piece stays put while the
+ * robot turns, and pairs each frame's detections with the existing tracks
+ * by global nearest neighbour within a gate. A track is only reported once
+ * it has been seen a few times, and is dropped when it has not been seen
+ * for a while.
+ *
+ * Fixed arrays, no allocation and no PROS dependency.
+ */
+
+#ifndef PIECE_TRACKER_HPP
+#define PIECE_TRACKER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct PieceObservation
+ * @brief One detection, projected onto the field
+ */
+struct PieceObservation {
+  float x = 0; ///< Field frame (inches)
+  float y = 0;
+};
+
+/**
+ * @struct PieceTrack
+ * @brief A piece followed across frames
+ */
+struct PieceTrack {
+  uint32_t id = 0;          ///< Unique per track; 0 = empty slot
+  float x = 0;              ///< Smoothed field position (inches)
+  float y = 0;
+  uint32_t hits = 0;        ///< Frames it was matched in
+  uint64_t lastSeenUs = 0;
+};
+
+/**
+ * @struct PieceTrackerConfig
+ * @brief Association and lifetime settings
+ */
+struct PieceTrackerConfig {
+  float gate = 6;            ///< Furthest a detection may be from a track to continue it (inches)
+  float smoothing = 0.5f;    ///< Share of each matched detection blended into the track
+  uint32_t confirmHits = 3;  ///< Frames before a track is reported
+  uint32_t timeoutUs = 500000; ///< Unseen this long, a track is dropped
+};
+
+/**
+ * @class PieceTracker
+ * @brief The tracks and their association
+ */
+class PieceTracker {
+public:
+  static constexpr std::size_t MAX_TRACKS = 8;
+  static constexpr std::size_t MAX_OBSERVATIONS = 8;
+
+  explicit PieceTracker(PieceTrackerConfig config)
+      : config(config) {}
+
+  /**
+   * @brief Folds in one frame's detections (at most MAX_OBSERVATIONS are used)
+   * @param timeUs Capture time of the frame
+   */
+  void update(const PieceObservation* observations, std::size_t count, uint64_t timeUs);
+
+  /**
+   * @brief Whether a track has been seen often enough to report
+   */
+  bool confirmed(const PieceTrack& track) const { return track.id != 0 && track.hits >= config.confirmHits; }
+
+  /**
+   * @brief All slots; empty ones have id 0
+   */
+  const std::array<PieceTrack, MAX_TRACKS>& tracks() const { return slots; }
+
+  /**
+   * @brief Forgets every track
+   */
+  void clear() { slots = {}; }
+
+private:
+  PieceTrackerConfig config;
+  std::array<PieceTrack, MAX_TRACKS> slots{};
+  uint32_t nextId = 1;
+};
+
+#endif // PIECE_TRACKER_HPP
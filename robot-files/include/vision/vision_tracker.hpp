@@ -0,0 +1,140 @@
+/**
+ * @file vision_tracker.hpp
+ * @brief Background task turning AI Vision detections into tracked game pieces
+ *
+ * Every period the task reads the AI Vision sensor's detections (color
+ * descriptors or AI model objects), keeps the ones whose id is in the
+ * configured mask and projects each onto the field. The bearing comes from
+ * the box's horizontal centre, the range from its width against the
+ * piece's known width. The projection uses the pose at the frame's capture
+ * time, taken from the PoseChannel history, so a robot turning while the
+ * frame was in flight does not smear the piece sideways. A PieceTracker
+ * associates the detections across frames, and the confirmed tracks are
+ * published with their range and bearing.
+ *
+ * Readers (the aim assist and drive_to_nearest_piece) recompute the bearing
+ * from the current pose, so a target stays usable between frames and
+ * briefly out of view.
+ */
+
+#ifndef VISION_TRACKER_HPP
+#define VISION_TRACKER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "odometry/pose_channel.hpp"
+#include "pros/ai_vision.hpp"
+#include "scheduler/loop_timer.hpp"
+#include "util/snapshot_buffer.hpp"
+#include "vision/piece_tracker.hpp"
+
+/**
+ * @struct CameraConfig
+ * @brief Where the camera sits and what it looks for
+ */
+struct CameraConfig {
+  float x = 0;                ///< Mount on the robot (inches right of the tracking centre)
+  float y = 0;                ///< Inches forward
+  float angle = 0;            ///< Degrees clockwise from the robot's forward direction
+  float horizontalFov = 74;   ///< Degrees
+  float imageWidth = 320;     ///< Pixels
+  float pieceWidth = 0;       ///< Real width of a game piece (inches)
+  float minWidthPx = 0;       ///< Narrower boxes are too far or too clipped to range
+  uint32_t idMask = 0;        ///< Bit n accepts detections with id n
+  bool aiModel = false;       ///< Use AI model objects instead of color descriptors
+  uint32_t frameLatencyUs = 0; ///< Capture to readable, for looking up the capture pose
+};
+
+/**
+ * @struct VisionTarget
+ * @brief A confirmed piece
+ */
+struct VisionTarget {
+  uint32_t id = 0;   ///< Track id; stable while the piece is tracked
+  float x = 0;       ///< Field position (inches)
+  float y = 0;
+  float range = 0;   ///< From the robot at the frame's capture time (inches)
+  float bearing = 0; ///< Degrees clockwise from the robot's heading, at capture time
+};
+
+/**
+ * @struct VisionTargets
+ * @brief Every confirmed piece from one frame
+ */
+struct VisionTargets {
+  std::array<VisionTarget, PieceTracker::MAX_TRACKS> targets{};
+  uint32_t count = 0;
+  uint64_t timestampUs = 0; ///< Capture time
+  uint32_t sequence = 0;    ///< Increments with every frame; 0 = none yet
+};
+
+/**
+ * @brief Robot-frame point of a detection
+ * @param centerPx Horizontal centre of the box (pixels from the left edge)
+ * @param widthPx Box width (pixels)
+ * @return false if the box is too narrow to range
+ */
+bool project_detection(const CameraConfig& config, float centerPx, float widthPx, float& right, float& forward);
+
+/**
+ * @brief Field position of a robot-frame point
+ */
+PieceObservation to_field(const PoseSample& pose, float right, float forward);
+
+/**
+ * @brief Bearing of a field point from a pose, degrees clockwise from its heading in [-180, 180)
+ */
+float bearing_to(const PoseSample& pose, float x, float y);
+
+/**
+ * @class VisionTracker
+ * @brief Owns the tracker and its task
+ */
+class VisionTracker {
+public:
+  /**
+   * @brief Constructor
+   * @param poses Odometry output the detections are projected with
+   * @param camera The AI Vision sensor
+   */
+  VisionTracker(const PoseChannel& poses, pros::AIVision& camera, CameraConfig config,
+                PieceTrackerConfig trackerConfig);
+
+  /**
+   * @brief Enables the configured detection type and starts the task; does nothing if already started
+   */
+  void start(uint32_t periodMs, uint32_t taskPriority);
+
+  /**
+   * @brief Latest confirmed pieces; never blocks
+   */
+  VisionTargets targets() const;
+
+  /**
+   * @brief Closest confirmed piece within maxBearing of the heading of a pose
+   * @return false if there is none
+   */
+  bool nearest(const PoseSample& pose, float maxBearing, VisionTarget& target) const;
+
+  /**
+   * @brief Task timing statistics
+   */
+  LoopStats loop_stats() const;
+
+private:
+  void step();
+
+  const PoseChannel& poses;
+  pros::AIVision& camera;
+  CameraConfig config;
+  PieceTracker tracker;
+  uint32_t sequence = 0;
+
+  SnapshotBuffer<VisionTargets> published;
+  LoopTimer loop;
+  std::atomic<bool> started{false};
+};
+
+#endif // VISION_TRACKER_HPP
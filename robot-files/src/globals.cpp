@@ -26,6 +26,20 @@ namespace globals {
  */
 pros::Controller controller(pros::E_CONTROLLER_MASTER);
 
+/**
+ * @brief Input hub instantiation
+ *
+ * Must be defined after controller, which it holds a reference to.
+ */
+InputHub input(controller);
+
+/**
+ * @brief Binary telemetry instantiation
+ *
+ * Constant-initialized, so it can be logged to before initialize() runs.
+ */
+BinaryLog telemetry;
+
 /**
  * @brief Default alliance color
  *
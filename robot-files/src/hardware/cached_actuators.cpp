@@ -0,0 +1,24 @@
+#include "hardware/cached_actuators.hpp"
+
+bool CommandCache::should_write(uint8_t mode, int32_t value, uint32_t nowMs) {
+    const bool changed = !valid || mode != lastMode || value != lastValue;
+    const bool stale = keepAliveMs != 0 && nowMs - lastWriteMs >= keepAliveMs;
+    if (!changed && !stale) {
+        writeStats.avoided++;
+        return false;
+    }
+
+    valid = true;
+    lastMode = mode;
+    lastValue = value;
+    lastWriteMs = nowMs;
+    writeStats.issued++;
+    return true;
+}
+
+void CommandCache::assume(uint8_t mode, int32_t value, uint32_t nowMs) {
+    valid = true;
+    lastMode = mode;
+    lastValue = value;
+    lastWriteMs = nowMs;
+}
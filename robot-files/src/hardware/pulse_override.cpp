@@ -0,0 +1,28 @@
+#include "hardware/pulse_override.hpp"
+
+#include <mutex>
+
+void PulseOverride::move(int32_t voltage) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    commanded = voltage;
+    if (!held) {
+        output.move(voltage);
+    }
+}
+
+void PulseOverride::begin(int32_t voltage) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    held = true;
+    output.device().move(voltage);
+}
+
+void PulseOverride::end() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (!held) {
+        return;
+    }
+    held = false;
+    // The pulse wrote behind the cache's back
+    output.invalidate();
+    output.move(commanded);
+}
@@ -0,0 +1,178 @@
+#include "hardware/sensor_hub.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "constants.hpp"
+#include "pros/error.h"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace {
+constexpr double INCHES_PER_METER = 39.3701;
+
+/**
+ * @brief Updates connection and staleness from the outcome of one read
+ * @param ok The read returned valid data
+ * @param fresh The data is new since the last cycle
+ */
+void update_health(DeviceHealth& health, bool ok, bool fresh, uint32_t nowMs) {
+    health.present = true;
+    health.connected = ok;
+    if (ok && fresh) {
+        health.lastGoodMs = nowMs;
+    }
+    health.stale = nowMs - health.lastGoodMs > static_cast<uint32_t>(SENSOR_HUB_CONSTANTS::STALE_TIMEOUT_MS);
+}
+} // namespace
+
+SensorHub::SensorHub(pros::MotorGroup* leftDrive, pros::MotorGroup* rightDrive, pros::Rotation* verticalRotation,
+                     pros::Rotation* horizontalRotation, pros::Imu* imu, pros::Imu* imu2, pros::Gps* gps)
+    : leftDrive(leftDrive),
+      rightDrive(rightDrive),
+      verticalRotation(verticalRotation),
+      horizontalRotation(horizontalRotation),
+      imus{imu, imu2},
+      gps(gps),
+      loop(SENSOR_HUB_CONSTANTS::PERIOD_MS),
+      started(false) {}
+
+void SensorHub::start(uint32_t periodMs, uint32_t taskPriority) {
+    if (started.exchange(true)) {
+        return;
+    }
+    pros::Task::create(
+        [this, periodMs] {
+            loop = LoopTimer(periodMs);
+            loop.start();
+            while (true) {
+                sample();
+                loop.wait();
+            }
+        },
+        taskPriority, TASK_STACK_DEPTH_DEFAULT, "sensor hub");
+}
+
+void SensorHub::sample() {
+    const uint64_t startUs = pros::micros();
+    const uint32_t nowMs = pros::millis();
+
+    working.cycle++;
+    working.timestampUs = startUs;
+    read_motor_group(leftDrive, working.leftDrive, nowMs);
+    read_motor_group(rightDrive, working.rightDrive, nowMs);
+    read_rotation(verticalRotation, working.verticalRotation, nowMs);
+    read_rotation(horizontalRotation, working.horizontalRotation, nowMs);
+    for (std::size_t i = 0; i < imus.size(); i++) {
+        read_imu(imus[i], working.imu[i], nowMs);
+    }
+    read_gps(gps, working.gps, nowMs);
+    read_battery(working.battery, nowMs);
+    working.readTimeUs = static_cast<uint32_t>(pros::micros() - startUs);
+
+    published.publish(working);
+}
+
+SensorSnapshot SensorHub::snapshot() const { return published.read(); }
+
+LoopStats SensorHub::loop_stats() const { return loop.stats(); }
+
+void SensorHub::read_motor_group(pros::MotorGroup* group, MotorGroupSample& sample, uint32_t nowMs) {
+    if (group == nullptr) {
+        return;
+    }
+
+    // One batched call per quantity instead of one call per motor per consumer
+    uint32_t timestamp = 0;
+    const std::vector<std::int32_t> raw = group->get_raw_position_all(&timestamp);
+    const std::vector<double> position = group->get_position_all();
+    const std::vector<double> velocity = group->get_actual_velocity_all();
+    const std::vector<std::int32_t> current = group->get_current_draw_all();
+    const std::vector<double> temperature = group->get_temperature_all();
+
+    const std::size_t count = std::min<std::size_t>(raw.size(), MotorGroupSample::MAX_MOTORS);
+    bool ok = count > 0;
+    for (std::size_t i = 0; i < count; i++) {
+        sample.rawPosition[i] = raw[i];
+        sample.position[i] = i < position.size() ? position[i] : PROS_ERR_F;
+        sample.velocity[i] = i < velocity.size() ? velocity[i] : PROS_ERR_F;
+        sample.currentMa[i] = i < current.size() ? current[i] : PROS_ERR;
+        sample.temperatureC[i] = i < temperature.size() ? temperature[i] : PROS_ERR_F;
+        ok = ok && raw[i] != PROS_ERR && std::isfinite(sample.position[i]);
+    }
+
+    // The motor only advances its timestamp when it has new data for us
+    const bool fresh = timestamp != sample.deviceTimestampMs;
+    sample.count = static_cast<uint8_t>(count);
+    sample.deviceTimestampMs = timestamp;
+    update_health(sample.health, ok, fresh, nowMs);
+}
+
+void SensorHub::read_rotation(pros::Rotation* sensor, RotationSample& sample, uint32_t nowMs) {
+    if (sensor == nullptr) {
+        return;
+    }
+
+    const int32_t position = sensor->get_position();
+    const uint64_t readUs = pros::micros();
+    const int32_t velocity = sensor->get_velocity();
+    const bool ok = position != PROS_ERR && velocity != PROS_ERR;
+    if (ok) {
+        sample.positionCdeg = position;
+        sample.readUs = readUs;
+        sample.velocityCdps = velocity;
+    }
+    update_health(sample.health, ok, ok, nowMs);
+}
+
+void SensorHub::read_imu(pros::Imu* sensor, ImuSample& sample, uint32_t nowMs) {
+    if (sensor == nullptr) {
+        return;
+    }
+
+    const double rotation = sensor->get_rotation();
+    const double heading = sensor->get_heading();
+    const pros::imu_gyro_s_t gyro = sensor->get_gyro_rate();
+    const bool ok = std::isfinite(rotation) && std::isfinite(heading) && std::isfinite(gyro.z);
+    if (ok) {
+        sample.rotationDeg = rotation;
+        sample.headingDeg = heading;
+        sample.gyroZDps = gyro.z;
+    }
+    update_health(sample.health, ok, ok, nowMs);
+}
+
+void SensorHub::read_gps(pros::Gps* sensor, GpsSample& sample, uint32_t nowMs) {
+    if (sensor == nullptr) {
+        return;
+    }
+
+    const pros::gps_status_s_t status = sensor->get_position_and_orientation();
+    const double error = sensor->get_error();
+    const bool ok = std::isfinite(status.x) && std::isfinite(status.y) && std::isfinite(status.yaw) &&
+                    status.x != PROS_ERR_F && error != PROS_ERR_F;
+    if (ok) {
+        sample.x = status.x * INCHES_PER_METER;
+        sample.y = status.y * INCHES_PER_METER;
+        sample.headingDeg = sensor->get_heading();
+        sample.errorIn = error * INCHES_PER_METER;
+    }
+    update_health(sample.health, ok, ok, nowMs);
+}
+
+void SensorHub::read_battery(BatterySample& sample, uint32_t nowMs) {
+    const int32_t voltage = pros::battery::get_voltage();
+    const int32_t current = pros::battery::get_current();
+    const bool ok = voltage != PROS_ERR && voltage > 0;
+    if (ok) {
+        if (sample.filteredMv <= 0) {
+            sample.filteredMv = voltage;
+        } else {
+            sample.filteredMv += SENSOR_HUB_CONSTANTS::BATTERY_FILTER_ALPHA * (voltage - sample.filteredMv);
+        }
+        sample.voltageMv = voltage;
+        sample.currentMa = current;
+    }
+    update_health(sample.health, ok, ok, nowMs);
+}
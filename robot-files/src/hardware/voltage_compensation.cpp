@@ -0,0 +1,49 @@
+#include "hardware/voltage_compensation.hpp"
+
+#include "constants.hpp"
+
+// Compile-time table of expected scaling: a change to the compensation math
+// or the constants that breaks any row fails the build
+namespace {
+struct ScalingCase {
+    float batteryMv;
+    float left;
+    float right;
+    float expectedLeft;
+    float expectedRight;
+};
+
+constexpr ScalingCase SCALING_TABLE[] = {
+    {12000, 100, 100, 100.000f, 100.000f},    // nominal: unchanged
+    {12800, 100, 50, 93.750f, 46.875f},       // fresh battery: scaled down
+    {11500, 100, -100, 104.348f, -104.348f},  // tired battery: scaled up
+    {11000, 127, 127, 127.000f, 127.000f},    // cannot exceed full scale
+    {11000, 127, 63.5f, 127.000f, 63.500f},   // one side saturating shrinks both, keeping the turn
+    {12000, -150, 50, -127.000f, 42.333f},    // saturating at nominal too
+    {13000, -64, 32, -59.077f, 29.538f},      // sign preserved
+    {8000, 50, -25, 66.667f, -33.333f},       // readings below the floor are treated as the floor (9 V)
+    {0, 80, -80, 80.000f, -80.000f},          // unknown voltage: unchanged
+};
+
+constexpr bool close(float a, float b) { return a - b < 0.01f && b - a < 0.01f; }
+
+constexpr bool scaling_table_holds() {
+    for (const ScalingCase& row : SCALING_TABLE) {
+        const float scale = battery_scale(row.batteryMv, VOLTAGE_COMPENSATION_CONSTANTS::NOMINAL_MV,
+                                          VOLTAGE_COMPENSATION_CONSTANTS::MIN_MV);
+        const CompensatedSides sides = compensate_sides(row.left, row.right, scale);
+        if (!close(sides.left, row.expectedLeft) || !close(sides.right, row.expectedRight)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(scaling_table_holds(), "battery compensation no longer matches the expected scaling table");
+
+constexpr GainSchedule<3> TEST_SCHEDULE = {{0, 10, 30}, {1.2f, 1.0f, 0.5f}};
+static_assert(close(TEST_SCHEDULE.at(0), 1.2f), "schedule start");
+static_assert(close(TEST_SCHEDULE.at(5), 1.1f), "schedule interpolates");
+static_assert(close(TEST_SCHEDULE.at(-20), 0.75f), "schedule ignores sign");
+static_assert(close(TEST_SCHEDULE.at(100), 0.5f), "schedule holds past the last breakpoint");
+} // namespace
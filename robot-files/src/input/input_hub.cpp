@@ -0,0 +1,56 @@
+#include "input/input_hub.hpp"
+
+#include "pros/rtos.hpp"
+
+InputHub::InputHub(pros::Controller& controller)
+    : controller(controller) {}
+
+int InputHub::subscribe() {
+    std::size_t id = readerCount.load();
+    while (id < MAX_READERS && !readerCount.compare_exchange_weak(id, id + 1)) {
+    }
+    return id < MAX_READERS ? static_cast<int>(id) : -1;
+}
+
+void InputHub::poll() {
+    uint16_t held = 0;
+    for (int i = 0; i < InputFrame::BUTTON_COUNT; i++) {
+        const auto button = static_cast<pros::controller_digital_e_t>(InputFrame::FIRST_BUTTON + i);
+        if (controller.get_digital(button)) {
+            held |= InputFrame::mask(button);
+        }
+    }
+
+    std::array<int8_t, InputFrame::AXIS_COUNT> axes;
+    for (int i = 0; i < InputFrame::AXIS_COUNT; i++) {
+        axes[i] = static_cast<int8_t>(controller.get_analog(static_cast<pros::controller_analog_e_t>(i)));
+    }
+
+    current = InputFrame::next(current, held, axes, pros::millis());
+    // Latch the edges before publishing, so a reader that sees this frame also sees its edges
+    const std::size_t readers = readerCount.load();
+    for (std::size_t i = 0; i < readers; i++) {
+        pendingPressed[i].fetch_or(current.pressed);
+        pendingReleased[i].fetch_or(current.released);
+    }
+    frames.publish(current);
+}
+
+InputFrame InputHub::latest() { return frames.read(); }
+
+InputFrame InputHub::read(int reader) {
+    // Take the edges first: the frame read after them is at least as new
+    uint16_t pressed = 0;
+    uint16_t released = 0;
+    const bool subscribed = reader >= 0 && static_cast<std::size_t>(reader) < readerCount.load();
+    if (subscribed) {
+        pressed = pendingPressed[reader].exchange(0);
+        released = pendingReleased[reader].exchange(0);
+    }
+    InputFrame frame = frames.read();
+    if (subscribed) {
+        frame.pressed = pressed;
+        frame.released = released;
+    }
+    return frame;
+}
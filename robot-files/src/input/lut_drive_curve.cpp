@@ -0,0 +1,21 @@
+#include "input/lut_drive_curve.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+LutDriveCurve::LutDriveCurve(float deadband, float minOutput, float curve) {
+    // Sample the reference curve once so the table matches it exactly
+    lemlib::ExpoDriveCurve reference(deadband, minOutput, curve);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        table[i] = reference.curve(static_cast<float>(i - INPUT_LIMIT));
+    }
+}
+
+int LutDriveCurve::lookup(int input) const {
+    return static_cast<int>(table[std::clamp(input, -INPUT_LIMIT, INPUT_LIMIT) + INPUT_LIMIT]);
+}
+
+float LutDriveCurve::curve(float input) {
+    const int index = static_cast<int>(std::lround(std::clamp(input, -127.0f, 127.0f)));
+    return table[index + INPUT_LIMIT];
+}
@@ -1,10 +1,13 @@
 #include "main.h"
 #include "lemlib/api.hpp" // IWYU pragma: keep
+#include "globals.hpp"
 #include "subsystems/drivetrain.hpp"
 #include "subsystems/wing.hpp"
 #include "subsystems/lil_will.hpp"
 #include "subsystems/endeffector.hpp"
 #include "subsystems/intake.hpp"
+#include "subsystems/color_sort.hpp"
+#include "scheduler/scheduler_task.hpp"
 
 
 Drivetrain drivetrain;
@@ -12,6 +15,43 @@ Intake intake;
 
 EndEffector endeffector;
 LilWill lilwill;
+ColorSort colorsort(intake, endeffector);
+
+// Each lane runs on its own task, never on the competition tasks PROS deletes on
+// disable; mechanisms get a lower priority so slow mechanism work can never delay the drive
+SchedulerTask driveLane("drive lane", TASK_PRIORITY_DEFAULT);
+SchedulerTask mechanismLane("mechanism lane", TASK_PRIORITY_DEFAULT - 1);
+
+/**
+ * Registers every operator-control subsystem on its lane with its period and
+ * priority from SCHEDULER_CONSTANTS.
+ */
+void register_subsystems() {
+  // The controller is read exactly once per drive tick; everything else reads frames
+  driveLane.add("input", SCHEDULER_CONSTANTS::INPUT_PERIOD_MS,
+                SCHEDULER_CONSTANTS::INPUT_PRIORITY, [] { globals::input.poll(); });
+  driveLane.add("drivetrain", SCHEDULER_CONSTANTS::DRIVETRAIN_PERIOD_MS,
+                SCHEDULER_CONSTANTS::DRIVETRAIN_PRIORITY, [] { drivetrain.run(globals::input.latest()); });
+
+  // Slower subsystems latch edges per reader so no button press is missed between ticks
+  const int intakeReader = globals::input.subscribe();
+  const int endeffectorReader = globals::input.subscribe();
+  const int lilwillReader = globals::input.subscribe();
+
+  mechanismLane.add("intake", SCHEDULER_CONSTANTS::INTAKE_PERIOD_MS,
+                    SCHEDULER_CONSTANTS::INTAKE_PRIORITY,
+                    [intakeReader] { intake.run(globals::input.read(intakeReader)); });
+  mechanismLane.add("endeffector", SCHEDULER_CONSTANTS::ENDEFFECTOR_PERIOD_MS,
+                    SCHEDULER_CONSTANTS::ENDEFFECTOR_PRIORITY,
+                    [endeffectorReader] { endeffector.run(globals::input.read(endeffectorReader)); });
+  mechanismLane.add("lilwill", SCHEDULER_CONSTANTS::PNEUMATICS_PERIOD_MS,
+                    SCHEDULER_CONSTANTS::PNEUMATICS_PRIORITY,
+                    [lilwillReader] { lilwill.run(globals::input.read(lilwillReader)); });
+  // const int wingReader = globals::input.subscribe();
+  // mechanismLane.add("wing", SCHEDULER_CONSTANTS::PNEUMATICS_PERIOD_MS,
+  //                   SCHEDULER_CONSTANTS::PNEUMATICS_PRIORITY,
+  //                   [wingReader] { wing.run(globals::input.read(wingReader)); });
+}
 
 /**
  * A callback function for LLEMU's center button.
@@ -40,7 +80,16 @@ void initialize() {
   pros::lcd::set_text(1, "Hello PROS User!");
 
   pros::lcd::register_btn1_cb(on_center_button);
+  // Lowest useful priority: records wait in the ring until every control task is idle
+  globals::telemetry.start(TELEMETRY_CONSTANTS::DRAIN_PERIOD_MS, TASK_PRIORITY_MIN + 1);
   drivetrain.init();
+  register_subsystems();
+
+  // Sorts in autonomous and opcontrol alike, on its own task
+  if (PORT_VALUES::COLOR_SORT_OPTICAL != 0) {
+    colorsort.start(COLOR_SORT_CONSTANTS::PERIOD_MS,
+                    TASK_PRIORITY_DEFAULT + COLOR_SORT_CONSTANTS::TASK_PRIORITY_OFFSET);
+  }
 }
 
 /**
@@ -48,7 +97,10 @@ void initialize() {
  * the VEX Competition Switch, following either autonomous or opcontrol. When
  * the robot is enabled, this task will exit.
  */
-void disabled() {}
+void disabled() {
+  driveLane.stop();
+  mechanismLane.stop();
+}
 
 /**
  * Runs after initialize(), and before autonomous when connected to the Field
@@ -73,6 +125,25 @@ void competition_initialize() {}
  * from where it left off.
  */
 void autonomous() {
+  driveLane.stop();
+  mechanismLane.stop();
+
+  if (CHARACTERIZATION_CONSTANTS::RUN_IN_AUTONOMOUS) {
+    drivetrain.characterize();
+    return;
+  }
+  if (AUTOTUNE_CONSTANTS::RUN_IN_AUTONOMOUS) {
+    drivetrain.autotune();
+    return;
+  }
+  if (LATENCY_CONSTANTS::RUN_IN_AUTONOMOUS) {
+    drivetrain.measure_output_latency();
+    return;
+  }
+  if (TRACKING_CALIBRATION_CONSTANTS::RUN_IN_AUTONOMOUS) {
+    drivetrain.calibrate_tracking_wheels();
+    return;
+  }
 
 // intake.spin();
 // drivetrain.leftMotorGroup.move(127);
@@ -97,15 +168,12 @@ void autonomous() {
  * task, not resume it from where it left off.
  */
 void opcontrol() {
+  // LemLib may have driven the motors during autonomous; resync the caches
+  drivetrain.invalidate_output_cache();
+  driveLane.start();
+  mechanismLane.start();
+  // The lanes do the work; disabled() and autonomous() stop them
   while (true) {
-    // Run drivetrain subsystem
-    drivetrain.run();
-    intake.run();
-    lilwill.run();
-    endeffector.run();
-    // wing.run();
-    
-    // Small delay to prevent CPU overuse
-    pros::delay(10);
+    pros::delay(100);
   }
 }
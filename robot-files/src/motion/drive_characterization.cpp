@@ -0,0 +1,124 @@
+#include "motion/drive_characterization.hpp"
+
+#include <cstdio>
+
+#include "hardware/drive_units.hpp"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace {
+float mean_velocity(const MotorGroupSample& sample) {
+    if (sample.count == 0) {
+        return 0;
+    }
+    double total = 0;
+    for (size_t i = 0; i < sample.count; i++) {
+        total += sample.velocity[i];
+    }
+    return static_cast<float>(total / sample.count);
+}
+
+/**
+ * @brief Central difference of velocity within one test (one-sided at its ends)
+ */
+float acceleration(const CharacterizationSample* samples, size_t count, size_t i, bool left) {
+    const size_t before = i > 0 && samples[i - 1].test == samples[i].test ? i - 1 : i;
+    const size_t after = i + 1 < count && samples[i + 1].test == samples[i].test ? i + 1 : i;
+    if (before == after) {
+        return 0;
+    }
+    const float dt = (samples[after].timestampUs - samples[before].timestampUs) / 1e6f;
+    if (dt <= 0) {
+        return 0;
+    }
+    const float dv = left ? samples[after].leftVelocity - samples[before].leftVelocity
+                          : samples[after].rightVelocity - samples[before].rightVelocity;
+    return dv / dt;
+}
+} // namespace
+
+DriveCharacterization::DriveCharacterization(pros::MotorGroup& left, pros::MotorGroup& right,
+                                             const SensorHub& sensorHub, float wheelDiameter, float wheelRpm)
+    : left(left),
+      right(right),
+      sensorHub(sensorHub),
+      wheelDiameter(wheelDiameter),
+      wheelRpm(wheelRpm) {}
+
+void DriveCharacterization::command(int32_t millivolts) {
+    left.move_voltage(millivolts);
+    right.move_voltage(millivolts);
+}
+
+void DriveCharacterization::record(CharacterizationTest test, float volts) {
+    const SensorSnapshot snapshot = sensorHub.snapshot();
+    if (count >= MAX_SAMPLES || snapshot.cycle == lastCycle) {
+        return;
+    }
+    lastCycle = snapshot.cycle;
+
+    const float scale = inches_per_second_per_rpm(wheelDiameter, wheelRpm, left.get_gearing());
+    CharacterizationSample& sample = samples[count++];
+    sample.test = test;
+    sample.timestampUs = snapshot.timestampUs;
+    sample.leftVolts = volts;
+    sample.rightVolts = volts;
+    sample.leftVelocity = mean_velocity(snapshot.leftDrive) * scale;
+    sample.rightVelocity = mean_velocity(snapshot.rightDrive) * scale;
+}
+
+void DriveCharacterization::run_quasistatic(bool forwards, float voltsPerSecond, uint32_t durationMs,
+                                            uint32_t samplePeriodMs) {
+    const CharacterizationTest test =
+        forwards ? CharacterizationTest::QUASISTATIC_FORWARD : CharacterizationTest::QUASISTATIC_REVERSE;
+    const float sign = forwards ? 1 : -1;
+
+    const uint32_t startMs = pros::millis();
+    uint32_t wakeMs = startMs;
+    while (pros::millis() - startMs < durationMs) {
+        const float volts = sign * voltsPerSecond * (pros::millis() - startMs) / 1000.0f;
+        command(static_cast<int32_t>(volts * 1000));
+        record(test, volts);
+        pros::Task::delay_until(&wakeMs, samplePeriodMs);
+    }
+    command(0);
+}
+
+void DriveCharacterization::run_step(bool forwards, float volts, uint32_t durationMs, uint32_t samplePeriodMs) {
+    const CharacterizationTest test = forwards ? CharacterizationTest::STEP_FORWARD : CharacterizationTest::STEP_REVERSE;
+    const float applied = forwards ? volts : -volts;
+
+    const uint32_t startMs = pros::millis();
+    uint32_t wakeMs = startMs;
+    command(static_cast<int32_t>(applied * 1000));
+    while (pros::millis() - startMs < durationMs) {
+        record(test, applied);
+        pros::Task::delay_until(&wakeMs, samplePeriodMs);
+    }
+    command(0);
+}
+
+bool DriveCharacterization::save(const char* path) const {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::fprintf(file, "test,time_s,left_volts,right_volts,left_velocity,right_velocity,left_acceleration,"
+                       "right_acceleration\n");
+    for (size_t i = 0; i < count; i++) {
+        const CharacterizationSample& sample = samples[i];
+        std::fprintf(file, "%u,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n", static_cast<unsigned>(sample.test),
+                     sample.timestampUs / 1e6, sample.leftVolts, sample.rightVolts, sample.leftVelocity,
+                     sample.rightVelocity, acceleration(samples.data(), count, i, true),
+                     acceleration(samples.data(), count, i, false));
+    }
+    return std::fclose(file) == 0;
+}
+
+size_t DriveCharacterization::sample_count() const { return count; }
+
+void DriveCharacterization::clear() { count = 0; }
@@ -0,0 +1,88 @@
+#include "motion/motion_chassis.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "motion/packed_path.hpp"
+#include "motion/path_cursor.hpp"
+
+void MotionChassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    const PackedPath packed(path.buf, path.size);
+    if (!packed.valid()) {
+        lemlib::Chassis::follow(path, lookahead, timeout, forwards, async);
+        return;
+    }
+
+    requestMotionStart();
+    if (!motionRunning) {
+        return;
+    }
+    if (async) {
+        const asset* pathPtr = &path;
+        pros::Task task([this, pathPtr, lookahead, timeout, forwards]() {
+            follow(*pathPtr, lookahead, timeout, forwards, false);
+        });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    const size_t last = packed.size() - 1;
+    const float halfTrack = drivetrain.trackWidth / 2;
+    const float maxVelocityStep = lateralLimits.maxAcceleration * 0.01f; // per 10 ms tick
+    PathCursor cursor(packed);
+    float commandedVelocity = 0;
+    resetOutput();
+    distTraveled = 0;
+
+    lemlib::Timer timer(timeout);
+    while (!timer.isDone() && motionRunning) {
+        lemlib::Pose pose = getPose(true);
+        if (!forwards) {
+            pose.theta += M_PI;
+        }
+
+        const size_t closest = cursor.closest(pose.x, pose.y);
+        distTraveled = packed.distance(closest);
+        if (closest == last) {
+            break;
+        }
+        const LookaheadPoint target = cursor.lookahead(pose.x, pose.y, lookahead);
+
+        // Curvature of the arc through the lookahead point, positive to the right
+        const float dx = target.x - pose.x;
+        const float dy = target.y - pose.y;
+        const float lateral = dx * std::cos(pose.theta) - dy * std::sin(pose.theta);
+        const float chordSquared = dx * dx + dy * dy;
+        const float curvature = chordSquared > 0 ? 2 * lateral / chordSquared : 0;
+
+        // Precomputed velocity, rate limited on the way up
+        const float targetVelocity = packed.velocity(closest);
+        const float previousVelocity = commandedVelocity;
+        commandedVelocity = std::min(targetVelocity, commandedVelocity + maxVelocityStep);
+        const float acceleration = (commandedVelocity - previousVelocity) / 0.01f;
+
+        // Side speeds in the frame being followed; reversed, the robot's left
+        // side is the frame's right side, driving backwards
+        float leftScale = 1 + curvature * halfTrack;
+        float rightScale = 1 - curvature * halfTrack;
+        if (!forwards) {
+            const float frameLeft = leftScale;
+            leftScale = -rightScale;
+            rightScale = -frameLeft;
+        }
+
+        // Desaturation in driveSides keeps the side ratio, so curvature holds
+        driveSides({commandedVelocity * leftScale, acceleration * leftScale},
+                   {commandedVelocity * rightScale, acceleration * rightScale});
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
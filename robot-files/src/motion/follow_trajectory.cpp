@@ -0,0 +1,73 @@
+#include "motion/motion_chassis.hpp"
+
+#include <cmath>
+
+#include "hardware/drive_units.hpp"
+#include "lemlib/timer.hpp"
+#include "motion/packed_path.hpp"
+#include "motion/trajectory.hpp"
+
+void MotionChassis::followTrajectory(const asset& path, int timeout, bool forwards, bool async) {
+    const PackedPath packed(path.buf, path.size);
+    if (!packed.valid()) {
+        return;
+    }
+
+    requestMotionStart();
+    if (!motionRunning) {
+        return;
+    }
+    if (async) {
+        const asset* pathPtr = &path;
+        pros::Task task([this, pathPtr, timeout, forwards]() { followTrajectory(*pathPtr, timeout, forwards, false); });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    const Trajectory trajectory(packed, lateralLimits.maxAcceleration);
+
+    // in/s at the wheel -> motor RPM: wheel RPM, then through the gearing to the cartridge
+    const float inchesPerSecondToRpm =
+        1 / inches_per_second_per_rpm(drivetrain.wheelDiameter, drivetrain.rpm, drivetrain.leftMotors->get_gearing());
+
+    resetOutput();
+    distTraveled = 0;
+    lemlib::Timer timer(timeout);
+    const uint32_t startMs = pros::millis();
+    while (!timer.isDone() && motionRunning) {
+        const float t = (pros::millis() - startMs) / 1000.0f;
+        if (t > trajectory.duration()) {
+            break;
+        }
+        const TrajectoryState reference = trajectory.sample(t);
+        distTraveled = reference.distance;
+
+        // Driving backwards, track the path with the robot's rear as its front
+        lemlib::Pose pose = getPose(true, true);
+        if (!forwards) {
+            pose.theta += M_PI;
+        }
+
+        ChassisSpeeds speeds = ramsete.calculate(pose.x, pose.y, pose.theta, reference.x, reference.y, reference.theta,
+                                                 reference.velocity, reference.omega);
+        if (!forwards) {
+            speeds.velocity = -speeds.velocity;
+        }
+
+        const WheelSpeeds wheels = RamseteController::to_wheel_speeds(speeds, drivetrain.trackWidth);
+        if (getOutputMode() == OutputMode::VOLTAGE) {
+            driveSides({wheels.left}, {wheels.right});
+        } else {
+            drivetrain.leftMotors->move_velocity(wheels.left * inchesPerSecondToRpm);
+            drivetrain.rightMotors->move_velocity(wheels.right * inchesPerSecondToRpm);
+        }
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
@@ -0,0 +1,288 @@
+#include "motion/motion_chassis.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include "hardware/drive_units.hpp"
+#include "hardware/sensor_hub.hpp"
+#include "lemlib/timer.hpp"
+#include "odometry/ekf_odometry.hpp"
+#include "lemlib/util.hpp"
+
+namespace {
+// Below this distance to the target, hold the initial heading instead of
+// re-aiming at the point, which would swing wildly as the robot arrives
+constexpr float HEADING_LOCK_DISTANCE = 6;
+
+// Weight of each new encoder difference in the wheel velocity estimate; one
+// tick over a 10 ms read is a couple of in/s, so some smoothing is needed
+constexpr float VELOCITY_FILTER_ALPHA = 0.5f;
+
+constexpr float MAX_VOLTS = 12;
+
+/**
+ * @brief Uses the override when set, the default otherwise
+ */
+ProfileConstraints with_overrides(ProfileConstraints defaults, float maxVelocity, float maxAcceleration) {
+    if (maxVelocity > 0) {
+        defaults.maxVelocity = maxVelocity;
+    }
+    if (maxAcceleration > 0) {
+        defaults.maxAcceleration = maxAcceleration;
+    }
+    return defaults;
+}
+
+float seconds_since(uint32_t startMs) { return (pros::millis() - startMs) / 1000.0f; }
+} // namespace
+
+MotionChassis::MotionChassis(lemlib::Drivetrain drivetrain, lemlib::ControllerSettings linearSettings,
+                             lemlib::ControllerSettings angularSettings, lemlib::OdomSensors sensors,
+                             lemlib::DriveCurve* throttleCurve, lemlib::DriveCurve* steerCurve,
+                             ProfileConstraints lateralLimits, ProfileConstraints angularLimits,
+                             SimpleMotorFeedforward leftFeedforward, SimpleMotorFeedforward rightFeedforward,
+                             RamseteController ramsete, OutputCompensation compensation,
+                             VelocityLoopGains velocityGains)
+    : lemlib::Chassis(drivetrain, linearSettings, angularSettings, sensors, throttleCurve, steerCurve),
+      lateralLimits(lateralLimits),
+      angularLimits(angularLimits),
+      leftFeedforward(leftFeedforward),
+      rightFeedforward(rightFeedforward),
+      ramsete(ramsete),
+      compensation(compensation),
+      leftVelocityLoop(leftFeedforward, velocityGains),
+      rightVelocityLoop(rightFeedforward, velocityGains),
+      leftVelocity(VELOCITY_FILTER_ALPHA),
+      rightVelocity(VELOCITY_FILTER_ALPHA) {}
+
+void MotionChassis::profiledMoveToPoint(float x, float y, int timeout, ProfiledMoveParams params, bool async) {
+    // Same queueing as LemLib's own motions
+    requestMotionStart();
+    if (!motionRunning) {
+        return;
+    }
+    if (async) {
+        pros::Task task([this, x, y, timeout, params]() { profiledMoveToPoint(x, y, timeout, params, false); });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    const lemlib::Pose start = getPose();
+    const float dx = x - start.x;
+    const float dy = y - start.y;
+    const float distance = std::hypot(dx, dy);
+    const float unitX = distance > 0 ? dx / distance : 0;
+    const float unitY = distance > 0 ? dy / distance : 0;
+    const float direction = params.forwards ? 1 : -1;
+
+    const MotionProfile profile(distance, with_overrides(lateralLimits, params.maxVelocity, params.maxAcceleration));
+    const float lockedHeading = lemlib::radToDeg(std::atan2(dx, dy)) + (params.forwards ? 0 : 180);
+
+    lateralPID.reset();
+    angularPID.reset();
+    resetOutput();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    distTraveled = 0;
+
+    lemlib::Timer timer(timeout);
+    const uint32_t startMs = pros::millis();
+    while (!timer.isDone() && motionRunning) {
+        const float t = seconds_since(startMs);
+        const ProfileState reference = profile.sample(t);
+        const lemlib::Pose pose = getPose();
+
+        // Progress is measured along the start-to-target line
+        const float traveled = (pose.x - start.x) * unitX + (pose.y - start.y) * unitY;
+        distTraveled = traveled;
+
+        if (t >= profile.duration()) {
+            const float finalError = distance - traveled;
+            if (lateralSmallExit.update(finalError) || lateralLargeExit.update(finalError)) {
+                break;
+            }
+        }
+
+        const float lateralError = reference.position - traveled;
+        float lateralOut = lateralPID.update(lateralError) * compensation.lateralSchedule.at(lateralError);
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed) * direction;
+
+        float targetHeading = lockedHeading;
+        if (std::hypot(x - pose.x, y - pose.y) > HEADING_LOCK_DISTANCE) {
+            targetHeading = lemlib::radToDeg(std::atan2(x - pose.x, y - pose.y)) + (params.forwards ? 0 : 180);
+        }
+        const float angularError = lemlib::angleError(targetHeading, pose.theta, false);
+        float angularOut = angularPID.update(angularError) * compensation.angularSchedule.at(angularError);
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+
+        // The planned motion goes to feedforward, the corrections on top
+        const float velocity = reference.velocity * direction;
+        const float acceleration = reference.acceleration * direction;
+
+        // Give steering priority, like LemLib's moveToPoint, counting the
+        // feedforward each side also gets: only the forward share gives way
+        const float leftForward = leftFeedforward.output(velocity, acceleration) + lateralOut;
+        const float rightForward = rightFeedforward.output(velocity, acceleration) + lateralOut;
+        const float overturn =
+            std::max(std::fabs(leftForward), std::fabs(rightForward)) + std::fabs(angularOut) - params.maxSpeed;
+        if (overturn > 0) {
+            lateralOut -= leftForward + rightForward > 0 ? overturn : -overturn;
+        }
+
+        driveSides({velocity, acceleration, lateralOut + angularOut}, {velocity, acceleration, lateralOut - angularOut});
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
+
+void MotionChassis::profiledTurnToHeading(float theta, int timeout, ProfiledTurnParams params, bool async) {
+    requestMotionStart();
+    if (!motionRunning) {
+        return;
+    }
+    if (async) {
+        pros::Task task([this, theta, timeout, params]() { profiledTurnToHeading(theta, timeout, params, false); });
+        endMotion();
+        pros::delay(10);
+        return;
+    }
+
+    const float startTheta = getPose().theta;
+    const float delta = lemlib::angleError(theta, startTheta, false, params.direction);
+    const MotionProfile profile(delta, with_overrides(angularLimits, params.maxVelocity, params.maxAcceleration));
+
+    angularPID.reset();
+    resetOutput();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    distTraveled = 0;
+
+    lemlib::Timer timer(timeout);
+    const uint32_t startMs = pros::millis();
+    while (!timer.isDone() && motionRunning) {
+        const float t = seconds_since(startMs);
+        const ProfileState reference = profile.sample(t);
+        const float heading = getPose().theta;
+        distTraveled = std::fabs(heading - startTheta);
+
+        if (t >= profile.duration()) {
+            const float finalError = lemlib::angleError(theta, heading, false);
+            if (angularSmallExit.update(finalError) || angularLargeExit.update(finalError)) {
+                break;
+            }
+        }
+
+        // Tracking error is small, so the shortest-way error is always the right one here
+        const float trackingError = lemlib::angleError(startTheta + reference.position, heading, false);
+        float out = angularPID.update(trackingError) * compensation.angularSchedule.at(trackingError);
+        out = std::clamp(out, -params.maxSpeed, params.maxSpeed);
+
+        // Turning in place, each side's ground speed is omega * trackWidth / 2
+        const float degreesToWheel = lemlib::degToRad(1) * drivetrain.trackWidth / 2;
+        const float wheelVelocity = reference.velocity * degreesToWheel;
+        const float wheelAcceleration = reference.acceleration * degreesToWheel;
+        driveSides({wheelVelocity, wheelAcceleration, out}, {-wheelVelocity, -wheelAcceleration, -out});
+
+        pros::delay(10);
+    }
+
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    distTraveled = -1;
+    endMotion();
+}
+
+void MotionChassis::moveCompensated(float left, float right) {
+    float scale = 1;
+    if (compensation.sensorHub != nullptr) {
+        scale = battery_scale(compensation.sensorHub->snapshot().battery.filteredMv, compensation.nominalMv,
+                              compensation.minMv);
+    }
+    const CompensatedSides sides = compensate_sides(left, right, scale);
+    drivetrain.leftMotors->move(sides.left);
+    drivetrain.rightMotors->move(sides.right);
+}
+
+void MotionChassis::driveSides(SideCommand left, SideCommand right) {
+    if (outputMode == OutputMode::MOVE) {
+        moveCompensated(leftFeedforward.output(left.velocity, left.acceleration) + left.correction,
+                        rightFeedforward.output(right.velocity, right.acceleration) + right.correction);
+        return;
+    }
+
+    // Device timestamps, not task timing, set the differentiation interval
+    const SensorSnapshot snapshot = compensation.sensorHub->snapshot();
+    leftVelocity.update(mean_raw_position(snapshot.leftDrive) * inchesPerTick, snapshot.leftDrive.deviceTimestampMs);
+    rightVelocity.update(mean_raw_position(snapshot.rightDrive) * inchesPerTick,
+                         snapshot.rightDrive.deviceTimestampMs);
+
+    const uint32_t nowMs = pros::millis();
+    const float dt = lastOutputMs == 0 ? 0.01f : std::clamp((nowMs - lastOutputMs) / 1000.0f, 0.001f, 0.05f);
+    lastOutputMs = nowMs;
+
+    float leftVolts = leftVelocityLoop.calculate(left.velocity, left.acceleration, leftVelocity.velocity(), dt) +
+                      left.correction / OUTPUT_PER_VOLT;
+    float rightVolts = rightVelocityLoop.calculate(right.velocity, right.acceleration, rightVelocity.velocity(), dt) +
+                       right.correction / OUTPUT_PER_VOLT;
+    const float ratio = std::max(std::fabs(leftVolts), std::fabs(rightVolts)) / MAX_VOLTS;
+    if (ratio > 1) {
+        leftVolts /= ratio;
+        rightVolts /= ratio;
+    }
+    drivetrain.leftMotors->move_voltage(leftVolts * 1000);
+    drivetrain.rightMotors->move_voltage(rightVolts * 1000);
+}
+
+void MotionChassis::resetOutput() {
+    leftVelocityLoop.reset();
+    rightVelocityLoop.reset();
+    leftVelocity.reset();
+    rightVelocity.reset();
+    lastOutputMs = 0;
+    if (outputMode == OutputMode::VOLTAGE) {
+        inchesPerTick = inches_per_tick(drivetrain.wheelDiameter, drivetrain.rpm, drivetrain.leftMotors->get_gearing());
+    }
+}
+
+void MotionChassis::setPose(float x, float y, float theta, bool radians) {
+    setPose(lemlib::Pose(x, y, theta), radians);
+}
+
+void MotionChassis::setPose(lemlib::Pose pose, bool radians) {
+    lemlib::Chassis::setPose(pose, radians);
+    if (poseEstimator != nullptr) {
+        poseEstimator->request_reset(lemlib::Pose(pose.x, pose.y, radians ? lemlib::radToDeg(pose.theta) : pose.theta));
+    }
+}
+
+void MotionChassis::setPoseEstimator(EkfOdometry* estimator) { poseEstimator = estimator; }
+
+void MotionChassis::setOutputMode(OutputMode mode) {
+    outputMode = compensation.sensorHub != nullptr ? mode : OutputMode::MOVE;
+}
+
+OutputMode MotionChassis::getOutputMode() const { return outputMode; }
+
+void MotionChassis::setLateralGains(float kP, float kI, float kD) {
+    lateralSettings.kP = kP;
+    lateralSettings.kI = kI;
+    lateralSettings.kD = kD;
+    // lemlib::PID's gains are const, so rebuild it in place (it is trivially destructible)
+    lateralPID.~PID();
+    new (&lateralPID) lemlib::PID(kP, kI, kD, lateralSettings.windupRange, true);
+}
+
+void MotionChassis::setAngularGains(float kP, float kI, float kD) {
+    angularSettings.kP = kP;
+    angularSettings.kI = kI;
+    angularSettings.kD = kD;
+    angularPID.~PID();
+    new (&angularPID) lemlib::PID(kP, kI, kD, angularSettings.windupRange, true);
+}
@@ -0,0 +1,132 @@
+#include "motion/motion_profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * @brief State after integrating constant jerk for dt seconds
+ */
+ProfileState integrate(const ProfileState& start, float jerk, float dt) {
+    ProfileState state;
+    state.acceleration = start.acceleration + jerk * dt;
+    state.velocity = start.velocity + start.acceleration * dt + jerk * dt * dt / 2;
+    state.position = start.position + start.velocity * dt + start.acceleration * dt * dt / 2 + jerk * dt * dt * dt / 6;
+    return state;
+}
+
+/**
+ * @brief Distance covered accelerating from rest to vPeak under jerk/accel limits
+ *
+ * The velocity curve of a symmetric S-curve ramp is point-symmetric about its
+ * midpoint, so the mean velocity is vPeak / 2.
+ */
+float ramp_distance(float vPeak, float maxAcceleration, float maxJerk) {
+    const float aPeak = std::min(maxAcceleration, std::sqrt(vPeak * maxJerk));
+    const float rampTime = aPeak > 0 ? vPeak / aPeak + aPeak / maxJerk : 0;
+    return vPeak * rampTime / 2;
+}
+} // namespace
+
+MotionProfile::MotionProfile(float distance, ProfileConstraints constraints) {
+    sign = distance < 0 ? -1 : 1;
+    const float d = std::fabs(distance);
+    const float maxV = std::fabs(constraints.maxVelocity);
+    const float maxA = std::fabs(constraints.maxAcceleration);
+    const float maxJ = std::fabs(constraints.maxJerk);
+    if (d <= 0 || maxV <= 0 || maxA <= 0) {
+        return;
+    }
+
+    if (maxJ <= 0) {
+        // Trapezoid: drop the cruise phase and lower the peak if the distance is short
+        float vPeak = maxV;
+        if (d < maxV * maxV / maxA) {
+            vPeak = std::sqrt(d * maxA);
+        }
+        const float rampTime = vPeak / maxA;
+        const float cruiseTime = (d - vPeak * rampTime) / vPeak;
+
+        push(rampTime, 0, maxA);
+        push(cruiseTime, 0, 0);
+        push(rampTime, 0, -maxA);
+        peakVelocity = vPeak;
+    } else {
+        // S-curve: find the highest peak velocity whose two ramps fit in the distance
+        float vPeak = maxV;
+        if (2 * ramp_distance(maxV, maxA, maxJ) > d) {
+            float low = 0;
+            float high = maxV;
+            for (int i = 0; i < 40; i++) {
+                const float mid = (low + high) / 2;
+                if (2 * ramp_distance(mid, maxA, maxJ) > d) {
+                    high = mid;
+                } else {
+                    low = mid;
+                }
+            }
+            vPeak = low;
+        }
+
+        const float aPeak = std::min(maxA, std::sqrt(vPeak * maxJ));
+        const float jerkTime = aPeak / maxJ;
+        const float constantAccelTime = std::max(0.0f, vPeak / aPeak - jerkTime);
+        const float cruiseTime = std::max(0.0f, (d - 2 * ramp_distance(vPeak, maxA, maxJ)) / vPeak);
+
+        push(jerkTime, maxJ, 0);
+        push(constantAccelTime, 0, aPeak);
+        push(jerkTime, -maxJ, aPeak);
+        push(cruiseTime, 0, 0);
+        push(jerkTime, -maxJ, 0);
+        push(constantAccelTime, 0, -aPeak);
+        push(jerkTime, maxJ, -aPeak);
+        peakVelocity = vPeak;
+    }
+}
+
+void MotionProfile::push(float duration, float jerk, float acceleration) {
+    if (duration <= 0) {
+        return;
+    }
+
+    Segment segment;
+    segment.duration = duration;
+    segment.jerk = jerk;
+    if (segmentCount > 0) {
+        const Segment& previous = segments[segmentCount - 1];
+        segment.start = integrate(previous.start, previous.jerk, previous.duration);
+    }
+    segment.start.acceleration = acceleration;
+
+    segments[segmentCount++] = segment;
+    totalDuration += duration;
+}
+
+ProfileState MotionProfile::sample(float t) const {
+    if (segmentCount == 0) {
+        return ProfileState();
+    }
+
+    float remaining = std::max(0.0f, t);
+    for (std::size_t i = 0; i < segmentCount; i++) {
+        const Segment& segment = segments[i];
+        if (remaining <= segment.duration) {
+            ProfileState state = integrate(segment.start, segment.jerk, remaining);
+            state.position *= sign;
+            state.velocity *= sign;
+            state.acceleration *= sign;
+            return state;
+        }
+        remaining -= segment.duration;
+    }
+
+    // Past the end: hold the final position at rest
+    const Segment& last = segments[segmentCount - 1];
+    ProfileState end;
+    end.position = integrate(last.start, last.jerk, last.duration).position * sign;
+    return end;
+}
+
+float MotionProfile::duration() const { return totalDuration; }
+
+float MotionProfile::peak_velocity() const { return peakVelocity; }
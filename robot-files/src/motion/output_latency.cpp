@@ -0,0 +1,168 @@
+#include "motion/output_latency.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "hardware/drive_units.hpp"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace {
+// Fraction of the step that counts as risen (one time constant)
+constexpr float RISE_FRACTION = 0.63f;
+
+// Light smoothing, so one quantized encoder difference cannot fake a rise
+constexpr float VELOCITY_FILTER_ALPHA = 0.5f;
+
+/**
+ * @brief Mean raw position of a group (inches); timestampMs receives the device timestamp of the read
+ */
+float read_position(pros::MotorGroup& group, float inchesPerTick, uint32_t& timestampMs) {
+    const std::vector<std::int32_t> raw = group.get_raw_position_all(&timestampMs);
+    if (raw.empty()) {
+        return 0;
+    }
+    double total = 0;
+    for (const std::int32_t ticks : raw) {
+        total += ticks;
+    }
+    return static_cast<float>(total / raw.size()) * inchesPerTick;
+}
+
+float since_command(uint32_t timestampMs, uint32_t commandMs) {
+    return std::max(0.0f, static_cast<float>(static_cast<int32_t>(timestampMs - commandMs)));
+}
+} // namespace
+
+OutputLatencyTest::OutputLatencyTest(pros::MotorGroup& left, pros::MotorGroup& right, float wheelDiameter,
+                                     float wheelRpm, VelocityLoop leftLoop, VelocityLoop rightLoop)
+    : left(left),
+      right(right),
+      wheelDiameter(wheelDiameter),
+      wheelRpm(wheelRpm),
+      leftLoop(leftLoop),
+      rightLoop(rightLoop) {}
+
+void OutputLatencyTest::run_trial(OutputPath path, bool forwards, float velocity, uint32_t durationMs,
+                                  float onsetDistance) {
+    const pros::MotorGears gearing = left.get_gearing();
+    const float inchesPerTick = inches_per_tick(wheelDiameter, wheelRpm, gearing);
+    const float target = forwards ? velocity : -velocity;
+
+    EncoderVelocityEstimator leftVelocity(VELOCITY_FILTER_ALPHA);
+    EncoderVelocityEstimator rightVelocity(VELOCITY_FILTER_ALPHA);
+    leftLoop.reset();
+    rightLoop.reset();
+
+    uint32_t leftStamp = 0;
+    uint32_t rightStamp = 0;
+    const float leftStart = read_position(left, inchesPerTick, leftStamp);
+    const float rightStart = read_position(right, inchesPerTick, rightStamp);
+    leftVelocity.update(leftStart, leftStamp);
+    rightVelocity.update(rightStart, rightStamp);
+
+    LatencyTrial trial;
+    trial.path = path;
+
+    const uint32_t commandMs = pros::millis();
+    uint32_t lastLoopMs = commandMs;
+    if (path == OutputPath::MOTOR_VELOCITY) {
+        const float rpm = target / inches_per_second_per_rpm(wheelDiameter, wheelRpm, gearing);
+        left.move_velocity(rpm);
+        right.move_velocity(rpm);
+    } else {
+        // First write at the same instant the other path commands
+        left.move_voltage(leftLoop.calculate(target, 0, 0, 0.01f) * 1000);
+        right.move_voltage(rightLoop.calculate(target, 0, 0, 0.01f) * 1000);
+    }
+
+    while (pros::millis() - commandMs < durationMs) {
+        const float leftPosition = read_position(left, inchesPerTick, leftStamp);
+        const float rightPosition = read_position(right, inchesPerTick, rightStamp);
+        const bool leftFresh = leftVelocity.update(leftPosition, leftStamp);
+        const bool rightFresh = rightVelocity.update(rightPosition, rightStamp);
+        const uint32_t readMs = std::max(leftStamp, rightStamp);
+
+        const float traveled = (std::fabs(leftPosition - leftStart) + std::fabs(rightPosition - rightStart)) / 2;
+        if (!trial.moved && traveled >= onsetDistance) {
+            trial.moved = true;
+            trial.onsetMs = since_command(readMs, commandMs);
+        }
+        const float speed = (leftVelocity.velocity() + rightVelocity.velocity()) / 2 * (forwards ? 1 : -1);
+        if (!trial.rose && speed >= RISE_FRACTION * velocity) {
+            trial.rose = true;
+            trial.riseMs = since_command(readMs, commandMs);
+        }
+
+        // The voltage path closes its loop once per new encoder read
+        if (path == OutputPath::VOLTAGE && (leftFresh || rightFresh)) {
+            const uint32_t nowMs = pros::millis();
+            const float dt = std::max(0.001f, (nowMs - lastLoopMs) / 1000.0f);
+            lastLoopMs = nowMs;
+            left.move_voltage(leftLoop.calculate(target, 0, leftVelocity.velocity(), dt) * 1000);
+            right.move_voltage(rightLoop.calculate(target, 0, rightVelocity.velocity(), dt) * 1000);
+        }
+
+        pros::delay(1);
+    }
+
+    // Coast to rest the same way after either path
+    left.move_voltage(0);
+    right.move_voltage(0);
+
+    if (count < MAX_TRIALS) {
+        trials[count++] = trial;
+    }
+}
+
+LatencySummary OutputLatencyTest::summary(OutputPath path) const {
+    LatencySummary result;
+    for (size_t i = 0; i < count; i++) {
+        const LatencyTrial& trial = trials[i];
+        if (trial.path != path) {
+            continue;
+        }
+        result.trials++;
+        if (trial.moved) {
+            result.moved++;
+            result.meanOnsetMs += trial.onsetMs;
+            result.maxOnsetMs = std::max(result.maxOnsetMs, trial.onsetMs);
+        }
+        if (trial.rose) {
+            result.rose++;
+            result.meanRiseMs += trial.riseMs;
+            result.maxRiseMs = std::max(result.maxRiseMs, trial.riseMs);
+        }
+    }
+    if (result.moved > 0) {
+        result.meanOnsetMs /= result.moved;
+    }
+    if (result.rose > 0) {
+        result.meanRiseMs /= result.rose;
+    }
+    return result;
+}
+
+bool OutputLatencyTest::save(const char* path) const {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::fprintf(file, "path,moved,onset_ms,rose,rise_ms\n");
+    for (size_t i = 0; i < count; i++) {
+        const LatencyTrial& trial = trials[i];
+        std::fprintf(file, "%s,%d,%.0f,%d,%.0f\n", trial.path == OutputPath::VOLTAGE ? "voltage" : "velocity",
+                     trial.moved ? 1 : 0, trial.onsetMs, trial.rose ? 1 : 0, trial.riseMs);
+    }
+    return std::fclose(file) == 0;
+}
+
+size_t OutputLatencyTest::trial_count() const { return count; }
+
+void OutputLatencyTest::clear() { count = 0; }
@@ -0,0 +1,120 @@
+#include "motion/path_cursor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * @brief Where along segment (a, b) a circle around p crosses it, farthest first
+ * @return Fraction of the segment in [0, 1], or -1 if it does not cross
+ */
+float circle_intersect(float ax, float ay, float bx, float by, float px, float py, float radius) {
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float fx = ax - px;
+    const float fy = ay - py;
+
+    const float a = dx * dx + dy * dy;
+    const float b = 2 * (fx * dx + fy * dy);
+    const float c = fx * fx + fy * fy - radius * radius;
+    const float discriminant = b * b - 4 * a * c;
+    if (a <= 0 || discriminant < 0) {
+        return -1;
+    }
+
+    const float root = std::sqrt(discriminant);
+    const float far = (-b + root) / (2 * a);
+    if (far >= 0 && far <= 1) {
+        return far;
+    }
+    const float near = (-b - root) / (2 * a);
+    if (near >= 0 && near <= 1) {
+        return near;
+    }
+    return -1;
+}
+} // namespace
+
+PathCursor::PathCursor(const PackedPath& path, size_t window)
+    : path(path),
+      window(std::max<size_t>(window, 1)) {
+    reset();
+}
+
+void PathCursor::reset() {
+    cursor = 0;
+    lastLookahead = LookaheadPoint();
+    if (path.size() > 0) {
+        lastLookahead.x = path.x(0);
+        lastLookahead.y = path.y(0);
+    }
+}
+
+float PathCursor::distance_squared(size_t index, float x, float y) const {
+    const float dx = path.x(index) - x;
+    const float dy = path.y(index) - y;
+    return dx * dx + dy * dy;
+}
+
+size_t PathCursor::closest(float x, float y) {
+    if (path.size() == 0) {
+        return 0;
+    }
+    const size_t last = path.size() - 1;
+
+    size_t best = cursor;
+    float bestDistance = distance_squared(cursor, x, y);
+
+    // Fixed window first, so a local bump in distance does not stop the search
+    const size_t windowEnd = std::min(last, cursor + window);
+    for (size_t i = cursor + 1; i <= windowEnd; i++) {
+        const float d = distance_squared(i, x, y);
+        if (d < bestDistance) {
+            bestDistance = d;
+            best = i;
+        }
+    }
+
+    // Past the window, keep going only while points keep getting closer
+    for (size_t i = windowEnd + 1; i <= last; i++) {
+        const float d = distance_squared(i, x, y);
+        if (d >= bestDistance) {
+            break;
+        }
+        bestDistance = d;
+        best = i;
+    }
+
+    cursor = best;
+    return cursor;
+}
+
+LookaheadPoint PathCursor::lookahead(float x, float y, float radius) {
+    if (path.size() == 0) {
+        return lastLookahead;
+    }
+    const size_t last = path.size() - 1;
+
+    // Search at least the window, and far enough along the path to cover the
+    // circle however densely the path is sampled
+    const size_t start = std::max(cursor, lastLookahead.segment);
+    const float searchDistance = path.distance(start) + 2 * radius;
+    for (size_t i = start; i < last && (i < start + window || path.distance(i) < searchDistance); i++) {
+        const float t = circle_intersect(path.x(i), path.y(i), path.x(i + 1), path.y(i + 1), x, y, radius);
+        if (t >= 0) {
+            lastLookahead.segment = i;
+            lastLookahead.x = path.x(i) + (path.x(i + 1) - path.x(i)) * t;
+            lastLookahead.y = path.y(i) + (path.y(i + 1) - path.y(i)) * t;
+            break;
+        }
+    }
+
+    if (distance_squared(last, x, y) < radius * radius) {
+        lastLookahead.segment = last;
+        lastLookahead.x = path.x(last);
+        lastLookahead.y = path.y(last);
+    }
+    return lastLookahead;
+}
+
+size_t PathCursor::index() const { return cursor; }
@@ -0,0 +1,194 @@
+#include "motion/pid_autotune.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+constexpr size_t MAX_DELAY_STEPS = 128;
+constexpr size_t GAIN_STEPS = 40;       // kP candidates
+constexpr size_t DERIVATIVE_STEPS = 30; // kD candidates per kP
+constexpr float MIN_KP_FRACTION = 0.05f; // of Ku
+constexpr float MAX_KP_FRACTION = 1.5f;  // of Ku
+constexpr float MAX_TD_FRACTION = 0.5f;  // derivative time, of Tu
+constexpr float GAIN_MARGIN = 0.1f;      // gains must also meet the goal on a plant this much faster
+constexpr float DEAD_TIME_MARGIN = 0.005f; // and with this much more dead time (s)
+} // namespace
+
+RelayAnalyzer::RelayAnalyzer(float outputAmplitude, float hysteresis)
+    : outputAmplitude(std::fabs(outputAmplitude)),
+      hysteresis(std::fabs(hysteresis)),
+      output(0) {}
+
+float RelayAnalyzer::update(float time, float error) {
+    if (firstTime < 0) {
+        firstTime = time;
+    }
+    lastTime = time;
+    updates++;
+    if (output == 0) {
+        output = error >= 0 ? outputAmplitude : -outputAmplitude;
+        cycleMax = cycleMin = error;
+    }
+
+    cycleMax = std::max(cycleMax, error);
+    cycleMin = std::min(cycleMin, error);
+
+    if (output < 0 && error > hysteresis) {
+        // Rising switch: one full cycle since the previous one
+        output = outputAmplitude;
+        if (lastRiseTime >= 0) {
+            risingEdges++;
+            if (risingEdges > SKIPPED_CYCLES) {
+                amplitudeSum += (cycleMax - cycleMin) / 2;
+                periodSum += time - lastRiseTime;
+                measured++;
+            }
+        }
+        lastRiseTime = time;
+        cycleMax = cycleMin = error;
+    } else if (output > 0 && error < -hysteresis) {
+        output = -outputAmplitude;
+    }
+    return output;
+}
+
+size_t RelayAnalyzer::cycles() const { return measured; }
+
+RelayResult RelayAnalyzer::result() const {
+    RelayResult result;
+    if (measured == 0) {
+        return result;
+    }
+    result.cycles = measured;
+    result.amplitude = amplitudeSum / measured;
+    result.period = periodSum / measured;
+    result.outputAmplitude = outputAmplitude;
+    result.hysteresis = hysteresis;
+    result.samplePeriod = updates > 1 ? (lastTime - firstTime) / (updates - 1) : 0;
+
+    // Describing function of a relay with hysteresis
+    const float effective = result.amplitude > hysteresis
+                                ? std::sqrt(result.amplitude * result.amplitude - hysteresis * hysteresis)
+                                : result.amplitude;
+    if (effective <= 0 || result.period <= 0) {
+        return result;
+    }
+    result.ultimateGain = 4 * outputAmplitude / (static_cast<float>(M_PI) * effective);
+    result.ok = true;
+    return result;
+}
+
+PlantModel identify_integrating_plant(const RelayResult& relay, float timeConstant) {
+    PlantModel plant;
+    if (!relay.ok) {
+        return plant;
+    }
+    const float omega = 2 * static_cast<float>(M_PI) / relay.period;
+    plant.timeConstant = std::max(0.0f, timeConstant);
+
+    // The relay's describing function is 4d/(pi a) at a lead of asin(h/a), so
+    // the plant's phase at the oscillation is -180 deg plus that lead:
+    // -90 (integrator) - atan(w tau) - w L
+    const float lead = relay.amplitude > relay.hysteresis ? std::asin(relay.hysteresis / relay.amplitude) : 0;
+    const float loopDeadTime = (static_cast<float>(M_PI) / 2 - std::atan(omega * plant.timeConstant) - lead) / omega;
+
+    // Sampling the error delayed each switch by half an update on average.
+    // simulate_step charges the PID's own hold separately, so it is not plant
+    plant.deadTime = std::max(0.0f, loopDeadTime - relay.samplePeriod / 2);
+
+    // Loop gain there is 1: |G| = pi a / (4 d)
+    const float magnitude = static_cast<float>(M_PI) * relay.amplitude / (4 * relay.outputAmplitude);
+    plant.gain = omega * std::sqrt(1 + omega * omega * plant.timeConstant * plant.timeConstant) * magnitude;
+    return plant;
+}
+
+StepMetrics simulate_step(const PlantModel& plant, const PidGains& gains, const TuningGoal& goal) {
+    const size_t delaySteps = std::min(MAX_DELAY_STEPS - 1, static_cast<size_t>(std::lround(plant.deadTime / goal.dt)));
+    std::array<float, MAX_DELAY_STEPS> delayed{};
+    size_t head = 0;
+
+    float position = 0;
+    float velocity = 0;
+    float integral = 0;
+    float previousError = 0;
+    float peak = 0;
+    float lastOutsideTime = 0;
+
+    const size_t steps = static_cast<size_t>(goal.maxTime / goal.dt);
+    for (size_t i = 0; i < steps; i++) {
+        const float time = i * goal.dt;
+        const float error = goal.step - position;
+        if (std::fabs(error) > goal.tolerance) {
+            lastOutsideTime = time;
+        }
+
+        // LemLib's PID: integral and derivative per update, not per second
+        integral += error;
+        const float derivative = error - previousError;
+        previousError = error;
+        const float output = std::clamp(gains.kP * error + gains.kI * integral + gains.kD * derivative,
+                                        -goal.outputLimit, goal.outputLimit);
+
+        delayed[(head + delaySteps) % MAX_DELAY_STEPS] = output;
+        const float applied = delayed[head];
+        head = (head + 1) % MAX_DELAY_STEPS;
+
+        if (plant.timeConstant > 0) {
+            velocity += goal.dt * (plant.gain * applied - velocity) / plant.timeConstant;
+        } else {
+            velocity = plant.gain * applied;
+        }
+        position += velocity * goal.dt;
+        peak = std::max(peak, position);
+    }
+
+    StepMetrics metrics;
+    metrics.overshoot = std::max(0.0f, peak - goal.step) / goal.step;
+    metrics.settleTime = lastOutsideTime + goal.dt;
+    metrics.settled = metrics.settleTime < goal.maxTime - 0.5f;
+    return metrics;
+}
+
+PidGains tune_pid(const PlantModel& plant, const RelayResult& relay, const TuningGoal& goal, StepMetrics* metrics) {
+    PidGains best;
+    StepMetrics bestMetrics;
+    bool found = false;
+    if (!relay.ok || plant.gain <= 0) {
+        return best;
+    }
+
+    PlantModel pessimistic = plant;
+    pessimistic.gain *= 1 + GAIN_MARGIN;
+    pessimistic.deadTime += DEAD_TIME_MARGIN;
+
+    const float ratio = MAX_KP_FRACTION / MIN_KP_FRACTION;
+    for (size_t i = 0; i < GAIN_STEPS; i++) {
+        const float kP = relay.ultimateGain * MIN_KP_FRACTION * std::pow(ratio, i / float(GAIN_STEPS - 1));
+        for (size_t j = 0; j < DERIVATIVE_STEPS; j++) {
+            const float derivativeTime = relay.period * MAX_TD_FRACTION * j / float(DERIVATIVE_STEPS - 1);
+            PidGains candidate;
+            candidate.kP = kP;
+            candidate.kD = kP * derivativeTime / goal.dt;
+
+            const StepMetrics result = simulate_step(plant, candidate, goal);
+            if (!result.settled || result.overshoot > goal.maxOvershoot) {
+                continue;
+            }
+            const StepMetrics robust = simulate_step(pessimistic, candidate, goal);
+            if (!robust.settled || robust.overshoot > goal.maxOvershoot) {
+                continue;
+            }
+            if (!found || result.settleTime < bestMetrics.settleTime) {
+                best = candidate;
+                bestMetrics = result;
+                found = true;
+            }
+        }
+    }
+
+    if (metrics != nullptr) {
+        *metrics = bestMetrics;
+    }
+    return best;
+}
@@ -0,0 +1,40 @@
+#include "motion/ramsete.hpp"
+
+#include <cmath>
+
+namespace {
+float sinc(float x) {
+    if (std::fabs(x) < 1e-6f) {
+        return 1 - x * x / 6;
+    }
+    return std::sin(x) / x;
+}
+} // namespace
+
+RamseteController::RamseteController(float b, float zeta)
+    : b(b),
+      zeta(zeta) {}
+
+ChassisSpeeds RamseteController::calculate(float x, float y, float theta, float refX, float refY, float refTheta,
+                                           float refVelocity, float refOmega) const {
+    // Error in the robot's frame
+    const float dx = refX - x;
+    const float dy = refY - y;
+    const float errorX = std::cos(theta) * dx + std::sin(theta) * dy;
+    const float errorY = -std::sin(theta) * dx + std::cos(theta) * dy;
+    const float errorTheta = std::remainder(refTheta - theta, static_cast<float>(2 * M_PI));
+
+    const float k = 2 * zeta * std::sqrt(refOmega * refOmega + b * refVelocity * refVelocity);
+
+    ChassisSpeeds speeds;
+    speeds.velocity = refVelocity * std::cos(errorTheta) + k * errorX;
+    speeds.omega = refOmega + k * errorTheta + b * refVelocity * sinc(errorTheta) * errorY;
+    return speeds;
+}
+
+WheelSpeeds RamseteController::to_wheel_speeds(ChassisSpeeds speeds, float trackWidth) {
+    WheelSpeeds wheels;
+    wheels.left = speeds.velocity - speeds.omega * trackWidth / 2;
+    wheels.right = speeds.velocity + speeds.omega * trackWidth / 2;
+    return wheels;
+}
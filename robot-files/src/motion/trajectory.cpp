@@ -0,0 +1,89 @@
+#include "motion/trajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Floor used when integrating time, so a point the path marks as 0 in/s
+// (the end) is still reached in finite time
+constexpr float MIN_VELOCITY = 0.5f;
+
+/**
+ * @brief LemLib compass heading (degrees, clockwise from +y) to standard position radians
+ */
+float compass_to_standard(float headingDeg) { return static_cast<float>(M_PI / 2 - headingDeg * M_PI / 180); }
+
+float wrap_angle(float angle) {
+    return std::remainder(angle, static_cast<float>(2 * M_PI));
+}
+} // namespace
+
+Trajectory::Trajectory(const PackedPath& path, float maxAcceleration)
+    : path(path),
+      velocities(path.size()),
+      times(path.size()) {
+    if (path.size() == 0) {
+        return;
+    }
+
+    // Forward pass: accelerate from rest no faster than the limit
+    velocities[0] = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        const float gap = path.distance(i) - path.distance(i - 1);
+        const float reachable = std::sqrt(velocities[i - 1] * velocities[i - 1] + 2 * maxAcceleration * gap);
+        velocities[i] = std::min(path.velocity(i), reachable);
+    }
+
+    // Constant acceleration between points: dt = 2 * ds / (v0 + v1)
+    times[0] = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        const float gap = path.distance(i) - path.distance(i - 1);
+        const float meanVelocity = std::max((velocities[i - 1] + velocities[i]) / 2, MIN_VELOCITY);
+        times[i] = times[i - 1] + gap / meanVelocity;
+    }
+}
+
+TrajectoryState Trajectory::state_at(size_t index) const {
+    TrajectoryState state;
+    state.time = times[index];
+    state.x = path.x(index);
+    state.y = path.y(index);
+    state.theta = compass_to_standard(path.heading(index));
+    state.velocity = velocities[index];
+    state.omega = -path.curvature(index) * velocities[index]; // packed curvature is clockwise positive
+    state.distance = path.distance(index);
+    return state;
+}
+
+TrajectoryState Trajectory::sample(float t) const {
+    if (times.empty()) {
+        return TrajectoryState();
+    }
+    if (t <= 0) {
+        return state_at(0);
+    }
+    if (t >= times.back()) {
+        TrajectoryState end = state_at(times.size() - 1);
+        end.velocity = 0;
+        end.omega = 0;
+        return end;
+    }
+
+    const size_t next = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    const TrajectoryState a = state_at(next - 1);
+    const TrajectoryState b = state_at(next);
+    const float span = b.time - a.time;
+    const float f = span > 0 ? (t - a.time) / span : 0;
+
+    TrajectoryState state;
+    state.time = t;
+    state.x = a.x + (b.x - a.x) * f;
+    state.y = a.y + (b.y - a.y) * f;
+    state.theta = a.theta + wrap_angle(b.theta - a.theta) * f;
+    state.velocity = a.velocity + (b.velocity - a.velocity) * f;
+    state.omega = a.omega + (b.omega - a.omega) * f;
+    state.distance = a.distance + (b.distance - a.distance) * f;
+    return state;
+}
+
+float Trajectory::duration() const { return times.empty() ? 0 : times.back(); }
@@ -0,0 +1,44 @@
+#include "motion/velocity_loop.hpp"
+
+#include <algorithm>
+
+EncoderVelocityEstimator::EncoderVelocityEstimator(float filterAlpha)
+    : filterAlpha(std::clamp(filterAlpha, 0.0f, 1.0f)) {}
+
+bool EncoderVelocityEstimator::update(float position, uint32_t timestampMs) {
+    if (!primed) {
+        primed = true;
+        lastPosition = position;
+        lastTimestampMs = timestampMs;
+        return false;
+    }
+    if (timestampMs == lastTimestampMs) {
+        return false;
+    }
+
+    const float dt = (timestampMs - lastTimestampMs) / 1000.0f;
+    const float raw = (position - lastPosition) / dt;
+    estimate += filterAlpha * (raw - estimate);
+    lastPosition = position;
+    lastTimestampMs = timestampMs;
+    return true;
+}
+
+float EncoderVelocityEstimator::velocity() const { return estimate; }
+
+void EncoderVelocityEstimator::reset() {
+    primed = false;
+    estimate = 0;
+}
+
+VelocityLoop::VelocityLoop(SimpleMotorFeedforward feedforward, VelocityLoopGains gains)
+    : feedforward(feedforward),
+      gains(gains) {}
+
+float VelocityLoop::calculate(float targetVelocity, float targetAcceleration, float measuredVelocity, float dt) {
+    const float error = targetVelocity - measuredVelocity;
+    integral = std::clamp(integral + gains.kI * error * dt, -gains.integralLimit, gains.integralLimit);
+    return feedforward.calculate(targetVelocity, targetAcceleration) + gains.kP * error + integral;
+}
+
+void VelocityLoop::reset() { integral = 0; }
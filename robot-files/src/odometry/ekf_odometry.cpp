@@ -0,0 +1,315 @@
+#include "odometry/ekf_odometry.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lemlib/util.hpp"
+
+static_assert(HeadingFusion::MAX_GYROS == SensorSnapshot::MAX_IMUS, "one gyro per IMU slot");
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+
+// Uncertainty of a pose passed to reset: the robot is where it was placed, give or take
+constexpr float RESET_POSITION_VARIANCE = 1;     // in^2
+constexpr float RESET_HEADING_VARIANCE = 3e-4f;  // rad^2, about 1 degree
+constexpr float RESET_VELOCITY_VARIANCE = 1;
+
+// Drive sides slower than this (in/s) for this long count as stopped for gyro
+// bias estimation; a single slow window is often just a motor tick not arriving
+constexpr float STILL_SPEED = 0.1f;
+constexpr uint64_t STILL_US = 100000;
+
+bool usable(const DeviceHealth& health) { return health.present && health.connected && !health.stale; }
+
+/**
+ * @brief Wraps an angle difference into [-pi, pi)
+ */
+float wrap(float angle) { return angle - 2 * PI * std::floor((angle + PI) / (2 * PI)); }
+} // namespace
+
+EkfOdometry::EkfOdometry(EkfConfig config)
+    : config(config),
+      headingFusion(config.heading) {
+    reset(lemlib::Pose(0, 0, 0));
+}
+
+void EkfOdometry::request_reset(const lemlib::Pose& pose) {
+    resetPose.publish({pose.x, pose.y, pose.theta});
+    resetRequests.fetch_add(1, std::memory_order_release);
+}
+
+void EkfOdometry::reset(const lemlib::Pose& pose) {
+    state = {};
+    state[X] = pose.x;
+    state[Y] = pose.y;
+    state[THETA] = lemlib::degToRad(pose.theta);
+    covariance = {};
+    covariance[X][X] = RESET_POSITION_VARIANCE;
+    covariance[Y][Y] = RESET_POSITION_VARIANCE;
+    covariance[THETA][THETA] = RESET_HEADING_VARIANCE;
+    covariance[FORWARD][FORWARD] = RESET_VELOCITY_VARIANCE;
+    covariance[LATERAL][LATERAL] = RESET_VELOCITY_VARIANCE;
+    covariance[OMEGA][OMEGA] = RESET_VELOCITY_VARIANCE;
+    headingFusion.reset(pose.theta);
+}
+
+void EkfOdometry::seed_gyro_bias(std::size_t index, float biasDps) { headingFusion.seed_bias(index, biasDps); }
+
+float EkfOdometry::gyro_bias(std::size_t index) const { return headingFusion.bias(index); }
+
+void EkfOdometry::set_wheels(const EkfWheel& vertical, const EkfWheel& horizontal) {
+    config.vertical = vertical;
+    config.horizontal = horizontal;
+}
+
+void EkfOdometry::update(const SensorSnapshot& snapshot) {
+    const uint32_t requests = resetRequests.load(std::memory_order_acquire);
+    if (requests != resetsApplied) {
+        resetsApplied = requests;
+        const ResetRequest request = resetPose.read();
+        reset(lemlib::Pose(request.x, request.y, request.theta));
+    }
+
+    if (primed && snapshot.cycle == lastCycle) {
+        return;
+    }
+    const float dt = primed ? (snapshot.timestampUs - lastTimestampUs) / 1e6f : 0;
+    primed = true;
+    lastCycle = snapshot.cycle;
+    lastTimestampUs = snapshot.timestampUs;
+    counters.updates++;
+
+    if (dt > 0) {
+        predict(dt);
+    }
+
+    correct_wheel(snapshot.verticalRotation, config.vertical, verticalPrevious, FORWARD);
+    correct_wheel(snapshot.horizontalRotation, config.horizontal, horizontalPrevious, LATERAL);
+    if (config.motorInchesPerTick > 0) {
+        correct_motors(snapshot.leftDrive, leftPrevious, -config.trackWidth / 2);
+        correct_motors(snapshot.rightDrive, rightPrevious, config.trackWidth / 2);
+    }
+    correct_heading(snapshot, dt);
+    if (config.useGps) {
+        correct_gps(snapshot.gps);
+    }
+}
+
+void EkfOdometry::predict(float dt) {
+    const float sinTheta = std::sin(state[THETA]);
+    const float cosTheta = std::cos(state[THETA]);
+    const float forward = state[FORWARD];
+    const float lateral = state[LATERAL];
+
+    // Compass frame: forward is (sin, cos), the robot's right is (cos, -sin)
+    state[X] += (forward * sinTheta + lateral * cosTheta) * dt;
+    state[Y] += (forward * cosTheta - lateral * sinTheta) * dt;
+    state[THETA] += state[OMEGA] * dt;
+
+    Matrix jacobian{};
+    for (std::size_t i = 0; i < STATES; i++) {
+        jacobian[i][i] = 1;
+    }
+    jacobian[X][THETA] = (forward * cosTheta - lateral * sinTheta) * dt;
+    jacobian[X][FORWARD] = sinTheta * dt;
+    jacobian[X][LATERAL] = cosTheta * dt;
+    jacobian[Y][THETA] = (-forward * sinTheta - lateral * cosTheta) * dt;
+    jacobian[Y][FORWARD] = cosTheta * dt;
+    jacobian[Y][LATERAL] = -sinTheta * dt;
+    jacobian[THETA][OMEGA] = dt;
+
+    // P = F P F^T, using F's sparsity only through plain loops
+    Matrix temp{};
+    for (std::size_t i = 0; i < STATES; i++) {
+        for (std::size_t j = 0; j < STATES; j++) {
+            float sum = 0;
+            for (std::size_t k = 0; k < STATES; k++) {
+                sum += jacobian[i][k] * covariance[k][j];
+            }
+            temp[i][j] = sum;
+        }
+    }
+    for (std::size_t i = 0; i < STATES; i++) {
+        for (std::size_t j = 0; j < STATES; j++) {
+            float sum = 0;
+            for (std::size_t k = 0; k < STATES; k++) {
+                sum += temp[i][k] * jacobian[j][k];
+            }
+            covariance[i][j] = sum;
+        }
+    }
+
+    // Velocities are random walks driven by unknown acceleration
+    const EkfNoise& noise = config.noise;
+    covariance[FORWARD][FORWARD] += noise.forwardAcceleration * noise.forwardAcceleration * dt;
+    covariance[LATERAL][LATERAL] += noise.lateralAcceleration * noise.lateralAcceleration * dt;
+    covariance[OMEGA][OMEGA] += noise.angularAcceleration * noise.angularAcceleration * dt;
+}
+
+bool EkfOdometry::correct(const Vector& h, float innovation, float variance, bool gated) {
+    // P h^T, and S = h P h^T + r
+    Vector ph{};
+    for (std::size_t i = 0; i < STATES; i++) {
+        for (std::size_t k = 0; k < STATES; k++) {
+            ph[i] += covariance[i][k] * h[k];
+        }
+    }
+    float s = variance;
+    for (std::size_t i = 0; i < STATES; i++) {
+        s += h[i] * ph[i];
+    }
+    if (s <= 0) {
+        return false;
+    }
+
+    const float gate = config.noise.gate;
+    if (gated && innovation * innovation > gate * gate * s) {
+        counters.rejected++;
+        return false;
+    }
+
+    // x += K y and P -= K (h P), with K = P h^T / S; P is symmetric so h P = (P h^T)^T
+    for (std::size_t i = 0; i < STATES; i++) {
+        state[i] += ph[i] / s * innovation;
+    }
+    for (std::size_t i = 0; i < STATES; i++) {
+        for (std::size_t j = 0; j < STATES; j++) {
+            covariance[i][j] -= ph[i] * ph[j] / s;
+        }
+    }
+    counters.accepted++;
+    return true;
+}
+
+void EkfOdometry::correct_wheel(const RotationSample& sample, const EkfWheel& wheel, Previous& previous,
+                                StateIndex axis) {
+    if (wheel.diameter <= 0 || !usable(sample.health)) {
+        previous.valid = false;
+        return;
+    }
+
+    // Rotation sensors carry no timestamp, so use when each value was read and
+    // difference over a window holding a whole number of their updates;
+    // shorter windows alias to 0 and double speed
+    const uint64_t timestampUs = sample.readUs;
+    const float distance = sample.positionCdeg / 36000.0f * PI * wheel.diameter;
+    const float dt = (timestampUs - previous.timestampUs) / 1e6f;
+    if (previous.valid && dt * 1000 < config.wheelWindowMs) {
+        return;
+    }
+    if (previous.valid) {
+        // Turning sweeps an offset wheel backwards by offset * omega, as in LemLib's odometry
+        Vector h{};
+        h[axis] = 1;
+        h[OMEGA] = -wheel.offset;
+        const float measured = (distance - previous.value) / dt;
+        const float predicted = state[axis] - wheel.offset * state[OMEGA];
+        correct(h, measured - predicted, config.noise.trackingWheel * config.noise.trackingWheel);
+    }
+    previous.valid = true;
+    previous.value = distance;
+    previous.timestampUs = timestampUs;
+}
+
+void EkfOdometry::correct_motors(const MotorGroupSample& sample, Previous& previous, float sideOffset) {
+    if (sample.count == 0 || !usable(sample.health)) {
+        previous.valid = false;
+        return;
+    }
+    // Only a new motor timestamp carries new data
+    if (previous.valid && sample.deviceTimestampMs == previous.timestampMs) {
+        return;
+    }
+
+    const float distance = mean_raw_position(sample) * config.motorInchesPerTick;
+    if (previous.valid) {
+        const float dt = (sample.deviceTimestampMs - previous.timestampMs) / 1000.0f;
+        Vector h{};
+        h[FORWARD] = 1;
+        h[OMEGA] = -sideOffset;
+        const float measured = (distance - previous.value) / dt;
+        const float predicted = state[FORWARD] - sideOffset * state[OMEGA];
+        correct(h, measured - predicted, config.noise.motorEncoder * config.noise.motorEncoder);
+        previous.velocity = measured;
+    }
+    previous.valid = true;
+    previous.value = distance;
+    previous.timestampMs = sample.deviceTimestampMs;
+}
+
+void EkfOdometry::correct_heading(const SensorSnapshot& snapshot, float dt) {
+    if (dt <= 0) {
+        return;
+    }
+
+    std::array<GyroReading, HeadingFusion::MAX_GYROS> readings;
+    for (std::size_t i = 0; i < readings.size(); i++) {
+        readings[i].valid = usable(snapshot.imu[i].health);
+        readings[i].rateDps = config.gyroSign * snapshot.imu[i].gyroZDps;
+    }
+
+    // The drive motors decide stillness and break ties between the gyros
+    const bool motorsKnown = leftPrevious.valid && rightPrevious.valid && config.trackWidth > 0;
+    if (!motorsKnown || std::fabs(leftPrevious.velocity) >= STILL_SPEED ||
+        std::fabs(rightPrevious.velocity) >= STILL_SPEED) {
+        movingTimestampUs = snapshot.timestampUs;
+    }
+    const bool stationary = snapshot.timestampUs - movingTimestampUs >= STILL_US;
+    const float referenceRate =
+        motorsKnown ? lemlib::radToDeg((leftPrevious.velocity - rightPrevious.velocity) / config.trackWidth) : NAN;
+
+    const float heading = headingFusion.update(readings, dt, stationary, referenceRate);
+    if (!headingFusion.any_healthy()) {
+        // The fused heading is then just the motors again, which are already in
+        return;
+    }
+
+    Vector h{};
+    h[THETA] = 1;
+    correct(h, lemlib::degToRad(heading) - state[THETA], config.noise.imuHeading * config.noise.imuHeading);
+}
+
+void EkfOdometry::correct_gps(const GpsSample& sample) {
+    if (!usable(sample.health)) {
+        return;
+    }
+
+    const float positionSigma = std::max(config.noise.gpsPosition, static_cast<float>(sample.errorIn));
+    Vector hx{};
+    hx[X] = 1;
+    correct(hx, sample.x - state[X], positionSigma * positionSigma);
+    Vector hy{};
+    hy[Y] = 1;
+    correct(hy, sample.y - state[Y], positionSigma * positionSigma);
+
+    // The GPS heading is bounded, the filter's is not
+    Vector ht{};
+    ht[THETA] = 1;
+    correct(ht, wrap(lemlib::degToRad(sample.headingDeg) - state[THETA]),
+            config.noise.gpsHeading * config.noise.gpsHeading);
+}
+
+void EkfOdometry::correct_pose(const lemlib::Pose& pose, float positionSigma, float headingSigma) {
+    Vector hx{};
+    hx[X] = 1;
+    correct(hx, pose.x - state[X], positionSigma * positionSigma, false);
+    Vector hy{};
+    hy[Y] = 1;
+    correct(hy, pose.y - state[Y], positionSigma * positionSigma, false);
+    Vector ht{};
+    ht[THETA] = 1;
+    const float headingSigmaRad = lemlib::degToRad(headingSigma);
+    correct(ht, lemlib::degToRad(pose.theta) - state[THETA], headingSigmaRad * headingSigmaRad, false);
+}
+
+lemlib::Pose EkfOdometry::pose() const { return lemlib::Pose(state[X], state[Y], lemlib::radToDeg(state[THETA])); }
+
+lemlib::Pose EkfOdometry::velocity() const {
+    const float sinTheta = std::sin(state[THETA]);
+    const float cosTheta = std::cos(state[THETA]);
+    return lemlib::Pose(state[FORWARD] * sinTheta + state[LATERAL] * cosTheta,
+                        state[FORWARD] * cosTheta - state[LATERAL] * sinTheta, lemlib::radToDeg(state[OMEGA]));
+}
+
+float EkfOdometry::variance(StateIndex index) const { return covariance[index][index]; }
@@ -0,0 +1,117 @@
+#include "odometry/heading_fusion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Counts a seeded bias as long settled, so averaging does not restart from it
+constexpr uint32_t SEEDED_SAMPLES = 100000;
+} // namespace
+
+HeadingFusion::HeadingFusion(HeadingFusionConfig config)
+    : config(config) {
+    for (Channel& channel : channels) {
+        channel.variance = config.initialNoise * config.initialNoise;
+    }
+}
+
+float HeadingFusion::update(const std::array<GyroReading, MAX_GYROS>& readings, float dt, bool stationary,
+                            float referenceRate) {
+    std::array<bool, MAX_GYROS> valid{};
+    std::array<float, MAX_GYROS> corrected{};
+    for (std::size_t i = 0; i < MAX_GYROS; i++) {
+        valid[i] = readings[i].valid && std::isfinite(readings[i].rateDps);
+        corrected[i] = readings[i].rateDps - channels[i].bias;
+        if (!valid[i]) {
+            // A failed read is a fault on its own; the gyro has to earn its way back
+            channels[i].healthy = false;
+            channels[i].blamed = config.faultSamples;
+            channels[i].clean = 0;
+        }
+    }
+
+    // Two gyros that disagree: the wheels decide which one is wrong. Without
+    // a reference neither can be blamed, and both keep their weight
+    if (valid[0] && valid[1] && std::fabs(corrected[0] - corrected[1]) > config.disagreeRate) {
+        if (std::isfinite(referenceRate)) {
+            const bool firstWorse = std::fabs(corrected[0] - referenceRate) > std::fabs(corrected[1] - referenceRate);
+            blame(channels[0], firstWorse);
+            blame(channels[1], !firstWorse);
+        }
+    } else {
+        for (std::size_t i = 0; i < MAX_GYROS; i++) {
+            if (valid[i]) {
+                blame(channels[i], false);
+            }
+        }
+    }
+
+    // Bias and noise are only observable while the robot is still; a gyro
+    // reading real rotation means "still" was wrong (e.g. the robot was pushed)
+    bool allStill = stationary;
+    for (std::size_t i = 0; i < MAX_GYROS; i++) {
+        if (!valid[i] || !stationary) {
+            continue;
+        }
+        if (std::fabs(corrected[i]) > config.stillRate) {
+            allStill = false;
+            continue;
+        }
+        // A plain average until a time constant's worth of stillness has been
+        // seen, so the first stop already gives a full estimate
+        Channel& channel = channels[i];
+        channel.stillSamples++;
+        const float alpha = std::max(dt / config.biasTimeConstant, 1.0f / channel.stillSamples);
+        channel.bias += alpha * (readings[i].rateDps - channel.bias);
+        const float residual = readings[i].rateDps - channel.bias;
+        channel.variance += alpha * (residual * residual - channel.variance);
+        corrected[i] = residual;
+    }
+
+    float weightSum = 0;
+    float rateSum = 0;
+    for (std::size_t i = 0; i < MAX_GYROS; i++) {
+        if (!valid[i] || !channels[i].healthy) {
+            continue;
+        }
+        const float weight = 1 / std::max(channels[i].variance, config.minNoise * config.minNoise);
+        rateSum += weight * corrected[i];
+        weightSum += weight;
+    }
+
+    if (weightSum > 0) {
+        // Still is still: whatever is left of the bias must not integrate
+        fusedRate = allStill ? 0 : rateSum / weightSum;
+    } else {
+        fusedRate = std::isfinite(referenceRate) ? referenceRate : 0;
+    }
+    fusedHeading += fusedRate * dt;
+    return fusedHeading;
+}
+
+void HeadingFusion::reset(float headingDeg) { fusedHeading = headingDeg; }
+
+void HeadingFusion::seed_bias(std::size_t index, float biasDps) {
+    channels[index].bias = biasDps;
+    channels[index].stillSamples = SEEDED_SAMPLES;
+}
+
+bool HeadingFusion::any_healthy() const {
+    return std::any_of(channels.begin(), channels.end(), [](const Channel& channel) { return channel.healthy; });
+}
+
+void HeadingFusion::blame(Channel& channel, bool atFault) {
+    if (atFault) {
+        channel.clean = 0;
+        channel.blamed++;
+        if (channel.blamed >= config.faultSamples) {
+            channel.healthy = false;
+        }
+        return;
+    }
+    channel.blamed = 0;
+    channel.clean++;
+    if (!channel.healthy && channel.clean >= config.recoverSamples) {
+        channel.healthy = true;
+    }
+}
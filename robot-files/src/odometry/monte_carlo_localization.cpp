@@ -0,0 +1,194 @@
+#include "odometry/monte_carlo_localization.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "odometry/field_model.hpp"
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float DEG_TO_RAD = PI / 180;
+constexpr float SQRT_3 = 1.7320508f;
+constexpr float SQRT_2PI = 2.5066283f;
+
+// Recovery particles stay this far inside the walls, where a robot can be
+constexpr float RECOVERY_MARGIN = 6;
+} // namespace
+
+MonteCarloLocalization::MonteCarloLocalization(MclConfig config, uint32_t seed)
+    : config(config),
+      rngState(seed != 0 ? seed : 1) {
+    reset(0, 0, 0);
+}
+
+void MonteCarloLocalization::reset(float xIn, float yIn, float thetaDeg) {
+    const float weightEach = 1.0f / PARTICLES;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        x[i] = xIn + config.initialSpread * gaussian();
+        y[i] = yIn + config.initialSpread * gaussian();
+        theta[i] = (thetaDeg + config.initialHeadingSpread * gaussian()) * DEG_TO_RAD;
+        weight[i] = weightEach;
+    }
+    lastBeamsUsed = 0;
+}
+
+void MonteCarloLocalization::predict(float forward, float right, float turn) {
+    const float distance = std::sqrt(forward * forward + right * right);
+    const float translationSigma = config.minTranslationNoise + config.translationNoise * distance;
+    const float rotationSigma =
+        (config.minRotationNoise + config.rotationNoise * std::fabs(turn)) * DEG_TO_RAD;
+    const float turnRad = turn * DEG_TO_RAD;
+
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        const float noisyForward = forward + translationSigma * gaussian();
+        const float noisyRight = right + translationSigma * gaussian();
+        const float sinT = std::sin(theta[i]);
+        const float cosT = std::cos(theta[i]);
+        // Compass frame: forward is (sin, cos), the robot's right is (cos, -sin)
+        x[i] += noisyForward * sinT + noisyRight * cosT;
+        y[i] += noisyForward * cosT - noisyRight * sinT;
+        theta[i] += turnRad + rotationSigma * gaussian();
+    }
+}
+
+uint32_t MonteCarloLocalization::correct(const std::array<DistanceBeam, MAX_BEAMS>& beams) {
+    uint32_t used = 0;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        sinTheta[i] = std::sin(theta[i]);
+        cosTheta[i] = std::cos(theta[i]);
+    }
+
+    for (std::size_t b = 0; b < MAX_BEAMS; b++) {
+        const DistanceBeam& beam = beams[b];
+        if (!beam.valid || beam.confidence < config.minConfidence || beam.range >= config.maxRange) {
+            continue;
+        }
+        used++;
+
+        const DistanceMount& mount = config.mounts[b];
+        const float sinMount = std::sin(mount.angle * DEG_TO_RAD);
+        const float cosMount = std::cos(mount.angle * DEG_TO_RAD);
+        const float sigma = config.rangeNoise + config.rangeNoiseFraction * beam.range;
+        const float inverseSigma = 1 / sigma;
+        const float hitScale = (1 - config.outlierProbability) / (sigma * SQRT_2PI);
+        const float outlier = config.outlierProbability / config.maxRange;
+
+        // Sensor origins and beam directions for every particle first, as
+        // plain streams, then the casts, then the weights
+        for (std::size_t i = 0; i < PARTICLES; i++) {
+            scratchX[i] = x[i] + mount.x * cosTheta[i] + mount.y * sinTheta[i];
+            scratchY[i] = y[i] - mount.x * sinTheta[i] + mount.y * cosTheta[i];
+        }
+        for (std::size_t i = 0; i < PARTICLES; i++) {
+            const float dx = sinTheta[i] * cosMount + cosTheta[i] * sinMount;
+            const float dy = cosTheta[i] * cosMount - sinTheta[i] * sinMount;
+            expectedRange[i] = FIELD.cast(scratchX[i], scratchY[i], dx, dy, config.maxRange);
+        }
+        for (std::size_t i = 0; i < PARTICLES; i++) {
+            const float z = (beam.range - expectedRange[i]) * inverseSigma;
+            weight[i] *= hitScale * std::exp(-0.5f * z * z) + outlier;
+        }
+    }
+    lastBeamsUsed = used;
+    if (used == 0) {
+        return 0;
+    }
+
+    float total = 0;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        total += weight[i];
+    }
+    if (!(total > 0) || !std::isfinite(total)) {
+        std::fill(weight.begin(), weight.end(), 1.0f / PARTICLES);
+        return used;
+    }
+    float sumSquares = 0;
+    const float inverseTotal = 1 / total;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        weight[i] *= inverseTotal;
+        sumSquares += weight[i] * weight[i];
+    }
+
+    const float effective = 1 / sumSquares;
+    if (effective < config.resampleThreshold * PARTICLES) {
+        resample();
+    }
+    return used;
+}
+
+MclEstimate MonteCarloLocalization::estimate() const {
+    // Every particle's heading descends from the same reset and the same
+    // turns, so a plain mean of the unbounded angles is safe
+    MclEstimate result;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        result.x += weight[i] * x[i];
+        result.y += weight[i] * y[i];
+        result.theta += weight[i] * theta[i];
+    }
+    float positionVariance = 0;
+    float headingVariance = 0;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        const float dx = x[i] - result.x;
+        const float dy = y[i] - result.y;
+        const float dTheta = theta[i] - result.theta;
+        positionVariance += weight[i] * (dx * dx + dy * dy);
+        headingVariance += weight[i] * dTheta * dTheta;
+    }
+    result.theta /= DEG_TO_RAD;
+    result.positionSpread = std::sqrt(positionVariance / 2);
+    result.headingSpread = std::sqrt(headingVariance) / DEG_TO_RAD;
+    result.beamsUsed = lastBeamsUsed;
+    return result;
+}
+
+void MonteCarloLocalization::resample() {
+    float meanTheta = 0;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        meanTheta += weight[i] * theta[i];
+    }
+
+    // Low-variance (systematic) resampling: one random offset, then even steps
+    const float step = 1.0f / PARTICLES;
+    float target = uniform() * step;
+    float cumulative = weight[0];
+    std::size_t source = 0;
+    for (std::size_t i = 0; i < PARTICLES; i++) {
+        while (target > cumulative && source + 1 < PARTICLES) {
+            source++;
+            cumulative += weight[source];
+        }
+        scratchX[i] = x[source];
+        scratchY[i] = y[source];
+        scratchTheta[i] = theta[source];
+        target += step;
+    }
+    x = scratchX;
+    y = scratchY;
+    theta = scratchTheta;
+    std::fill(weight.begin(), weight.end(), step);
+
+    // A few particles anywhere on the field let the cloud find the robot
+    // again after it is carried somewhere the odometry never saw
+    const std::size_t recovery = static_cast<std::size_t>(config.recoveryFraction * PARTICLES);
+    const float half = FIELD_INSIDE_WIDTH / 2 - RECOVERY_MARGIN;
+    for (std::size_t k = 0; k < recovery; k++) {
+        const std::size_t i = (k * PARTICLES) / recovery;
+        x[i] = (2 * uniform() - 1) * half;
+        y[i] = (2 * uniform() - 1) * half;
+        theta[i] = meanTheta + config.initialHeadingSpread * DEG_TO_RAD * gaussian();
+    }
+}
+
+float MonteCarloLocalization::uniform() {
+    // xorshift32; plenty for particle noise and cheap on the brain
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+float MonteCarloLocalization::gaussian() {
+    // Sum of four uniforms: close enough to normal, and no log or sqrt per sample
+    const float sum = uniform() + uniform() + uniform() + uniform();
+    return (sum - 2) * SQRT_3;
+}
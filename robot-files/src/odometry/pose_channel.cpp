@@ -0,0 +1,71 @@
+#include "odometry/pose_channel.hpp"
+
+#include <algorithm>
+
+namespace {
+float lerp(float from, float to, float t) { return from + (to - from) * t; }
+
+/**
+ * @brief Blends two poses; t = 0 gives older, t = 1 gives newer
+ */
+PoseSample interpolate(const PoseSample& older, const PoseSample& newer, uint64_t timestampUs) {
+    const float t = static_cast<float>(timestampUs - older.timestampUs) /
+                    static_cast<float>(newer.timestampUs - older.timestampUs);
+    PoseSample sample = newer;
+    sample.x = lerp(older.x, newer.x, t);
+    sample.y = lerp(older.y, newer.y, t);
+    // theta is unbounded in LemLib, so a plain blend never takes the long way round
+    sample.theta = lerp(older.theta, newer.theta, t);
+    sample.vx = lerp(older.vx, newer.vx, t);
+    sample.vy = lerp(older.vy, newer.vy, t);
+    sample.omega = lerp(older.omega, newer.omega, t);
+    sample.timestampUs = timestampUs;
+    return sample;
+}
+} // namespace
+
+void PoseChannel::publish(const lemlib::Pose& pose, const lemlib::Pose& velocity, uint64_t timestampUs) {
+    PoseSample sample;
+    sample.x = pose.x;
+    sample.y = pose.y;
+    sample.theta = pose.theta;
+    sample.vx = velocity.x;
+    sample.vy = velocity.y;
+    sample.omega = velocity.theta;
+    sample.timestampUs = timestampUs;
+    sample.sequence = ++sequence;
+    buffer.publish(sample);
+    history.publish(sample);
+}
+
+PoseSample PoseChannel::read() const { return buffer.read(); }
+
+PoseSample PoseChannel::sample_at(uint64_t timestampUs) const {
+    PoseSample newer;
+    if (!history.read(0, newer)) {
+        return read();
+    }
+
+    if (timestampUs >= newer.timestampUs) {
+        // Latency compensation: carry the newest pose forward at its velocity
+        const uint64_t aheadUs = std::min(timestampUs - newer.timestampUs, MAX_EXTRAPOLATION_US);
+        const float dt = aheadUs / 1e6f;
+        newer.x += newer.vx * dt;
+        newer.y += newer.vy * dt;
+        newer.theta += newer.omega * dt;
+        newer.timestampUs += aheadUs;
+        return newer;
+    }
+
+    for (std::size_t age = 1; age < HISTORY; age++) {
+        PoseSample older;
+        if (!history.read(age, older)) {
+            break;
+        }
+        if (older.timestampUs <= timestampUs) {
+            return older.timestampUs == newer.timestampUs ? newer : interpolate(older, newer, timestampUs);
+        }
+        newer = older;
+    }
+    return newer;
+}
@@ -0,0 +1,123 @@
+#include "odometry/relocalizer.hpp"
+
+#include <cmath>
+
+#include "constants.hpp"
+#include "globals.hpp"
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float MM_PER_INCH = 25.4f;
+constexpr int32_t NO_OBJECT_MM = 9999;      // what get_distance() returns with nothing in range
+constexpr int32_t MAX_CONFIDENCE = 63;      // get_confidence() full scale
+constexpr int32_t CONFIDENT_BELOW_MM = 200; // the sensor only grades confidence beyond this
+
+// A pose change this much larger than the velocities explain is a setPose
+constexpr float RESEED_DISTANCE = 6; // inches
+constexpr float RESEED_TURN = 15;    // degrees
+} // namespace
+
+Relocalizer::Relocalizer(const PoseChannel& poses, std::array<pros::Distance*, MAX_BEAMS> sensors, MclConfig config)
+    : poses(poses),
+      sensors(sensors),
+      filter(config),
+      last(),
+      loop(MCL_CONSTANTS::PERIOD_MS) {}
+
+void Relocalizer::start(uint32_t periodMs, uint32_t taskPriority) {
+    if (started.exchange(true)) {
+        return;
+    }
+    pros::Task::create(
+        [this, periodMs] {
+            loop = LoopTimer(periodMs);
+            loop.start();
+            while (true) {
+                step();
+                loop.wait();
+            }
+        },
+        taskPriority, TASK_STACK_DEPTH_DEFAULT, "relocalizer");
+}
+
+MclCorrection Relocalizer::correction() const { return published.read(); }
+
+LoopStats Relocalizer::loop_stats() const { return loop.stats(); }
+
+void Relocalizer::step() {
+    const std::array<DistanceBeam, MAX_BEAMS> beams = read_beams();
+    const uint64_t readUs = pros::micros();
+
+    // Where the odometry had the robot when the sensors were read
+    const PoseSample now = poses.sample_at(readUs);
+    if (now.sequence == 0) {
+        return;
+    }
+    if (!seeded) {
+        filter.reset(now.x, now.y, now.theta);
+        last = now;
+        seeded = true;
+        return;
+    }
+
+    // Distance travelled in the robot frame of the last step, from the mean
+    // of the two velocities (trapezoidal), which corrections never touch
+    const float dt = (now.timestampUs - last.timestampUs) / 1e6f;
+    const float vx = (now.vx + last.vx) / 2;
+    const float vy = (now.vy + last.vy) / 2;
+    const float turn = (now.omega + last.omega) / 2 * dt;
+    const float sinT = std::sin(last.theta * PI / 180);
+    const float cosT = std::cos(last.theta * PI / 180);
+    const float forward = (vx * sinT + vy * cosT) * dt;
+    const float right = (vx * cosT - vy * sinT) * dt;
+
+    const float unexplained = std::hypot(now.x - last.x - vx * dt, now.y - last.y - vy * dt);
+    const float unexplainedTurn = std::fabs(now.theta - last.theta - turn);
+    last = now;
+    if (unexplained > RESEED_DISTANCE || unexplainedTurn > RESEED_TURN) {
+        filter.reset(now.x, now.y, now.theta);
+        return;
+    }
+
+    filter.predict(forward, right, turn);
+    if (filter.correct(beams) == 0) {
+        return;
+    }
+
+    const MclEstimate estimate = filter.estimate();
+    MclCorrection correction;
+    correction.dx = estimate.x - now.x;
+    correction.dy = estimate.y - now.y;
+    correction.dtheta = estimate.theta - now.theta;
+    correction.positionSpread = estimate.positionSpread;
+    correction.headingSpread = estimate.headingSpread;
+    correction.beamsUsed = estimate.beamsUsed;
+    correction.timestampUs = readUs;
+    correction.sequence = ++sequence;
+    published.publish(correction);
+    globals::telemetry.log<LogLevel::INFO, RecordId::MCL_CORRECTION>(
+        correction.dx, correction.dy, correction.dtheta, correction.positionSpread, correction.beamsUsed);
+}
+
+std::array<DistanceBeam, Relocalizer::MAX_BEAMS> Relocalizer::read_beams() {
+    std::array<DistanceBeam, MAX_BEAMS> beams;
+    for (std::size_t i = 0; i < MAX_BEAMS; i++) {
+        if (sensors[i] == nullptr) {
+            continue;
+        }
+        const int32_t distance = sensors[i]->get_distance();
+        if (distance == PROS_ERR || distance >= NO_OBJECT_MM) {
+            continue;
+        }
+        const int32_t confidence = distance < CONFIDENT_BELOW_MM ? MAX_CONFIDENCE : sensors[i]->get_confidence();
+        if (confidence == PROS_ERR) {
+            continue;
+        }
+        beams[i].range = distance / MM_PER_INCH;
+        beams[i].confidence = static_cast<float>(confidence) / MAX_CONFIDENCE;
+        beams[i].valid = true;
+    }
+    return beams;
+}
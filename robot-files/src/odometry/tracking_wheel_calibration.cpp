@@ -0,0 +1,136 @@
+#include "odometry/tracking_wheel_calibration.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "pros/misc.hpp"
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float DEG_TO_RAD = PI / 180;
+
+// Less turning than a full turn leaves the offsets at the mercy of sensor noise
+constexpr float MIN_TOTAL_TURN = 2 * PI;
+// A fitted diameter further than this from nominal means a bad run, not a worn wheel
+constexpr float MAX_DIAMETER_CHANGE = 0.1f;
+
+/**
+ * @brief Wheel revolutions per radian turned, least squares through the origin
+ */
+float revolutions_per_radian(const WheelTravel* spins, std::size_t count, bool vertical) {
+    float numerator = 0;
+    float denominator = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const float revolutions = (vertical ? spins[i].verticalDeg : spins[i].horizontalDeg) / 360;
+        const float turn = spins[i].turnDeg * DEG_TO_RAD;
+        numerator += revolutions * turn;
+        denominator += turn * turn;
+    }
+    return denominator > 0 ? numerator / denominator : 0;
+}
+} // namespace
+
+TrackingWheelFit fit_tracking_wheels(const WheelTravel* spins, std::size_t spinCount, const WheelTravel* line,
+                                     float lineDistance, EkfWheel nominalVertical, EkfWheel nominalHorizontal) {
+    TrackingWheelFit fit;
+    fit.vertical = nominalVertical;
+    fit.horizontal = nominalHorizontal;
+
+    float totalTurn = 0;
+    for (std::size_t i = 0; i < spinCount; i++) {
+        totalTurn += std::fabs(spins[i].turnDeg) * DEG_TO_RAD;
+    }
+    if (totalTurn < MIN_TOTAL_TURN || nominalVertical.diameter <= 0) {
+        return fit;
+    }
+
+    // Spinning rolls a wheel -offset inches per radian: revolutions = -offset * turn / (pi * D)
+    const float verticalRate = revolutions_per_radian(spins, spinCount, true);
+    const float horizontalRate = revolutions_per_radian(spins, spinCount, false);
+
+    // Driving straight rolls it the line plus whatever the robot turned on the way:
+    // pi * D * revolutions = distance - offset * turn, with offset = -rate * pi * D
+    float scale = 1;
+    if (line != nullptr && lineDistance > 0) {
+        const float revolutions = line->verticalDeg / 360 - verticalRate * line->turnDeg * DEG_TO_RAD;
+        if (revolutions > 0) {
+            scale = lineDistance / (PI * nominalVertical.diameter * revolutions);
+            fit.diameterFitted = true;
+        }
+    }
+    if (std::fabs(scale - 1) > MAX_DIAMETER_CHANGE) {
+        return fit;
+    }
+
+    fit.vertical.diameter = nominalVertical.diameter * scale;
+    fit.horizontal.diameter = nominalHorizontal.diameter * scale;
+    fit.vertical.offset = -verticalRate * PI * fit.vertical.diameter;
+    fit.horizontal.offset = -horizontalRate * PI * fit.horizontal.diameter;
+
+    float squares = 0;
+    for (std::size_t i = 0; i < spinCount; i++) {
+        const float turn = spins[i].turnDeg * DEG_TO_RAD;
+        const float verticalError = spins[i].verticalDeg / 360 * PI * fit.vertical.diameter + fit.vertical.offset * turn;
+        const float horizontalError =
+            spins[i].horizontalDeg / 360 * PI * fit.horizontal.diameter + fit.horizontal.offset * turn;
+        squares += verticalError * verticalError + horizontalError * horizontalError;
+    }
+    fit.spinResidual = std::sqrt(squares / (2 * spinCount));
+    fit.valid = true;
+    return fit;
+}
+
+bool save_tracking_wheels(const char* path, const TrackingWheelFit& fit) {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "# Tracking wheel calibration, loaded at startup. Delete to use CHASIS_VALUES.\n");
+    std::fprintf(file, "# diameter %s, spin residual %.3f in\n", fit.diameterFitted ? "fitted" : "nominal",
+                 fit.spinResidual);
+    std::fprintf(file, "vertical %.4f %.4f\n", fit.vertical.diameter, fit.vertical.offset);
+    std::fprintf(file, "horizontal %.4f %.4f\n", fit.horizontal.diameter, fit.horizontal.offset);
+    return std::fclose(file) == 0;
+}
+
+bool load_tracking_wheels(const char* path, EkfWheel& vertical, EkfWheel& horizontal) {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+
+    EkfWheel loadedVertical = vertical;
+    EkfWheel loadedHorizontal = horizontal;
+    bool haveVertical = false;
+    bool haveHorizontal = false;
+    char line[120];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        char name[16];
+        float diameter, offset;
+        if (line[0] == '#' || std::sscanf(line, "%15s %f %f", name, &diameter, &offset) != 3 || diameter <= 0) {
+            continue;
+        }
+        if (std::strcmp(name, "vertical") == 0) {
+            loadedVertical = {diameter, offset};
+            haveVertical = true;
+        } else if (std::strcmp(name, "horizontal") == 0) {
+            loadedHorizontal = {diameter, offset};
+            haveHorizontal = true;
+        }
+    }
+    std::fclose(file);
+
+    if (!haveVertical || !haveHorizontal) {
+        return false;
+    }
+    vertical = loadedVertical;
+    horizontal = loadedHorizontal;
+    return true;
+}
@@ -0,0 +1,66 @@
+#include "odometry/warm_start.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "pros/misc.hpp"
+
+namespace {
+/**
+ * @brief FNV-1a over the record up to its checksum
+ */
+uint32_t checksum(const WarmStartRecord& record) {
+    uint8_t bytes[offsetof(WarmStartRecord, checksum)];
+    std::memcpy(bytes, &record, sizeof(bytes));
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : bytes) {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+} // namespace
+
+float StillnessCheck::mean() const { return samples > 0 ? static_cast<float>(sum / samples) : 0; }
+
+float StillnessCheck::deviation() const {
+    if (samples < 2) {
+        return 0;
+    }
+    const double m = sum / samples;
+    return static_cast<float>(std::sqrt(std::fmax(0.0, sumSquares / samples - m * m)));
+}
+
+bool save_warm_start(const char* path, WarmStartRecord record) {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    record.magic = WarmStartRecord::MAGIC;
+    record.version = WarmStartRecord::VERSION;
+    record.checksum = checksum(record);
+    const bool written = std::fwrite(&record, sizeof(record), 1, file) == 1;
+    return std::fclose(file) == 0 && written;
+}
+
+bool load_warm_start(const char* path, WarmStartRecord& record) {
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    WarmStartRecord loaded;
+    const bool read = std::fread(&loaded, sizeof(loaded), 1, file) == 1;
+    std::fclose(file);
+    if (!read || loaded.magic != WarmStartRecord::MAGIC || loaded.version != WarmStartRecord::VERSION ||
+        loaded.checksum != checksum(loaded)) {
+        return false;
+    }
+    record = loaded;
+    return true;
+}
@@ -0,0 +1,4 @@
+#include "scheduler/clock.hpp"
+#include "pros/rtos.hpp"
+
+uint64_t ProsClock::now_us() { return pros::micros(); }
@@ -0,0 +1,87 @@
+#include "scheduler/loop_timer.hpp"
+#include "pros/rtos.hpp"
+
+void LoopStats::record(uint32_t jitterUs, uint32_t bodyUs, bool overran, uint32_t skipped) {
+    ticks++;
+    if (overran) {
+        overruns++;
+    }
+    missedTicks += skipped;
+
+    lastJitterUs = jitterUs;
+    lastBodyUs = bodyUs;
+    if (jitterUs > maxJitterUs) {
+        maxJitterUs = jitterUs;
+    }
+    if (bodyUs > maxBodyUs) {
+        maxBodyUs = bodyUs;
+    }
+    totalJitterUs += jitterUs;
+    totalBodyUs += bodyUs;
+
+    jitterHistogram[bucket_for(jitterUs)]++;
+}
+
+void LoopStats::reset() {
+    *this = LoopStats();
+}
+
+uint32_t LoopStats::mean_jitter_us() const {
+    return ticks == 0 ? 0 : static_cast<uint32_t>(totalJitterUs / ticks);
+}
+
+uint32_t LoopStats::mean_body_us() const {
+    return ticks == 0 ? 0 : static_cast<uint32_t>(totalBodyUs / ticks);
+}
+
+std::size_t LoopStats::bucket_for(uint32_t jitterUs) {
+    for (std::size_t i = 0; i < JITTER_BUCKET_EDGES_US.size(); i++) {
+        if (jitterUs < JITTER_BUCKET_EDGES_US[i]) {
+            return i;
+        }
+    }
+    return JITTER_BUCKETS - 1;
+}
+
+LoopTimer::LoopTimer(uint32_t periodMs)
+    : periodMs(periodMs),
+      wakeMs(0),
+      deadlineUs(0),
+      tickStartUs(0) {}
+
+void LoopTimer::start() {
+    // One read for both clocks, so the ms anchor and the us deadline agree
+    tickStartUs = pros::micros();
+    deadlineUs = tickStartUs;
+    wakeMs = static_cast<uint32_t>(tickStartUs / 1000);
+}
+
+void LoopTimer::wait() {
+    const uint64_t periodUs = static_cast<uint64_t>(periodMs) * 1000;
+    const uint64_t endUs = pros::micros();
+    const uint32_t bodyUs = static_cast<uint32_t>(endUs - tickStartUs);
+
+    // If the body ran past the next deadline, drop every period that is already
+    // fully in the past so delay_until does not fire a burst of catch-up ticks
+    const uint64_t nextDeadlineUs = deadlineUs + periodUs;
+    const bool overran = endUs > nextDeadlineUs;
+    uint32_t skipped = 0;
+    if (overran) {
+        skipped = static_cast<uint32_t>((endUs - nextDeadlineUs) / periodUs);
+        wakeMs += skipped * periodMs;
+    }
+
+    pros::Task::delay_until(&wakeMs, periodMs);
+
+    deadlineUs += periodUs * (skipped + 1);
+    tickStartUs = pros::micros();
+    const uint32_t jitterUs = tickStartUs > deadlineUs ? static_cast<uint32_t>(tickStartUs - deadlineUs) : 0;
+
+    loopStats.record(jitterUs, bodyUs, overran, skipped);
+}
+
+LoopStats LoopTimer::stats() const { return loopStats; }
+
+void LoopTimer::reset_stats() { loopStats.reset(); }
+
+uint32_t LoopTimer::period() const { return periodMs; }
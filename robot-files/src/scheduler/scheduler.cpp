@@ -0,0 +1,65 @@
+#include "scheduler/scheduler.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+Scheduler::Scheduler(Clock& clock)
+    : clock(clock),
+      basePeriodMs(0) {}
+
+void Scheduler::add(const char* name, uint32_t periodMs, int priority, std::function<void()> callback) {
+    ScheduledEntry entry;
+    entry.name = name;
+    entry.periodMs = periodMs;
+    entry.priority = priority;
+    entry.callback = std::move(callback);
+    schedule.push_back(std::move(entry));
+
+    // Stable sort keeps registration order between equal priorities
+    std::stable_sort(schedule.begin(), schedule.end(),
+                     [](const ScheduledEntry& a, const ScheduledEntry& b) { return a.priority > b.priority; });
+
+    basePeriodMs = std::gcd(basePeriodMs, periodMs);
+}
+
+void Scheduler::reset() {
+    const uint64_t now = clock.now_us();
+    for (auto& entry : schedule) {
+        entry.nextDueUs = now;
+    }
+}
+
+uint32_t Scheduler::tick() {
+    // Due-ness is decided against the tick start so a slow entry cannot change
+    // which later entries run this tick
+    const uint64_t tickUs = clock.now_us();
+    uint32_t ran = 0;
+
+    for (auto& entry : schedule) {
+        if (tickUs < entry.nextDueUs) {
+            continue;
+        }
+
+        const uint64_t startUs = clock.now_us();
+        entry.callback();
+        const uint32_t execUs = static_cast<uint32_t>(clock.now_us() - startUs);
+
+        entry.runs++;
+        entry.lastExecUs = execUs;
+        entry.maxExecUs = std::max(entry.maxExecUs, execUs);
+
+        // Advance to the next deadline still in the future, counting any skipped
+        const uint64_t periodUs = static_cast<uint64_t>(entry.periodMs) * 1000;
+        const uint64_t behind = (tickUs - entry.nextDueUs) / periodUs;
+        entry.missed += static_cast<uint32_t>(behind);
+        entry.nextDueUs += periodUs * (behind + 1);
+        ran++;
+    }
+
+    return ran;
+}
+
+uint32_t Scheduler::base_period_ms() const { return basePeriodMs; }
+
+const std::vector<ScheduledEntry>& Scheduler::entries() const { return schedule; }
@@ -0,0 +1,53 @@
+#include "scheduler/scheduler_task.hpp"
+
+#include <utility>
+
+SchedulerTask::SchedulerTask(const char* name, uint32_t taskPriority)
+    : name(name),
+      taskPriority(taskPriority),
+      lane(clock),
+      loop(1),
+      running(false),
+      active(false) {}
+
+void SchedulerTask::add(const char* name, uint32_t periodMs, int priority, std::function<void()> callback) {
+    lane.add(name, periodMs, priority, std::move(callback));
+}
+
+void SchedulerTask::start() {
+    if (running) {
+        return;
+    }
+    // A stopped loop may still be sleeping in loop.wait(); a second one would
+    // share the Scheduler and the LoopTimer with it
+    wait_for_exit();
+    // Set before the task exists so a stop() racing with startup is not lost
+    running = true;
+    active = true;
+    pros::Task::create([this] { execute(); }, taskPriority, TASK_STACK_DEPTH_DEFAULT, name);
+}
+
+void SchedulerTask::execute() {
+    loop = LoopTimer(lane.base_period_ms());
+    lane.reset();
+    loop.start();
+    while (running) {
+        lane.tick();
+        loop.wait();
+    }
+    active = false;
+}
+
+void SchedulerTask::wait_for_exit() const {
+    while (active) {
+        pros::delay(1);
+    }
+}
+
+void SchedulerTask::stop() { running = false; }
+
+bool SchedulerTask::is_running() const { return running; }
+
+LoopStats SchedulerTask::loop_stats() const { return loop.stats(); }
+
+const Scheduler& SchedulerTask::scheduler() const { return lane; }
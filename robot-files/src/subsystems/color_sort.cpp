@@ -0,0 +1,178 @@
+#include "subsystems/color_sort.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "constants.hpp"
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+
+namespace {
+ColorGate make_gate() {
+    ColorGate gate;
+    gate.red = {static_cast<float>(VISION::RED::LOWER_BOUND), static_cast<float>(VISION::RED::UPPER_BOUND)};
+    gate.blue = {static_cast<float>(VISION::BLUE::LOWER_BOUND), static_cast<float>(VISION::BLUE::UPPER_BOUND)};
+    gate.minSaturation = static_cast<float>(COLOR_SORT_CONSTANTS::MIN_SATURATION);
+    gate.minProximity = COLOR_SORT_CONSTANTS::MIN_PROXIMITY;
+    return gate;
+}
+
+ConveyorConfig make_conveyor_config() {
+    ConveyorConfig config;
+    config.exitDistance = static_cast<float>(COLOR_SORT_CONSTANTS::EXIT_DISTANCE);
+    config.leadTime = COLOR_SORT_CONSTANTS::EJECT_LEAD_MS / 1000.0f;
+    return config;
+}
+} // namespace
+
+bool hue_in_band(float hue, HueBand band) {
+    hue = std::fmod(hue, 360.0f);
+    if (hue < 0) {
+        hue += 360;
+    }
+    if (band.lower <= band.upper) {
+        return hue >= band.lower && hue <= band.upper;
+    }
+    return hue >= band.lower || hue <= band.upper;
+}
+
+globals::SensorColors classify_color(float hue, float saturation, int32_t proximity, const ColorGate& gate) {
+    if (proximity < gate.minProximity || saturation < gate.minSaturation || !std::isfinite(hue)) {
+        return globals::SensorColors::NONE;
+    }
+    if (hue_in_band(hue, gate.red)) {
+        return globals::SensorColors::RED;
+    }
+    if (hue_in_band(hue, gate.blue)) {
+        return globals::SensorColors::BLUE;
+    }
+    return globals::SensorColors::NONE;
+}
+
+ColorSort::ColorSort(Intake& intake, EndEffector& endEffector)
+    : intake(intake),
+      endEffector(endEffector),
+      optical(PORT_VALUES::COLOR_SORT_OPTICAL),
+      gate(make_gate()),
+      conveyor(make_conveyor_config()),
+      loop(COLOR_SORT_CONSTANTS::PERIOD_MS) {}
+
+void ColorSort::start(uint32_t periodMs, uint32_t taskPriority) {
+    if (started.exchange(true)) {
+        return;
+    }
+    optical.set_integration_time(COLOR_SORT_CONSTANTS::INTEGRATION_TIME_MS);
+    optical.set_led_pwm(COLOR_SORT_CONSTANTS::LED_PWM);
+    pros::Task::create(
+        [this, periodMs] {
+            loop = LoopTimer(periodMs);
+            loop.start();
+            while (true) {
+                step();
+                loop.wait();
+            }
+        },
+        taskPriority, TASK_STACK_DEPTH_DEFAULT, "color sort");
+}
+
+ColorSortStats ColorSort::stats() const { return published.read(); }
+
+LoopStats ColorSort::loop_stats() const { return loop.stats(); }
+
+void ColorSort::step() {
+    const uint64_t nowUs = pros::micros();
+    const double beltPosition = endEffector.get_position() * COLOR_SORT_CONSTANTS::BELT_INCHES_PER_DEGREE;
+    conveyor.update(nowUs, static_cast<float>(beltPosition));
+    classify(nowUs);
+    run_pulses(nowUs);
+    published.publish(counters);
+}
+
+void ColorSort::classify(uint64_t nowUs) {
+    const int32_t proximity = optical.get_proximity();
+    const bool present = proximity != PROS_ERR && proximity >= gate.minProximity;
+
+    if (!present) {
+        if (tracking && !decided) {
+            counters.unclassified++;
+        }
+        tracking = false;
+        return;
+    }
+    if (!tracking) {
+        tracking = true;
+        decided = false;
+        arrivalUs = nowUs;
+        arrivalPosition = conveyor.position();
+        candidate = globals::SensorColors::NONE;
+        agreeing = 0;
+    }
+    if (decided) {
+        return;
+    }
+
+    const globals::SensorColors color = classify_color(static_cast<float>(optical.get_hue()),
+                                                       static_cast<float>(optical.get_saturation()), proximity, gate);
+    if (color == globals::SensorColors::NONE || color != candidate) {
+        candidate = color;
+        agreeing = color == globals::SensorColors::NONE ? 0 : 1;
+    } else {
+        agreeing++;
+    }
+    if (agreeing < COLOR_SORT_CONSTANTS::CONFIRM_SAMPLES) {
+        return;
+    }
+
+    decided = true;
+    const uint32_t latencyUs = static_cast<uint32_t>(nowUs - arrivalUs);
+    counters.pieces++;
+    counters.lastColor = color;
+    counters.lastLatencyUs = latencyUs;
+    counters.maxLatencyUs = std::max(counters.maxLatencyUs, latencyUs);
+    totalLatencyUs += latencyUs;
+    counters.meanLatencyUs = static_cast<uint32_t>(totalLatencyUs / counters.pieces);
+
+    const globals::SensorColors keep = globals::alliance;
+    const bool eject = keep != globals::SensorColors::NONE && color != keep;
+    globals::telemetry.log<LogLevel::INFO, RecordId::COLOR_PIECE>(static_cast<int32_t>(color), latencyUs, eject);
+    if (eject) {
+        // Followed from where the piece reached the sensor, so the belt
+        // travel while it was being classified still counts
+        if (!conveyor.add(arrivalPosition)) {
+            counters.dropped++;
+        }
+    }
+}
+
+void ColorSort::run_pulses(uint64_t nowUs) {
+    // A pulse pulls the pieces behind the ejected one back; any pulled past
+    // the sensor is treated as arriving again, and classified afresh
+    const std::size_t reversed = conveyor.drop_reversed();
+    if (reversed > 0) {
+        counters.reversed += reversed;
+        tracking = false;
+    }
+
+    if (conveyor.take_due()) {
+        counters.ejected++;
+        globals::telemetry.log<LogLevel::INFO, RecordId::COLOR_EJECT>(conveyor.velocity(),
+                                                                      static_cast<uint32_t>(conveyor.pending()));
+
+        // A piece close behind the last one stretches the pulse over both
+        pulseEndUs = nowUs + static_cast<uint64_t>(COLOR_SORT_CONSTANTS::EJECT_MS) * 1000;
+        if (!pulsing) {
+            pulsing = true;
+            endEffector.begin_eject(COLOR_SORT_CONSTANTS::ENDEFFECTOR_EJECT_POWER);
+            if (COLOR_SORT_CONSTANTS::EJECT_WITH_INTAKE) {
+                intake.begin_eject(COLOR_SORT_CONSTANTS::INTAKE_EJECT_POWER);
+            }
+        }
+    }
+    if (pulsing && nowUs >= pulseEndUs) {
+        pulsing = false;
+        endEffector.end_eject();
+        if (COLOR_SORT_CONSTANTS::EJECT_WITH_INTAKE) {
+            intake.end_eject();
+        }
+    }
+}
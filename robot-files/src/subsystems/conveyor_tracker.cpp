@@ -0,0 +1,59 @@
+#include "subsystems/conveyor_tracker.hpp"
+
+#include <algorithm>
+
+void ConveyorTracker::update(uint64_t timeUs, float position) {
+    history[historyHead] = {timeUs, position};
+    historyHead = (historyHead + 1) % HISTORY;
+    historyCount = std::min(historyCount + 1, HISTORY);
+    latestPosition = position;
+
+    // Difference against the newest sample at least a window old, so the
+    // motor's 10 ms position updates do not alias into the speed
+    const uint64_t windowUs = static_cast<uint64_t>(config.velocityWindow * 1e6f);
+    const Sample* reference = nullptr;
+    for (std::size_t age = 1; age < historyCount; age++) {
+        const Sample& sample = history[(historyHead + HISTORY - 1 - age) % HISTORY];
+        reference = &sample;
+        if (timeUs - sample.timeUs >= windowUs) {
+            break;
+        }
+    }
+    if (reference != nullptr && timeUs > reference->timeUs) {
+        latestVelocity = (position - reference->position) / ((timeUs - reference->timeUs) / 1e6f);
+    }
+}
+
+bool ConveyorTracker::add(float position) {
+    if (count == MAX_PIECES) {
+        return false;
+    }
+    pieces[(first + count) % MAX_PIECES] = position;
+    count++;
+    return true;
+}
+
+bool ConveyorTracker::take_due() {
+    if (count == 0) {
+        return false;
+    }
+    // Only forward motion is worth leading; a stopped or reversing belt brings the piece no closer
+    const float travel = latestPosition - pieces[first];
+    const float lead = std::max(latestVelocity, 0.0f) * config.leadTime;
+    if (travel + lead < config.exitDistance) {
+        return false;
+    }
+    first = (first + 1) % MAX_PIECES;
+    count--;
+    return true;
+}
+
+std::size_t ConveyorTracker::drop_reversed() {
+    // The newest piece is the one nearest the sensor
+    std::size_t dropped = 0;
+    while (count > 0 && latestPosition - pieces[(first + count - 1) % MAX_PIECES] < -config.reentryDistance) {
+        count--;
+        dropped++;
+    }
+    return dropped;
+}
@@ -1,5 +1,135 @@
 #include "subsystems/drivetrain.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "globals.hpp"
+#include "hardware/drive_units.hpp"
+#include "lemlib/chassis/odom.hpp" // for lemlib::getSpeed, lemlib::setPose
+#include "motion/drive_characterization.hpp"
+#include "motion/output_latency.hpp"
+#include "pros/error.h"
+#include "pros/misc.hpp"
+#include "scheduler/loop_timer.hpp"
+
+namespace {
+/**
+ * @brief The operator curve with these settings, or LemLib's default linear curve without USE_CURVES
+ */
+LutDriveCurve make_drive_curve(int deadband, int minOutput, double curve) {
+    if (!OPERATOR_CONSTANTS::USE_CURVES) {
+        // Same settings as lemlib::defaultDriveCurve: output equals input
+        return LutDriveCurve(0, 0, 1);
+    }
+    return LutDriveCurve(static_cast<float>(deadband), static_cast<float>(minOutput), static_cast<float>(curve));
+}
+
+GainSchedule<3> make_schedule(const double (&error)[3], const double (&scale)[3]) {
+    GainSchedule<3> schedule;
+    for (size_t i = 0; i < 3; i++) {
+        schedule.error[i] = static_cast<float>(error[i]);
+        schedule.scale[i] = static_cast<float>(scale[i]);
+    }
+    return schedule;
+}
+
+EkfConfig make_odometry_config() {
+    EkfConfig config;
+    config.vertical = {lemlib::Omniwheel::NEW_275, CHASIS_VALUES::LATERALTRACKING_WHEEL_OFFSET};
+    config.horizontal = {lemlib::Omniwheel::NEW_275, CHASIS_VALUES::HORIZONTALTRACKING_WHEEL_OFFSET};
+    config.trackWidth = CHASIS_VALUES::TRACKWIDTH;
+    config.motorInchesPerTick = inches_per_tick(lemlib::Omniwheel::NEW_4, CHASIS_VALUES::RPM, pros::MotorGears::blue);
+    config.wheelWindowMs = ODOMETRY_CONSTANTS::WHEEL_WINDOW_MS;
+    config.useGps = ODOMETRY_CONSTANTS::USE_GPS && PORT_VALUES::GPS != 0;
+    config.noise.trackingWheel = ODOMETRY_CONSTANTS::TRACKING_WHEEL_NOISE;
+    config.noise.motorEncoder = ODOMETRY_CONSTANTS::MOTOR_ENCODER_NOISE;
+    config.noise.imuHeading = ODOMETRY_CONSTANTS::IMU_HEADING_NOISE;
+    config.noise.gpsPosition = ODOMETRY_CONSTANTS::GPS_POSITION_NOISE;
+    config.noise.gpsHeading = ODOMETRY_CONSTANTS::GPS_HEADING_NOISE;
+    config.noise.gate = ODOMETRY_CONSTANTS::OUTLIER_GATE;
+    config.gyroSign = ODOMETRY_CONSTANTS::IMU_GYRO_SIGN;
+    config.heading.biasTimeConstant = ODOMETRY_CONSTANTS::GYRO_BIAS_TIME_CONSTANT;
+    config.heading.disagreeRate = ODOMETRY_CONSTANTS::GYRO_DISAGREE_RATE;
+    return config;
+}
+
+DistanceMount make_mount(const double (&mount)[3]) {
+    return {static_cast<float>(mount[0]), static_cast<float>(mount[1]), static_cast<float>(mount[2])};
+}
+
+MclConfig make_mcl_config() {
+    MclConfig config;
+    config.mounts = {make_mount(MCL_CONSTANTS::FRONT_MOUNT), make_mount(MCL_CONSTANTS::BACK_MOUNT),
+                     make_mount(MCL_CONSTANTS::LEFT_MOUNT), make_mount(MCL_CONSTANTS::RIGHT_MOUNT)};
+    return config;
+}
+
+CameraConfig make_camera_config() {
+    CameraConfig config;
+    config.x = static_cast<float>(VISION_TRACKER_CONSTANTS::MOUNT[0]);
+    config.y = static_cast<float>(VISION_TRACKER_CONSTANTS::MOUNT[1]);
+    config.angle = static_cast<float>(VISION_TRACKER_CONSTANTS::MOUNT[2]);
+    config.horizontalFov = static_cast<float>(VISION_TRACKER_CONSTANTS::HORIZONTAL_FOV);
+    config.imageWidth = static_cast<float>(VISION_TRACKER_CONSTANTS::IMAGE_WIDTH);
+    config.pieceWidth = static_cast<float>(VISION_TRACKER_CONSTANTS::PIECE_WIDTH);
+    config.minWidthPx = static_cast<float>(VISION_TRACKER_CONSTANTS::MIN_WIDTH_PX);
+    config.idMask = VISION_TRACKER_CONSTANTS::ID_MASK;
+    config.aiModel = VISION_TRACKER_CONSTANTS::USE_AI_MODEL;
+    config.frameLatencyUs = VISION_TRACKER_CONSTANTS::FRAME_LATENCY_MS * 1000;
+    return config;
+}
+
+PieceTrackerConfig make_piece_tracker_config() {
+    PieceTrackerConfig config;
+    config.gate = static_cast<float>(VISION_TRACKER_CONSTANTS::GATE);
+    config.smoothing = static_cast<float>(VISION_TRACKER_CONSTANTS::SMOOTHING);
+    config.confirmHits = VISION_TRACKER_CONSTANTS::CONFIRM_FRAMES;
+    config.timeoutUs = VISION_TRACKER_CONSTANTS::TRACK_TIMEOUT_MS * 1000;
+    return config;
+}
+
+constexpr bool HAS_AI_VISION = PORT_VALUES::AI_VISION != 0;
+
+constexpr bool HAS_DISTANCE_SENSORS = PORT_VALUES::DISTANCE_FRONT != 0 || PORT_VALUES::DISTANCE_BACK != 0 ||
+                                      PORT_VALUES::DISTANCE_LEFT != 0 || PORT_VALUES::DISTANCE_RIGHT != 0;
+
+// The odometry (or pose publisher) task hands the warm start saver a record every this many cycles
+constexpr uint32_t WARM_STATE_EVERY = 20;
+
+/**
+ * @brief Whether a record differs enough from the saved one to write it again
+ */
+bool worth_saving(const WarmStartRecord& record, const WarmStartRecord& saved) {
+    for (std::size_t i = 0; i < record.gyroBias.size(); i++) {
+        if (std::fabs(record.gyroBias[i] - saved.gyroBias[i]) > WARM_START_CONSTANTS::SAVE_BIAS_CHANGE) {
+            return true;
+        }
+    }
+    return std::fabs(record.x - saved.x) > WARM_START_CONSTANTS::SAVE_POSE_CHANGE ||
+           std::fabs(record.y - saved.y) > WARM_START_CONSTANTS::SAVE_POSE_CHANGE ||
+           std::fabs(record.theta - saved.theta) > WARM_START_CONSTANTS::SAVE_POSE_CHANGE ||
+           record.verticalOffset != saved.verticalOffset || record.horizontalOffset != saved.horizontalOffset;
+}
+
+constexpr float MM_PER_INCH = 25.4f;
+constexpr int32_t NO_OBJECT_MM = 9999; // what get_distance() returns with nothing in range
+
+// Move() units per degree the calibration line strays from its start heading
+constexpr float LINE_HEADING_KP = 2;
+
+/**
+ * @brief Whether a relocalizer correction is worth applying
+ */
+bool trusted(const MclCorrection& correction) {
+    return correction.beamsUsed >= static_cast<uint32_t>(MCL_CONSTANTS::MIN_BEAMS) &&
+           correction.positionSpread <= MCL_CONSTANTS::MAX_SPREAD;
+}
+} // namespace
+
 // Constructor: configure motors, sensors, controller settings, and lemlib chassis
 Drivetrain::Drivetrain(): 
 
@@ -15,17 +145,23 @@ Drivetrain::Drivetrain():
                     PORT_VALUES::RIGHT_3},
                     pros::MotorGears::blue
                 ),
+      leftOutput(leftMotorGroup, OPERATOR_CONSTANTS::DRIVE_KEEPALIVE_MS),
+      rightOutput(rightMotorGroup, OPERATOR_CONSTANTS::DRIVE_KEEPALIVE_MS),
       imu1(PORT_VALUES::IMU_1),
+      imu2(PORT_VALUES::IMU_2),
+      gps(PORT_VALUES::GPS),
+      distanceFront(PORT_VALUES::DISTANCE_FRONT),
+      distanceBack(PORT_VALUES::DISTANCE_BACK),
+      distanceLeft(PORT_VALUES::DISTANCE_LEFT),
+      distanceRight(PORT_VALUES::DISTANCE_RIGHT),
+      aiVision(PORT_VALUES::AI_VISION),
 
-      throttleCurve(
-                    OPERATOR_CONSTANTS::THROTTLE::DEADBAND,
-                    OPERATOR_CONSTANTS::THROTTLE::MIN,
-                    OPERATOR_CONSTANTS::THROTTLE::CURVE
-                    ),
-      steerCurve(OPERATOR_CONSTANTS::STEER::DEADBAND,
-                 OPERATOR_CONSTANTS::STEER::MIN,
-                 OPERATOR_CONSTANTS::STEER::CURVE
-                ),
+      throttleCurve(make_drive_curve(OPERATOR_CONSTANTS::THROTTLE::DEADBAND,
+                                     OPERATOR_CONSTANTS::THROTTLE::MIN,
+                                     OPERATOR_CONSTANTS::THROTTLE::CURVE)),
+      steerCurve(make_drive_curve(OPERATOR_CONSTANTS::STEER::DEADBAND,
+                                  OPERATOR_CONSTANTS::STEER::MIN,
+                                  OPERATOR_CONSTANTS::STEER::CURVE)),
 
       lateralController(DRIVETRAIN_CONSTANTS::LATERAL::KP,
                         DRIVETRAIN_CONSTANTS::LATERAL::KI,
@@ -57,7 +193,25 @@ Drivetrain::Drivetrain():
                               lemlib::Omniwheel::NEW_275,
                               CHASIS_VALUES::HORIZONTALTRACKING_WHEEL_OFFSET
                             ),
-      sensors(nullptr, nullptr, nullptr, nullptr, nullptr),
+      verticalGeometry{lemlib::Omniwheel::NEW_275, CHASIS_VALUES::LATERALTRACKING_WHEEL_OFFSET},
+      horizontalGeometry{lemlib::Omniwheel::NEW_275, CHASIS_VALUES::HORIZONTALTRACKING_WHEEL_OFFSET},
+      sensorHub(&leftMotorGroup,
+                &rightMotorGroup,
+                &verticalRotationSensor,
+                &horizontalRotationSensor,
+                &imu1,
+                PORT_VALUES::IMU_2 != 0 ? &imu2 : nullptr,
+                PORT_VALUES::GPS != 0 ? &gps : nullptr
+               ),
+      odometry(make_odometry_config()),
+      relocalizer(poseChannel,
+                  {PORT_VALUES::DISTANCE_FRONT != 0 ? &distanceFront : nullptr,
+                   PORT_VALUES::DISTANCE_BACK != 0 ? &distanceBack : nullptr,
+                   PORT_VALUES::DISTANCE_LEFT != 0 ? &distanceLeft : nullptr,
+                   PORT_VALUES::DISTANCE_RIGHT != 0 ? &distanceRight : nullptr},
+                  make_mcl_config()),
+      vision(poseChannel, aiVision, make_camera_config(), make_piece_tracker_config()),
+      sensors(&verticalTrackingWheel, nullptr, &horizontalTrackingWheel, nullptr, &imu1),
       drivetrain(&leftMotorGroup,
                  &rightMotorGroup,
                  CHASIS_VALUES::TRACKWIDTH,
@@ -65,39 +219,635 @@ Drivetrain::Drivetrain():
                  CHASIS_VALUES::RPM,
                  CHASIS_VALUES::HORIZONTAL_DRIFT
                 ),
-      chassis(drivetrain, lateralController, angularController, sensors) {}
+      chassis(drivetrain, lateralController, angularController, sensors, &throttleCurve, &steerCurve,
+              {DRIVETRAIN_CONSTANTS::LATERAL::MAX_VELOCITY,
+               DRIVETRAIN_CONSTANTS::LATERAL::MAX_ACCELERATION,
+               DRIVETRAIN_CONSTANTS::LATERAL::MAX_JERK},
+              {DRIVETRAIN_CONSTANTS::ANGULAR::MAX_VELOCITY,
+               DRIVETRAIN_CONSTANTS::ANGULAR::MAX_ACCELERATION,
+               DRIVETRAIN_CONSTANTS::ANGULAR::MAX_JERK},
+              {DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KS,
+               DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KV,
+               DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KA},
+              {DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KS,
+               DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KV,
+               DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KA},
+              RamseteController(DRIVETRAIN_CONSTANTS::RAMSETE::B, DRIVETRAIN_CONSTANTS::RAMSETE::ZETA),
+              {&sensorHub,
+               VOLTAGE_COMPENSATION_CONSTANTS::NOMINAL_MV,
+               VOLTAGE_COMPENSATION_CONSTANTS::MIN_MV,
+               make_schedule(DRIVETRAIN_CONSTANTS::LATERAL::GAIN_SCHEDULE_ERROR,
+                             DRIVETRAIN_CONSTANTS::LATERAL::GAIN_SCHEDULE_SCALE),
+               make_schedule(DRIVETRAIN_CONSTANTS::ANGULAR::GAIN_SCHEDULE_ERROR,
+                             DRIVETRAIN_CONSTANTS::ANGULAR::GAIN_SCHEDULE_SCALE)},
+              {VOLTAGE_DRIVE_CONSTANTS::KP,
+               VOLTAGE_DRIVE_CONSTANTS::KI,
+               VOLTAGE_DRIVE_CONSTANTS::INTEGRAL_LIMIT}
+             ) {}
 
 void Drivetrain::init() {
+    load_tracking_wheel_geometry();
+
     // Set motor brake modes
     leftMotorGroup.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
     rightMotorGroup.set_brake_mode_all(pros::E_MOTOR_BRAKE_COAST);
 
-    // Calibrate the chassis (IMU and odometry)
-    chassis.calibrate();
+    // Tracking wheels report at their fastest rate for either odometry
+    verticalRotationSensor.set_data_rate(ODOMETRY_CONSTANTS::ROTATION_DATA_RATE_MS);
+    horizontalRotationSensor.set_data_rate(ODOMETRY_CONSTANTS::ROTATION_DATA_RATE_MS);
+
+    // The EKF replaces LemLib's odometry task, which would fight it over the pose
+    if (ODOMETRY_CONSTANTS::USE_EKF) {
+        chassis.setPoseEstimator(&odometry);
+    }
+    WarmStartRecord warmStart;
+    if (try_warm_start(warmStart)) {
+        // The IMUs kept their calibration, so LemLib only has to start its odometry
+        if (!ODOMETRY_CONSTANTS::USE_EKF) {
+            chassis.calibrate(false);
+        }
+        chassis.setPose(warmStart.x, warmStart.y, warmStart.theta);
+    } else {
+        calibrate_imus_in_background();
+    }
+    load_tuned_gains();
+    if (VOLTAGE_DRIVE_CONSTANTS::ENABLED) {
+        chassis.setOutputMode(OutputMode::VOLTAGE);
+    }
+
+    // Start sampling every drivetrain sensor once per cycle
+    sensorHub.start(SENSOR_HUB_CONSTANTS::PERIOD_MS,
+                    TASK_PRIORITY_DEFAULT + SENSOR_HUB_CONSTANTS::TASK_PRIORITY_OFFSET);
+
+    // Only the EKF can take the corrections: LemLib updates its pose unlocked,
+    // so writing it from another task could lose a correction or tear x/y
+    if (ODOMETRY_CONSTANTS::USE_EKF && HAS_DISTANCE_SENSORS) {
+        relocalizer.start(MCL_CONSTANTS::PERIOD_MS, TASK_PRIORITY_DEFAULT + MCL_CONSTANTS::TASK_PRIORITY_OFFSET);
+    }
+    if (HAS_AI_VISION) {
+        vision.start(VISION_TRACKER_CONSTANTS::PERIOD_MS,
+                     TASK_PRIORITY_DEFAULT + VISION_TRACKER_CONSTANTS::TASK_PRIORITY_OFFSET);
+    }
+
+    if (ODOMETRY_CONSTANTS::USE_EKF) {
+        // The filter owns the pose: each update is pushed into LemLib, so
+        // getPose() and LemLib's own motions see it, and into the channel
+        pros::Task::create(
+            [this] {
+                LoopTimer loop(ODOMETRY_CONSTANTS::PERIOD_MS);
+                loop.start();
+                uint32_t lastCorrection = 0;
+                uint32_t cycles = 0;
+                while (true) {
+                    const SensorSnapshot snapshot = sensorHub.snapshot();
+                    odometry.update(snapshot);
+
+                    // Each relocalizer correction is one more pose measurement
+                    const MclCorrection correction = relocalizer.correction();
+                    if (correction.sequence != lastCorrection) {
+                        lastCorrection = correction.sequence;
+                        if (trusted(correction)) {
+                            const lemlib::Pose current = odometry.pose();
+                            odometry.correct_pose(
+                                lemlib::Pose(current.x + correction.dx, current.y + correction.dy,
+                                             current.theta + correction.dtheta),
+                                std::max<float>(correction.positionSpread, MCL_CONSTANTS::POSITION_NOISE_FLOOR),
+                                std::max<float>(correction.headingSpread, MCL_CONSTANTS::HEADING_NOISE_FLOOR));
+                        }
+                    }
+
+                    const lemlib::Pose pose = odometry.pose();
+                    lemlib::setPose(pose);
+                    poseChannel.publish(pose, odometry.velocity(), snapshot.timestampUs);
+                    globals::telemetry.log<LogLevel::DEBUG, RecordId::EKF_POSE>(
+                        static_cast<float>(pose.x), static_cast<float>(pose.y), static_cast<float>(pose.theta));
+
+                    if (++cycles % WARM_STATE_EVERY == 0) {
+                        WarmStartRecord record;
+                        for (std::size_t i = 0; i < record.gyroBias.size(); i++) {
+                            record.gyroBias[i] = odometry.gyro_bias(i);
+                        }
+                        record.verticalOffset = verticalGeometry.offset;
+                        record.horizontalOffset = horizontalGeometry.offset;
+                        record.x = pose.x;
+                        record.y = pose.y;
+                        record.theta = pose.theta;
+                        warmState.publish(record);
+                    }
+                    loop.wait();
+                }
+            },
+            TASK_PRIORITY_DEFAULT + ODOMETRY_CONSTANTS::TASK_PRIORITY_OFFSET, TASK_STACK_DEPTH_DEFAULT, "ekf odometry");
+        if (WARM_START_CONSTANTS::ENABLED) {
+            start_warm_start_saver();
+        }
+        return;
+    }
+
+    // LemLib's odometry runs inside the library, so mirror each update into the
+    // channel from one task; every other pose reader then reads the channel
+    pros::Task::create(
+        [this] {
+            LoopTimer loop(POSE_CHANNEL_CONSTANTS::PERIOD_MS);
+            loop.start();
+            uint32_t cycles = 0;
+            while (true) {
+                const lemlib::Pose pose = chassis.getPose();
+                poseChannel.publish(pose, lemlib::getSpeed(), pros::micros());
+
+                // LemLib keeps no gyro bias of its own: the record's biases stay
+                // 0, so a warm start checks the IMUs still hold their calibration
+                if (++cycles % WARM_STATE_EVERY == 0) {
+                    WarmStartRecord record;
+                    record.verticalOffset = verticalGeometry.offset;
+                    record.horizontalOffset = horizontalGeometry.offset;
+                    record.x = pose.x;
+                    record.y = pose.y;
+                    record.theta = pose.theta;
+                    warmState.publish(record);
+                }
+                loop.wait();
+            }
+        },
+        TASK_PRIORITY_DEFAULT + POSE_CHANNEL_CONSTANTS::TASK_PRIORITY_OFFSET, TASK_STACK_DEPTH_DEFAULT,
+        "pose publisher");
+    if (WARM_START_CONSTANTS::ENABLED) {
+        start_warm_start_saver();
+    }
 }
 
-void Drivetrain::drive() {
-    // Use the shared global controller for input
-    auto& master = globals::controller;
+void Drivetrain::drive(const InputFrame& input) {
+    // Get joystick values from this tick's snapshot
+    const int rawThrottle = input.axis(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+    const int rawTurn = input.axis(pros::E_CONTROLLER_ANALOG_RIGHT_X);
 
-    // Get joystick values
-    const int rawThrottle = master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
-    const int rawTurn = master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X);
+    // Same mixing as lemlib::Chassis::arcade (drive curves, then desaturation
+    // bias from constants), but written through the output caches so an
+    // unchanged stick position costs no motor writes
+    int throttle = throttleCurve.lookup(rawThrottle);
+    int turn = steerCurve.lookup(-rawTurn);
+    if (HAS_AI_VISION && input.is_held(CONTROLLER_BUTTONS::DRIVETRAIN::AIM_ASSIST)) {
+        turn = std::clamp(turn + aim_assist_turn(), -127, 127);
+    }
 
-    // Arcade drive using lemlib, with desaturation bias from constants
-    chassis.arcade(rawThrottle,
-                   -rawTurn,
-                   false, // disable built-in drive curve since we apply our own
-                   OPERATOR_CONSTANTS::DESATURATE_BIAS);
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        const int oldThrottle = throttle;
+        const int oldTurn = turn;
+        throttle *= (1 - OPERATOR_CONSTANTS::DESATURATE_BIAS * std::abs(oldTurn / 127.0));
+        turn *= (1 - (1 - OPERATOR_CONSTANTS::DESATURATE_BIAS) * std::abs(oldThrottle / 127.0));
+    }
+
+    if (VOLTAGE_DRIVE_CONSTANTS::ENABLED) {
+        leftOutput.move_voltage((throttle + turn) * 12000 / 127);
+        rightOutput.move_voltage((throttle - turn) * 12000 / 127);
+        return;
+    }
+    leftOutput.move(throttle + turn);
+    rightOutput.move(throttle - turn);
+}
+
+int Drivetrain::aim_assist_turn() {
+    const PoseSample pose = poseChannel.read();
+    VisionTarget target;
+    if (!vision.nearest(pose, VISION_TRACKER_CONSTANTS::AIM_MAX_BEARING, target)) {
+        return 0;
+    }
+    // The driver keeps the throttle and any turn of their own; this only nudges towards the piece
+    const double correction = VISION_TRACKER_CONSTANTS::AIM_KP * bearing_to(pose, target.x, target.y);
+    return static_cast<int>(
+        std::clamp(correction, -VISION_TRACKER_CONSTANTS::AIM_MAX_TURN, VISION_TRACKER_CONSTANTS::AIM_MAX_TURN));
 }
 
-void Drivetrain::run() {
+void Drivetrain::run(const InputFrame& input) {
     // Main run method to be called in the robot loop
-    drive();
+    drive(input);
+}
+
+bool Drivetrain::characterize() {
+    // Static: the log is far too big for a task stack
+    static DriveCharacterization characterization(leftMotorGroup, rightMotorGroup, sensorHub,
+                                                  drivetrain.wheelDiameter, drivetrain.rpm);
+    characterization.clear();
+
+    for (const bool forwards : {true, false}) {
+        characterization.run_quasistatic(forwards, CHARACTERIZATION_CONSTANTS::QUASISTATIC_VOLTS_PER_SECOND,
+                                         CHARACTERIZATION_CONSTANTS::QUASISTATIC_DURATION_MS,
+                                         CHARACTERIZATION_CONSTANTS::SAMPLE_PERIOD_MS);
+        pros::delay(CHARACTERIZATION_CONSTANTS::REST_MS);
+    }
+    for (const bool forwards : {true, false}) {
+        characterization.run_step(forwards, CHARACTERIZATION_CONSTANTS::STEP_VOLTS,
+                                  CHARACTERIZATION_CONSTANTS::STEP_DURATION_MS,
+                                  CHARACTERIZATION_CONSTANTS::SAMPLE_PERIOD_MS);
+        pros::delay(CHARACTERIZATION_CONSTANTS::REST_MS);
+    }
+
+    return characterization.save(CHARACTERIZATION_CONSTANTS::LOG_PATH);
+}
+
+bool Drivetrain::measure_output_latency() {
+    const SimpleMotorFeedforward leftFeedforward = {DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KS,
+                                                    DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KV,
+                                                    DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KA};
+    const SimpleMotorFeedforward rightFeedforward = {DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KS,
+                                                     DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KV,
+                                                     DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KA};
+    const VelocityLoopGains gains = {VOLTAGE_DRIVE_CONSTANTS::KP, VOLTAGE_DRIVE_CONSTANTS::KI,
+                                     VOLTAGE_DRIVE_CONSTANTS::INTEGRAL_LIMIT};
+    static OutputLatencyTest test(leftMotorGroup, rightMotorGroup, drivetrain.wheelDiameter, drivetrain.rpm,
+                                  VelocityLoop(leftFeedforward, gains), VelocityLoop(rightFeedforward, gains));
+    test.clear();
+
+    for (const OutputPath path : {OutputPath::MOTOR_VELOCITY, OutputPath::VOLTAGE}) {
+        for (int i = 0; i < LATENCY_CONSTANTS::TRIALS; i++) {
+            test.run_trial(path, i % 2 == 0, LATENCY_CONSTANTS::STEP_VELOCITY, LATENCY_CONSTANTS::TRIAL_MS,
+                           LATENCY_CONSTANTS::ONSET_DISTANCE);
+            pros::delay(LATENCY_CONSTANTS::REST_MS);
+        }
+    }
+    invalidate_output_cache();
+
+    for (const OutputPath path : {OutputPath::MOTOR_VELOCITY, OutputPath::VOLTAGE}) {
+        const LatencySummary summary = test.summary(path);
+        std::printf("%-8s onset %.1f ms (max %.0f, %zu/%zu)  rise %.1f ms (max %.0f, %zu/%zu)\n",
+                    path == OutputPath::VOLTAGE ? "voltage" : "velocity", summary.meanOnsetMs, summary.maxOnsetMs,
+                    summary.moved, summary.trials, summary.meanRiseMs, summary.maxRiseMs, summary.rose,
+                    summary.trials);
+    }
+    return test.save(LATENCY_CONSTANTS::LOG_PATH);
 }
 
-lemlib::Chassis& Drivetrain::get_chassis() { return chassis; }
+bool Drivetrain::calibrate_tracking_wheels() {
+    // get_rotation() is only as good as the IMU's own calibration, which a warm start skips
+    imu1.reset(true);
+    imu1.set_data_rate(ODOMETRY_CONSTANTS::IMU_DATA_RATE_MS);
+
+    // Alternating directions cancels any clockwise/counterclockwise scale difference of the IMU
+    std::array<WheelTravel, 2 * TRACKING_CALIBRATION_CONSTANTS::SPIN_TURNS> spins;
+    for (std::size_t i = 0; i < spins.size(); i++) {
+        spins[i] = measure_spin(i % 2 == 0 ? 360 : -360);
+    }
+
+    WheelTravel line;
+    float lineDistance = 0;
+    const bool haveLine = PORT_VALUES::DISTANCE_FRONT != 0 && measure_line(line, lineDistance);
+    invalidate_output_cache();
+
+    const TrackingWheelFit fit = fit_tracking_wheels(spins.data(), spins.size(), haveLine ? &line : nullptr,
+                                                     lineDistance, verticalGeometry, horizontalGeometry);
+    std::printf("tracking wheels: vertical %.4f in @ %.3f, horizontal %.4f in @ %.3f, residual %.3f in (%s%s)\n",
+                fit.vertical.diameter, fit.vertical.offset, fit.horizontal.diameter, fit.horizontal.offset,
+                fit.spinResidual, fit.diameterFitted ? "diameter fitted" : "nominal diameter",
+                fit.valid ? "" : ", rejected");
+    return fit.valid && save_tracking_wheels(TRACKING_CALIBRATION_CONSTANTS::PATH, fit);
+}
+
+WheelTravel Drivetrain::measure_spin(float degrees) {
+    const int32_t startVertical = verticalRotationSensor.get_position();
+    const int32_t startHorizontal = horizontalRotationSensor.get_position();
+    const double startTurn = imu1.get_rotation();
+
+    const float power = std::copysign(static_cast<float>(TRACKING_CALIBRATION_CONSTANTS::SPIN_POWER), degrees);
+    leftMotorGroup.move(power);
+    rightMotorGroup.move(-power);
+    const uint32_t startMs = pros::millis();
+    while (std::fabs(imu1.get_rotation() - startTurn) < std::fabs(degrees) &&
+           pros::millis() - startMs < static_cast<uint32_t>(TRACKING_CALIBRATION_CONSTANTS::SEGMENT_TIMEOUT_MS)) {
+        pros::delay(10);
+    }
+    leftMotorGroup.move(0);
+    rightMotorGroup.move(0);
+
+    // The robot coasts on after the motors stop; whatever it ends up turning is what gets fitted
+    pros::delay(TRACKING_CALIBRATION_CONSTANTS::SETTLE_MS);
+    WheelTravel travel;
+    travel.verticalDeg = (verticalRotationSensor.get_position() - startVertical) / 100.0f;
+    travel.horizontalDeg = (horizontalRotationSensor.get_position() - startHorizontal) / 100.0f;
+    travel.turnDeg = static_cast<float>(imu1.get_rotation() - startTurn);
+    return travel;
+}
+
+bool Drivetrain::measure_line(WheelTravel& travel, float& distance) {
+    const int32_t startVertical = verticalRotationSensor.get_position();
+    const int32_t startHorizontal = horizontalRotationSensor.get_position();
+    const double startTurn = imu1.get_rotation();
+
+    bool reached = false;
+    const uint32_t startMs = pros::millis();
+    while (pros::millis() - startMs < static_cast<uint32_t>(TRACKING_CALIBRATION_CONSTANTS::SEGMENT_TIMEOUT_MS)) {
+        const int32_t gap = distanceFront.get_distance();
+        if (gap == PROS_ERR || gap >= NO_OBJECT_MM) {
+            break;
+        }
+        if (gap / MM_PER_INCH <= TRACKING_CALIBRATION_CONSTANTS::LINE_STOP_GAP) {
+            reached = true;
+            break;
+        }
+        // Hold the start heading; the fit accounts for what turning is left
+        const float steer = LINE_HEADING_KP * static_cast<float>(imu1.get_rotation() - startTurn);
+        leftMotorGroup.move(TRACKING_CALIBRATION_CONSTANTS::LINE_POWER - steer);
+        rightMotorGroup.move(TRACKING_CALIBRATION_CONSTANTS::LINE_POWER + steer);
+        pros::delay(10);
+    }
+    leftMotorGroup.move(0);
+    rightMotorGroup.move(0);
+    pros::delay(TRACKING_CALIBRATION_CONSTANTS::SETTLE_MS);
+
+    const int32_t gap = distanceFront.get_distance();
+    if (!reached || gap == PROS_ERR || gap >= NO_OBJECT_MM) {
+        return false;
+    }
+    travel.verticalDeg = (verticalRotationSensor.get_position() - startVertical) / 100.0f;
+    travel.horizontalDeg = (horizontalRotationSensor.get_position() - startHorizontal) / 100.0f;
+    travel.turnDeg = static_cast<float>(imu1.get_rotation() - startTurn);
+    distance = TRACKING_CALIBRATION_CONSTANTS::LINE_START_GAP - gap / MM_PER_INCH;
+    return true;
+}
+
+RelayResult Drivetrain::run_relay(bool angular) {
+    RelayAnalyzer relay(AUTOTUNE_CONSTANTS::RELAY_OUTPUT, angular ? AUTOTUNE_CONSTANTS::ANGULAR_HYSTERESIS
+                                                                  : AUTOTUNE_CONSTANTS::LATERAL_HYSTERESIS);
+    const lemlib::Pose start = chassis.getPose();
+    const float headingX = std::sin(lemlib::degToRad(start.theta));
+    const float headingY = std::cos(lemlib::degToRad(start.theta));
+
+    const uint32_t startMs = pros::millis();
+    uint32_t wakeMs = startMs;
+    while (pros::millis() - startMs < static_cast<uint32_t>(AUTOTUNE_CONSTANTS::RELAY_TIMEOUT_MS) &&
+           relay.cycles() < static_cast<size_t>(AUTOTUNE_CONSTANTS::MIN_CYCLES)) {
+        const lemlib::Pose pose = chassis.getPose();
+        const float time = (pros::millis() - startMs) / 1000.0f;
+
+        // Error from the start pose: along the start heading, or in heading
+        if (angular) {
+            const float output = relay.update(time, lemlib::angleError(start.theta, pose.theta, false));
+            leftMotorGroup.move(output);
+            rightMotorGroup.move(-output);
+        } else {
+            const float traveled = (pose.x - start.x) * headingX + (pose.y - start.y) * headingY;
+            const float output = relay.update(time, -traveled);
+            leftMotorGroup.move(output);
+            rightMotorGroup.move(output);
+        }
+        pros::Task::delay_until(&wakeMs, 10);
+    }
+
+    leftMotorGroup.move(0);
+    rightMotorGroup.move(0);
+    return relay.result();
+}
+
+bool Drivetrain::autotune() {
+    // Motor lag from characterization, shared by both axes
+    const float timeConstant =
+        (DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KA / DRIVETRAIN_CONSTANTS::FEEDFORWARD::LEFT::KV +
+         DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KA / DRIVETRAIN_CONSTANTS::FEEDFORWARD::RIGHT::KV) /
+        2;
+
+    struct Axis {
+        const char* name;
+        bool angular;
+        float step;
+        float tolerance;
+        PidGains gains;
+        RelayResult relay;
+        PlantModel plant;
+        StepMetrics metrics;
+    };
+    std::array<Axis, 2> axes = {{
+        {"lateral", false, AUTOTUNE_CONSTANTS::LATERAL_STEP, DRIVETRAIN_CONSTANTS::LATERAL::SMALL_ERROR, {}, {}, {}, {}},
+        {"angular", true, AUTOTUNE_CONSTANTS::ANGULAR_STEP, DRIVETRAIN_CONSTANTS::ANGULAR::SMALL_ERROR, {}, {}, {}, {}},
+    }};
+
+    for (Axis& axis : axes) {
+        axis.relay = run_relay(axis.angular);
+        if (!axis.relay.ok) {
+            return false;
+        }
+        axis.plant = identify_integrating_plant(axis.relay, timeConstant);
+
+        TuningGoal goal;
+        goal.step = axis.step;
+        goal.tolerance = axis.tolerance;
+        goal.maxOvershoot = AUTOTUNE_CONSTANTS::MAX_OVERSHOOT;
+        axis.gains = tune_pid(axis.plant, axis.relay, goal, &axis.metrics);
+        if (axis.gains.kP <= 0) {
+            return false;
+        }
+        pros::delay(1000); // let the robot come to rest before the next test
+    }
+
+    chassis.setLateralGains(axes[0].gains.kP, axes[0].gains.kI, axes[0].gains.kD);
+    chassis.setAngularGains(axes[1].gains.kP, axes[1].gains.kI, axes[1].gains.kD);
+
+    if (!pros::usd::is_installed()) {
+        return false;
+    }
+    FILE* file = std::fopen(AUTOTUNE_CONSTANTS::GAINS_PATH, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "# PID autotune result, loaded at startup. Delete to use DRIVETRAIN_CONSTANTS.\n");
+    for (const Axis& axis : axes) {
+        std::fprintf(file, "# %s: Ku=%.3f Tu=%.3fs K=%.4f tau=%.3fs L=%.3fs -> settle %.2fs, overshoot %.1f%%\n",
+                     axis.name, axis.relay.ultimateGain, axis.relay.period, axis.plant.gain, axis.plant.timeConstant,
+                     axis.plant.deadTime, axis.metrics.settleTime, axis.metrics.overshoot * 100);
+    }
+    for (const Axis& axis : axes) {
+        std::fprintf(file, "%s %.4f %.4f %.4f\n", axis.name, axis.gains.kP, axis.gains.kI, axis.gains.kD);
+    }
+    return std::fclose(file) == 0;
+}
+
+void Drivetrain::load_tuned_gains() {
+    if (!pros::usd::is_installed()) {
+        return;
+    }
+    FILE* file = std::fopen(AUTOTUNE_CONSTANTS::GAINS_PATH, "r");
+    if (file == nullptr) {
+        return;
+    }
+
+    char line[160];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        char name[16];
+        float kP, kI, kD;
+        if (line[0] == '#' || std::sscanf(line, "%15s %f %f %f", name, &kP, &kI, &kD) != 4) {
+            continue;
+        }
+        if (std::strcmp(name, "lateral") == 0) {
+            chassis.setLateralGains(kP, kI, kD);
+        } else if (std::strcmp(name, "angular") == 0) {
+            chassis.setAngularGains(kP, kI, kD);
+        }
+    }
+    std::fclose(file);
+}
+
+void Drivetrain::load_tracking_wheel_geometry() {
+    if (!load_tracking_wheels(TRACKING_CALIBRATION_CONSTANTS::PATH, verticalGeometry, horizontalGeometry)) {
+        return;
+    }
+    // OdomSensors points at these objects, so LemLib picks the new geometry up in place
+    verticalTrackingWheel =
+        lemlib::TrackingWheel(&verticalRotationSensor, verticalGeometry.diameter, verticalGeometry.offset);
+    horizontalTrackingWheel =
+        lemlib::TrackingWheel(&horizontalRotationSensor, horizontalGeometry.diameter, horizontalGeometry.offset);
+    odometry.set_wheels(verticalGeometry, horizontalGeometry);
+}
+
+void Drivetrain::calibrate_imus_in_background() {
+    // Both IMUs calibrate at once in the background. Until they are done their
+    // reads fail: the EKF's heading follows the wheels, and LemLib's odometry,
+    // which takes its heading from the IMU alone, is not started yet
+    imu1.reset(false);
+    if (PORT_VALUES::IMU_2 != 0) {
+        imu2.reset(false);
+    }
+    pros::Task::create(
+        [this] {
+            while (imu1.is_calibrating() || (PORT_VALUES::IMU_2 != 0 && imu2.is_calibrating())) {
+                pros::delay(10);
+            }
+            // The EKF reads the raw gyro rates, which only refresh as often as this allows
+            imu1.set_data_rate(ODOMETRY_CONSTANTS::IMU_DATA_RATE_MS);
+            if (PORT_VALUES::IMU_2 != 0) {
+                imu2.set_data_rate(ODOMETRY_CONSTANTS::IMU_DATA_RATE_MS);
+            }
+            if (!ODOMETRY_CONSTANTS::USE_EKF) {
+                chassis.calibrate(false);
+            }
+        },
+        TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "imu calibration");
+}
+
+bool Drivetrain::try_warm_start(WarmStartRecord& record) {
+    if (!WARM_START_CONSTANTS::ENABLED || !load_warm_start(WARM_START_CONSTANTS::PATH, record)) {
+        return false;
+    }
+    // Biases and pose tracked with other tracking wheel geometry do not carry over
+    if (record.verticalOffset != verticalGeometry.offset || record.horizontalOffset != horizontalGeometry.offset) {
+        return false;
+    }
+
+    // A gyro still calibrating (fresh power-on) fails its reads, which ends the check
+    const std::array<pros::Imu*, SensorSnapshot::MAX_IMUS> imus = {&imu1,
+                                                                    PORT_VALUES::IMU_2 != 0 ? &imu2 : nullptr};
+    for (pros::Imu* imu : imus) {
+        if (imu != nullptr) {
+            imu->set_data_rate(ODOMETRY_CONSTANTS::IMU_DATA_RATE_MS);
+        }
+    }
+    std::array<StillnessCheck, SensorSnapshot::MAX_IMUS> checks;
+    const uint32_t startMs = pros::millis();
+    while (pros::millis() - startMs < static_cast<uint32_t>(WARM_START_CONSTANTS::STILL_CHECK_MS)) {
+        for (std::size_t i = 0; i < imus.size(); i++) {
+            if (imus[i] == nullptr) {
+                continue;
+            }
+            const double rate = imus[i]->get_gyro_rate().z;
+            if (!std::isfinite(rate) || rate == PROS_ERR_F) {
+                return false;
+            }
+            checks[i].add(static_cast<float>(ODOMETRY_CONSTANTS::IMU_GYRO_SIGN * rate));
+        }
+        pros::delay(ODOMETRY_CONSTANTS::IMU_DATA_RATE_MS);
+    }
+
+    // The robot must be still, and each gyro's bias where it was left
+    for (std::size_t i = 0; i < imus.size(); i++) {
+        if (imus[i] != nullptr &&
+            (checks[i].deviation() > WARM_START_CONSTANTS::MAX_GYRO_DEVIATION ||
+             std::fabs(checks[i].mean() - record.gyroBias[i]) > WARM_START_CONSTANTS::MAX_BIAS_CHANGE)) {
+            return false;
+        }
+    }
+    if (ODOMETRY_CONSTANTS::USE_EKF) {
+        for (std::size_t i = 0; i < imus.size(); i++) {
+            if (imus[i] != nullptr) {
+                odometry.seed_gyro_bias(i, checks[i].mean());
+            }
+        }
+    }
+    return true;
+}
+
+void Drivetrain::start_warm_start_saver() {
+    // SD writes take milliseconds, so they happen here at the lowest
+    // priority and only when something worth keeping changed
+    pros::Task::create(
+        [this] {
+            WarmStartRecord saved;
+            bool haveSaved = false;
+            while (true) {
+                pros::delay(WARM_START_CONSTANTS::SAVE_PERIOD_MS);
+                if (warmState.count() == 0) {
+                    continue;
+                }
+                const WarmStartRecord record = warmState.read();
+                if (haveSaved && !worth_saving(record, saved)) {
+                    continue;
+                }
+                if (save_warm_start(WARM_START_CONSTANTS::PATH, record)) {
+                    saved = record;
+                    haveSaved = true;
+                }
+            }
+        },
+        TASK_PRIORITY_MIN, TASK_STACK_DEPTH_DEFAULT, "warm start saver");
+}
+
+bool Drivetrain::drive_to_nearest_piece(int timeoutMs) {
+    VisionTarget target;
+    if (!HAS_AI_VISION ||
+        !vision.nearest(poseChannel.read(), VISION_TRACKER_CONSTANTS::DRIVE_MAX_BEARING, target)) {
+        return false;
+    }
+
+    lemlib::MoveToPointParams params;
+    params.maxSpeed = VISION_TRACKER_CONSTANTS::DRIVE_MAX_SPEED;
+    const uint32_t startMs = pros::millis();
+    chassis.moveToPoint(target.x, target.y, timeoutMs, params);
+    while (chassis.isInMotion()) {
+        pros::delay(VISION_TRACKER_CONSTANTS::PERIOD_MS);
+
+        // The estimate sharpens as the robot closes in; follow it while the piece stays tracked
+        const VisionTargets latest = vision.targets();
+        for (uint32_t i = 0; i < latest.count; i++) {
+            const VisionTarget& update = latest.targets[i];
+            if (update.id != target.id ||
+                std::hypot(update.x - target.x, update.y - target.y) < VISION_TRACKER_CONSTANTS::RETARGET_DISTANCE) {
+                continue;
+            }
+            const int remainingMs = timeoutMs - static_cast<int>(pros::millis() - startMs);
+            if (remainingMs <= 0) {
+                break;
+            }
+            target = update;
+            chassis.cancelMotion();
+            chassis.moveToPoint(target.x, target.y, remainingMs, params);
+        }
+    }
+    return true;
+}
+
+const VisionTracker& Drivetrain::get_vision() const { return vision; }
+
+MotionChassis& Drivetrain::get_chassis() { return chassis; }
 
 pros::MotorGroup& Drivetrain::get_left_motors() { return leftMotorGroup; }
 
 pros::MotorGroup& Drivetrain::get_right_motors() { return rightMotorGroup; }
+
+SensorHub& Drivetrain::get_sensor_hub() { return sensorHub; }
+
+const PoseChannel& Drivetrain::get_pose_channel() const { return poseChannel; }
+
+void Drivetrain::invalidate_output_cache() {
+    leftOutput.invalidate();
+    rightOutput.invalidate();
+}
+
+WriteStats Drivetrain::get_left_output_stats() const { return leftOutput.stats(); }
+
+WriteStats Drivetrain::get_right_output_stats() const { return rightOutput.stats(); }
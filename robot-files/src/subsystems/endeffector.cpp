@@ -5,16 +5,18 @@
 
 EndEffector::EndEffector()
     : endEffectorMotor(PORT_VALUES::ENDEFFECTOR_MOTOR_PORT, pros::MotorGears::blue),
+      endEffectorOutput(endEffectorMotor),
+      ejectOverride(endEffectorOutput),
       isScoring(false) {
     endEffectorMotor.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
 }
 
 void EndEffector::spin(int velocity) {
-    endEffectorMotor.move(velocity);
+    ejectOverride.move(velocity);
 }
 
 void EndEffector::stop() {
-    endEffectorMotor.move(0);
+    ejectOverride.move(0);
 }
 
 void EndEffector::scoreHigh() {
@@ -28,10 +30,10 @@ void EndEffector::scoreMid() {
     spin(90);
 }
 
-void EndEffector::control(pros::Controller& master) {
-    if (master.get_digital(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_HIGH)) {
+void EndEffector::control(const InputFrame& input) {
+    if (input.is_held(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_HIGH)) {
         scoreHigh();
-    } else if (master.get_digital(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_MID)) {
+    } else if (input.is_held(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_MID)) {
         scoreMid();
     }
     else {
@@ -40,7 +42,20 @@ void EndEffector::control(pros::Controller& master) {
 
 }
 
-void EndEffector::run() {
-    // Use the shared global controller for operator control
-    control(globals::controller);
-}
\ No newline at end of file
+void EndEffector::run(const InputFrame& input) {
+    control(input);
+}
+
+double EndEffector::get_position() {
+    return endEffectorMotor.get_position();
+}
+
+void EndEffector::begin_eject(int velocity) {
+    ejectOverride.begin(velocity);
+}
+
+void EndEffector::end_eject() {
+    ejectOverride.end();
+}
+
+WriteStats EndEffector::get_output_stats() const { return endEffectorOutput.stats(); }
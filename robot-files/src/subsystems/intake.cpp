@@ -4,30 +4,41 @@
 #include "pros/misc.hpp"
 
 Intake::Intake()
-    : intakeMotor(PORT_VALUES::INTAKE_MOTOR_PORT, pros::MotorGears::green) {
+    : intakeMotor(PORT_VALUES::INTAKE_MOTOR_PORT, pros::MotorGears::green),
+      intakeOutput(intakeMotor),
+      ejectOverride(intakeOutput) {
     intakeMotor.set_brake_mode(pros::E_MOTOR_BRAKE_COAST);
 }
 
 void Intake::spin(int velocity) {
-    intakeMotor.move(velocity);
+    ejectOverride.move(velocity);
 }
 
 void Intake::stop() {
-    intakeMotor.move(0);
+    ejectOverride.move(0);
 }
 
-void Intake::control(pros::Controller& master) {
-    if (master.get_digital(CONTROLLER_BUTTONS::INTAKE::INTAKE)||master.get_digital(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_HIGH)
-||master.get_digital(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_MID)) {
+void Intake::control(const InputFrame& input) {
+    if (input.is_held(CONTROLLER_BUTTONS::INTAKE::INTAKE)||input.is_held(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_HIGH)
+||input.is_held(CONTROLLER_BUTTONS::ENDEFFECTOR::SCORE_MID)) {
         spin(-127); // Full speed intake
-    } else if (master.get_digital(CONTROLLER_BUTTONS::INTAKE::OUTTAKE)) {
+    } else if (input.is_held(CONTROLLER_BUTTONS::INTAKE::OUTTAKE)) {
         spin(127); // Full speed outtake
     } else {
         stop();
     }
 }
 
-void Intake::run() {
-    // Use the shared global controller for operator control
-    control(globals::controller);
-}
\ No newline at end of file
+void Intake::run(const InputFrame& input) {
+    control(input);
+}
+
+void Intake::begin_eject(int velocity) {
+    ejectOverride.begin(velocity);
+}
+
+void Intake::end_eject() {
+    ejectOverride.end();
+}
+
+WriteStats Intake::get_output_stats() const { return intakeOutput.stats(); }
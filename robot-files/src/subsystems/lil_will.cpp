@@ -4,21 +4,30 @@
 
 LilWill::LilWill()
     : lilWillPneumatic(PORT_VALUES::LIL_WILL_PNEUMATIC, true),
-      isExtended(false) {
+      lilWillOutput(lilWillPneumatic, true) {
 }
 
-void LilWill::control(pros::Controller& master) {
+void LilWill::extend() {
+    lilWillOutput.set(true);
+}
+
+void LilWill::retract() {
+    lilWillOutput.set(false);
+}
 
-    bool currentButtonState = master.get_digital_new_press(CONTROLLER_BUTTONS::LIL_WILL::TOGGLE);
-    
-    // Toggle on button press (rising edge detection)
-    if (currentButtonState) {
-        LilWillPneumatic.toggle();
+void LilWill::toggle() {
+    lilWillOutput.toggle();
+}
+
+void LilWill::control(const InputFrame& input) {
+    // Toggle on button press (rising edge from the input frame)
+    if (input.was_pressed(CONTROLLER_BUTTONS::LIL_WILL::TOGGLE)) {
+        toggle();
     }
 }
 
-void LilWill::run() {
-    // Use the shared global controller for operator control
-    control(globals::controller);
-    
-}
\ No newline at end of file
+void LilWill::run(const InputFrame& input) {
+    control(input);
+}
+
+WriteStats LilWill::get_output_stats() const { return lilWillOutput.stats(); }
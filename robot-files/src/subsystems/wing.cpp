@@ -3,20 +3,32 @@
 #include "globals.hpp"
 
 Wing::Wing()
-    : wingPneumatic(PORT_VALUES::WING_PNEUMATIC) {
+    : wingPneumatic(PORT_VALUES::WING_PNEUMATIC),
+      wingOutput(wingPneumatic, false) {
     retract(); // Start retracted
 }
 
-void Wing::control(pros::Controller& master) {
-    bool currentButtonState = master.get_digital_new_press(CONTROLLER_BUTTONS::WING::TOGGLE);
-    
-    // ye
-    if (currentButtonState) {
+void Wing::extend() {
+    wingOutput.set(true);
+}
+
+void Wing::retract() {
+    wingOutput.set(false);
+}
+
+void Wing::toggle() {
+    wingOutput.toggle();
+}
+
+void Wing::control(const InputFrame& input) {
+    // Toggle on button press (rising edge from the input frame)
+    if (input.was_pressed(CONTROLLER_BUTTONS::WING::TOGGLE)) {
         toggle();
     }
 }
 
-void Wing::run() {
-    // Use the shared global controller for operator control
-    
-}
\ No newline at end of file
+void Wing::run(const InputFrame& input) {
+    control(input);
+}
+
+WriteStats Wing::get_output_stats() const { return wingOutput.stats(); }
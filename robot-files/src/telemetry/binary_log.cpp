@@ -0,0 +1,131 @@
+#include "telemetry/binary_log.hpp"
+
+#include <algorithm>
+
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+void BinaryLog::write(RecordId id, LogLevel level, const uint8_t* payload, std::size_t size) {
+    const uint32_t timeUs = static_cast<uint32_t>(pros::micros());
+    // The ticket claims the slot; writers never wait on each other or on the drain
+    const uint32_t ticket = head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots[ticket % CAPACITY];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.header.id = static_cast<uint16_t>(id);
+    slot.header.level = static_cast<uint8_t>(level);
+    slot.header.size = static_cast<uint8_t>(size);
+    slot.header.timestampUs = timeUs;
+    std::memcpy(slot.payload.data(), payload, size);
+    slot.sequence.store(ticket + 1, std::memory_order_release);
+}
+
+bool BinaryLog::pop(RecordHeader& header, uint8_t* payload) {
+    while (true) {
+        const uint32_t written = head.load(std::memory_order_acquire);
+        if (written - tail > CAPACITY) {
+            // Lapped: everything older than one ring behind the head is gone
+            dropped.fetch_add(written - CAPACITY - tail, std::memory_order_relaxed);
+            tail = written - CAPACITY;
+        }
+        if (written == tail) {
+            return false;
+        }
+
+        const Slot& slot = slots[tail % CAPACITY];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != tail + 1) {
+            // 0 or an older ticket: its writer was preempted mid-record, so
+            // come back next cycle. A newer ticket: overwritten, skip it
+            if (before == 0 || static_cast<int32_t>(before - (tail + 1)) < 0) {
+                return false;
+            }
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            tail++;
+            continue;
+        }
+
+        header = slot.header;
+        std::memcpy(payload, slot.payload.data(), std::min<std::size_t>(header.size, MAX_PAYLOAD));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        tail++;
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        header.size = static_cast<uint8_t>(std::min<std::size_t>(header.size, MAX_PAYLOAD));
+        drained.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+BinaryLogStats BinaryLog::stats() const {
+    BinaryLogStats stats;
+    stats.written = head.load(std::memory_order_relaxed);
+    stats.drained = drained.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BinaryLog::start(uint32_t periodMs, uint32_t taskPriority) {
+    if (started.exchange(true)) {
+        return;
+    }
+    pros::Task::create(
+        [this, periodMs] {
+            FILE* file = nullptr;
+            if (TELEMETRY_CONSTANTS::TO_SD && pros::usd::is_installed()) {
+                file = std::fopen(TELEMETRY_CONSTANTS::PATH, "wb");
+            }
+            if (file != nullptr) {
+                FileHeader fileHeader;
+                fileHeader.version = FORMAT_VERSION;
+                fileHeader.recordCount = static_cast<uint16_t>(RecordId::COUNT);
+                std::fwrite(&fileHeader, sizeof(fileHeader), 1, file);
+            }
+            while (true) {
+                drain(file);
+                pros::delay(periodMs);
+            }
+        },
+        taskPriority, TASK_STACK_DEPTH_DEFAULT, "binary log");
+}
+
+void BinaryLog::drain(FILE* file) {
+    const auto emit = [file](const RecordHeader& header, const uint8_t* payload) {
+        if (file != nullptr) {
+            std::fwrite(&header, sizeof(header), 1, file);
+            std::fwrite(payload, 1, header.size, file);
+            return;
+        }
+        char line[160];
+        format_record(header, payload, line, sizeof(line));
+        std::printf("%s\n", line);
+    };
+
+    RecordHeader header;
+    std::array<uint8_t, MAX_PAYLOAD> payload;
+    bool any = false;
+    while (pop(header, payload.data())) {
+        // Losses are noticed while popping, so report them ahead of the record that follows the gap
+        const uint32_t lost = dropped.load(std::memory_order_relaxed);
+        if (lost != reportedDrops) {
+            const uint32_t count = lost - reportedDrops;
+            RecordHeader gap;
+            gap.id = static_cast<uint16_t>(RecordId::DROPPED);
+            gap.level = static_cast<uint8_t>(LogLevel::WARN);
+            gap.size = sizeof(count);
+            gap.timestampUs = header.timestampUs;
+            uint8_t bytes[sizeof(count)];
+            std::memcpy(bytes, &count, sizeof(count));
+            emit(gap, bytes);
+            reportedDrops = lost;
+        }
+        emit(header, payload.data());
+        any = true;
+    }
+    if (file != nullptr && any) {
+        std::fflush(file);
+    }
+}
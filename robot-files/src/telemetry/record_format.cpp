@@ -0,0 +1,87 @@
+#include "telemetry/record_format.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+/**
+ * @brief snprintf that keeps appending at out + used, clamped to the buffer
+ */
+template <typename... Args> void append(char* out, std::size_t outSize, int& used, const char* format, Args... args) {
+    const std::size_t offset = static_cast<std::size_t>(used) < outSize ? used : outSize;
+    const int written = std::snprintf(out + offset, outSize - offset, format, args...);
+    if (written > 0) {
+        used += written;
+    }
+}
+} // namespace
+
+const char* level_name(uint8_t level) {
+    switch (static_cast<LogLevel>(level)) {
+    case LogLevel::DEBUG:
+        return "DEBUG";
+    case LogLevel::INFO:
+        return "INFO";
+    case LogLevel::WARN:
+        return "WARN";
+    case LogLevel::ERROR:
+        return "ERROR";
+    }
+    return "?";
+}
+
+int format_record(const RecordHeader& header, const uint8_t* payload, char* out, std::size_t outSize) {
+    int used = 0;
+    append(out, outSize, used, "%10.3f %-5s ", header.timestampUs / 1e6, level_name(header.level));
+    if (header.id >= static_cast<uint16_t>(RecordId::COUNT)) {
+        append(out, outSize, used, "unknown id %u (%u bytes)", static_cast<unsigned>(header.id),
+               static_cast<unsigned>(header.size));
+        return used;
+    }
+
+    const RecordFormat& format = RECORD_FORMATS[header.id];
+    append(out, outSize, used, "%s", format.name);
+    std::size_t offset = 0;
+    for (const char* field = format.fields; *field != '\0';) {
+        const char* colon = std::strchr(field, ':');
+        if (colon == nullptr || colon[1] == '\0') {
+            break;
+        }
+        const int nameLength = static_cast<int>(colon - field);
+        const char type = colon[1];
+        const std::size_t width = type == 'd' ? sizeof(double) : type == 'b' ? sizeof(bool) : 4;
+        if (offset + width > header.size) {
+            append(out, outSize, used, " (truncated)");
+            break;
+        }
+
+        // Payload bytes are unaligned, so copy each field out before reading it
+        const uint8_t* bytes = payload + offset;
+        offset += width;
+        if (type == 'f') {
+            float value;
+            std::memcpy(&value, bytes, sizeof(value));
+            append(out, outSize, used, " %.*s=%.3f", nameLength, field, value);
+        } else if (type == 'd') {
+            double value;
+            std::memcpy(&value, bytes, sizeof(value));
+            append(out, outSize, used, " %.*s=%.3f", nameLength, field, value);
+        } else if (type == 'i') {
+            int32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            append(out, outSize, used, " %.*s=%ld", nameLength, field, static_cast<long>(value));
+        } else if (type == 'u') {
+            uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            append(out, outSize, used, " %.*s=%lu", nameLength, field, static_cast<unsigned long>(value));
+        } else {
+            append(out, outSize, used, " %.*s=%d", nameLength, field, bytes[0] != 0);
+        }
+
+        field = colon + 2;
+        while (*field == ' ') {
+            field++;
+        }
+    }
+    return used;
+}
@@ -0,0 +1,75 @@
+#include "vision/piece_tracker.hpp"
+
+#include <algorithm>
+
+void PieceTracker::update(const PieceObservation* observations, std::size_t count, uint64_t timeUs) {
+    count = std::min(count, MAX_OBSERVATIONS);
+
+    // A piece unseen this long has been picked up or pushed away; do not let it capture a new detection
+    for (PieceTrack& track : slots) {
+        if (track.id != 0 && timeUs - track.lastSeenUs > config.timeoutUs) {
+            track = PieceTrack();
+        }
+    }
+
+    // Squared distance of every track/detection pair inside the gate
+    constexpr float OUTSIDE = -1;
+    const float gateSquared = config.gate * config.gate;
+    std::array<std::array<float, MAX_OBSERVATIONS>, MAX_TRACKS> cost;
+    for (std::size_t t = 0; t < MAX_TRACKS; t++) {
+        for (std::size_t o = 0; o < count; o++) {
+            const float dx = observations[o].x - slots[t].x;
+            const float dy = observations[o].y - slots[t].y;
+            const float distance = dx * dx + dy * dy;
+            cost[t][o] = slots[t].id != 0 && distance <= gateSquared ? distance : OUTSIDE;
+        }
+    }
+
+    // Global nearest neighbour: repeatedly take the closest remaining pair.
+    // With at most 8 x 8 pairs this is cheaper than an optimal assignment
+    // and gives the same answer unless pieces sit within a gate of each other
+    std::array<bool, MAX_TRACKS> trackUsed{};
+    std::array<bool, MAX_OBSERVATIONS> observationUsed{};
+    while (true) {
+        std::size_t bestTrack = MAX_TRACKS;
+        std::size_t bestObservation = 0;
+        for (std::size_t t = 0; t < MAX_TRACKS; t++) {
+            for (std::size_t o = 0; o < count; o++) {
+                if (trackUsed[t] || observationUsed[o] || cost[t][o] == OUTSIDE) {
+                    continue;
+                }
+                if (bestTrack == MAX_TRACKS || cost[t][o] < cost[bestTrack][bestObservation]) {
+                    bestTrack = t;
+                    bestObservation = o;
+                }
+            }
+        }
+        if (bestTrack == MAX_TRACKS) {
+            break;
+        }
+        trackUsed[bestTrack] = true;
+        observationUsed[bestObservation] = true;
+
+        PieceTrack& track = slots[bestTrack];
+        track.x += config.smoothing * (observations[bestObservation].x - track.x);
+        track.y += config.smoothing * (observations[bestObservation].y - track.y);
+        track.hits++;
+        track.lastSeenUs = timeUs;
+    }
+
+    // Whatever is left starts a new track in a free slot
+    for (std::size_t o = 0; o < count; o++) {
+        if (observationUsed[o]) {
+            continue;
+        }
+        const auto free = std::find_if(slots.begin(), slots.end(), [](const PieceTrack& track) { return track.id == 0; });
+        if (free == slots.end()) {
+            break;
+        }
+        free->id = nextId++;
+        free->x = observations[o].x;
+        free->y = observations[o].y;
+        free->hits = 1;
+        free->lastSeenUs = timeUs;
+    }
+}
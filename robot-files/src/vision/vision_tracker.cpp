@@ -0,0 +1,136 @@
+#include "vision/vision_tracker.hpp"
+
+#include <cmath>
+
+#include "constants.hpp"
+#include "globals.hpp"
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float DEG_TO_RAD = PI / 180;
+} // namespace
+
+bool project_detection(const CameraConfig& config, float centerPx, float widthPx, float& right, float& forward) {
+    if (widthPx < config.minWidthPx || widthPx <= 0) {
+        return false;
+    }
+    // Pinhole camera: focal length in pixels from the field of view
+    const float focal = config.imageWidth / 2 / std::tan(config.horizontalFov / 2 * DEG_TO_RAD);
+    const float offset = centerPx - config.imageWidth / 2;
+    const float bearing = std::atan2(offset, focal);
+    // Width ranges the depth along the optical axis; the ray is longer off-centre
+    const float distance = config.pieceWidth * focal / widthPx / std::cos(bearing);
+
+    const float angle = config.angle * DEG_TO_RAD + bearing;
+    right = config.x + distance * std::sin(angle);
+    forward = config.y + distance * std::cos(angle);
+    return true;
+}
+
+PieceObservation to_field(const PoseSample& pose, float right, float forward) {
+    const float sinT = std::sin(pose.theta * DEG_TO_RAD);
+    const float cosT = std::cos(pose.theta * DEG_TO_RAD);
+    PieceObservation observation;
+    observation.x = pose.x + right * cosT + forward * sinT;
+    observation.y = pose.y - right * sinT + forward * cosT;
+    return observation;
+}
+
+float bearing_to(const PoseSample& pose, float x, float y) {
+    const float heading = std::atan2(x - pose.x, y - pose.y) / DEG_TO_RAD;
+    return std::remainder(heading - pose.theta, 360.0f);
+}
+
+VisionTracker::VisionTracker(const PoseChannel& poses, pros::AIVision& camera, CameraConfig config,
+                             PieceTrackerConfig trackerConfig)
+    : poses(poses),
+      camera(camera),
+      config(config),
+      tracker(trackerConfig),
+      loop(VISION_TRACKER_CONSTANTS::PERIOD_MS) {}
+
+void VisionTracker::start(uint32_t periodMs, uint32_t taskPriority) {
+    if (started.exchange(true)) {
+        return;
+    }
+    camera.enable_detection_types(config.aiModel ? pros::AivisionModeType::objects : pros::AivisionModeType::colors);
+    pros::Task::create(
+        [this, periodMs] {
+            loop = LoopTimer(periodMs);
+            loop.start();
+            while (true) {
+                step();
+                loop.wait();
+            }
+        },
+        taskPriority, TASK_STACK_DEPTH_DEFAULT, "vision tracker");
+}
+
+VisionTargets VisionTracker::targets() const { return published.read(); }
+
+bool VisionTracker::nearest(const PoseSample& pose, float maxBearing, VisionTarget& target) const {
+    const VisionTargets latest = published.read();
+    float best = INFINITY;
+    for (uint32_t i = 0; i < latest.count; i++) {
+        const VisionTarget& candidate = latest.targets[i];
+        const float range = std::hypot(candidate.x - pose.x, candidate.y - pose.y);
+        if (range < best && std::fabs(bearing_to(pose, candidate.x, candidate.y)) <= maxBearing) {
+            best = range;
+            target = candidate;
+        }
+    }
+    return std::isfinite(best);
+}
+
+LoopStats VisionTracker::loop_stats() const { return loop.stats(); }
+
+void VisionTracker::step() {
+    const int32_t count = camera.get_object_count();
+    const uint64_t captureUs = pros::micros() - config.frameLatencyUs;
+    if (count == PROS_ERR) {
+        return;
+    }
+    const PoseSample pose = poses.sample_at(captureUs);
+    if (pose.sequence == 0) {
+        return;
+    }
+
+    // Indexed reads instead of get_all_objects(), which allocates a vector every frame
+    const pros::AivisionDetectType wanted =
+        config.aiModel ? pros::AivisionDetectType::object : pros::AivisionDetectType::color;
+    std::array<PieceObservation, PieceTracker::MAX_OBSERVATIONS> observations;
+    std::size_t used = 0;
+    for (int32_t i = 0; i < count && used < observations.size(); i++) {
+        const pros::AIVision::Object object = camera.get_object(i);
+        if (!pros::AIVision::is_type(object, wanted) || object.id >= 32 || (config.idMask & (1u << object.id)) == 0) {
+            continue;
+        }
+        // Color blobs and AI model objects share the box layout
+        const float left = config.aiModel ? object.object.element.xoffset : object.object.color.xoffset;
+        const float width = config.aiModel ? object.object.element.width : object.object.color.width;
+        float right, forward;
+        if (project_detection(config, left + width / 2, width, right, forward)) {
+            observations[used++] = to_field(pose, right, forward);
+        }
+    }
+    tracker.update(observations.data(), used, captureUs);
+
+    VisionTargets frame;
+    for (const PieceTrack& track : tracker.tracks()) {
+        if (!tracker.confirmed(track)) {
+            continue;
+        }
+        VisionTarget& target = frame.targets[frame.count++];
+        target.id = track.id;
+        target.x = track.x;
+        target.y = track.y;
+        target.range = std::hypot(track.x - pose.x, track.y - pose.y);
+        target.bearing = bearing_to(pose, track.x, track.y);
+    }
+    frame.timestampUs = captureUs;
+    frame.sequence = ++sequence;
+    published.publish(frame);
+    globals::telemetry.log<LogLevel::DEBUG, RecordId::VISION_FRAME>(count, frame.count);
+}
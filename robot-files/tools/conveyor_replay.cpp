@@ -0,0 +1,240 @@
+/**
+ * @file conveyor_replay.cpp
+ * @brief Host replay of conveyor encoder traces through ConveyorTracker
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++20 -O2 -Iinclude tools/conveyor_replay.cpp src/subsystems/conveyor_tracker.cpp -o conveyor_replay
+ *   ./conveyor_replay [trace.csv ...]
+ *
+ * A trace is a CSV of "time_ms,position_deg,piece" rows at 1 ms: the end
+ * effector's position (e.g. from get_raw_position() and its timestamp, or an
+ * external encoder), and 1 on the row a wrong-color piece reached the sensor.
+ * Without arguments, synthetic traces are replayed instead: score high and
+ * score mid, a motor sagging as it heats up, and a belt that stops with
+ * pieces on it and starts again.
+ *
+ * The replay reproduces what the robot sees: the color sort samples every
+ * COLOR_SORT_CONSTANTS::PERIOD_MS, the motor reports its position every
+ * 10 ms, classification takes CONFIRM_SAMPLES cycles and the rollers reverse
+ * ACTUATION_MS after the eject fires. An eject hits when the piece is within
+ * HIT_WINDOW of the eject point as the rollers reverse. The fixed delay the
+ * tracker replaced, calibrated at score-high speed, is scored alongside.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "constants.hpp"
+#include "subsystems/conveyor_tracker.hpp"
+
+namespace {
+constexpr int ACTUATION_MS = 15;      // eject command to reversed rollers
+constexpr int MOTOR_UPDATE_MS = 10;   // how often the motor reports its position
+constexpr float HIT_WINDOW = 0.75f;   // inches either side of the eject point
+constexpr float MIN_HIT_RATE = 0.95f;
+
+// Score high (127) on a blue cartridge: 600 rpm
+constexpr float FULL_SPEED_DPS = 3600;
+
+struct Trace {
+  const char* name;
+  std::vector<float> positionDeg; ///< One per millisecond
+  std::vector<int> arrivalsMs;    ///< Pieces reaching the sensor
+};
+
+struct Score {
+  int pieces = 0;
+  int trackerHits = 0;
+  int fixedHits = 0;
+};
+
+float inches(float degrees) { return degrees * static_cast<float>(COLOR_SORT_CONSTANTS::BELT_INCHES_PER_DEGREE); }
+
+/**
+ * @brief Millisecond the rollers reverse if the eject fires after a fixed delay from arrival
+ */
+int fixed_delay_actuation(int arrivalMs) {
+    // Calibrated once, cold, at score-high speed
+    const float travelMs =
+        static_cast<float>(COLOR_SORT_CONSTANTS::EXIT_DISTANCE) / inches(FULL_SPEED_DPS) * 1000 - ACTUATION_MS;
+    const int period = COLOR_SORT_CONSTANTS::PERIOD_MS;
+    const int firstCycle = (arrivalMs + period - 1) / period * period;
+    const int fireMs = firstCycle + static_cast<int>(std::ceil(travelMs / period)) * period;
+    return fireMs + ACTUATION_MS;
+}
+
+bool hit(const Trace& trace, int arrivalMs, int actuationMs) {
+    if (actuationMs >= static_cast<int>(trace.positionDeg.size())) {
+        return false;
+    }
+    const float travel = inches(trace.positionDeg[actuationMs] - trace.positionDeg[arrivalMs]);
+    return std::fabs(travel - static_cast<float>(COLOR_SORT_CONSTANTS::EXIT_DISTANCE)) <= HIT_WINDOW;
+}
+
+Score replay(const Trace& trace) {
+    ConveyorConfig config;
+    config.exitDistance = static_cast<float>(COLOR_SORT_CONSTANTS::EXIT_DISTANCE);
+    config.leadTime = COLOR_SORT_CONSTANTS::EJECT_LEAD_MS / 1000.0f;
+    ConveyorTracker tracker(config);
+
+    Score score;
+    std::vector<int> firedMs;
+    std::size_t nextArrival = 0;
+    std::vector<std::pair<int, float>> classifying; // cycle it is classified at, belt position seen at
+    const int period = COLOR_SORT_CONSTANTS::PERIOD_MS;
+    for (int ms = 0; ms < static_cast<int>(trace.positionDeg.size()); ms += period) {
+        const int reportedMs = ms / MOTOR_UPDATE_MS * MOTOR_UPDATE_MS;
+        tracker.update(static_cast<uint64_t>(ms) * 1000, inches(trace.positionDeg[reportedMs]));
+
+        while (nextArrival < trace.arrivalsMs.size() && trace.arrivalsMs[nextArrival] <= ms) {
+            classifying.push_back({ms + (COLOR_SORT_CONSTANTS::CONFIRM_SAMPLES - 1) * period, tracker.position()});
+            nextArrival++;
+        }
+        while (!classifying.empty() && classifying.front().first <= ms) {
+            tracker.add(classifying.front().second);
+            classifying.erase(classifying.begin());
+        }
+        tracker.drop_reversed();
+        while (tracker.take_due()) {
+            firedMs.push_back(ms);
+        }
+    }
+
+    for (std::size_t i = 0; i < trace.arrivalsMs.size(); i++) {
+        const int arrivalMs = trace.arrivalsMs[i];
+        score.pieces++;
+        if (i < firedMs.size() && hit(trace, arrivalMs, firedMs[i] + ACTUATION_MS)) {
+            score.trackerHits++;
+        }
+        if (hit(trace, arrivalMs, fixed_delay_actuation(arrivalMs))) {
+            score.fixedHits++;
+        }
+    }
+    return score;
+}
+
+/**
+ * @brief Belt following a commanded speed profile through a first-order motor lag
+ * @param speedDps Commanded speed for each millisecond
+ */
+std::vector<float> simulate_belt(const std::vector<float>& speedDps, std::mt19937& rng) {
+    std::normal_distribution<float> encoderNoise(0, 0.5f);
+    constexpr float TIME_CONSTANT_MS = 40;
+    std::vector<float> position(speedDps.size());
+    float speed = 0;
+    float angle = 0;
+    for (std::size_t ms = 0; ms < speedDps.size(); ms++) {
+        speed += (speedDps[ms] - speed) / TIME_CONSTANT_MS;
+        angle += speed / 1000;
+        position[ms] = angle + encoderNoise(rng);
+    }
+    return position;
+}
+
+/**
+ * @brief Pieces every spacingMs while the belt runs, with some jitter
+ */
+std::vector<int> arrivals(const std::vector<float>& speedDps, int spacingMs, std::mt19937& rng) {
+    std::uniform_int_distribution<int> jitter(0, spacingMs / 3);
+    std::vector<int> result;
+    for (int ms = 300; ms < static_cast<int>(speedDps.size()) - 1000; ms += spacingMs + jitter(rng)) {
+        if (speedDps[ms] > 0) {
+            result.push_back(ms);
+        }
+    }
+    return result;
+}
+
+std::vector<Trace> synthetic_traces() {
+    std::mt19937 rng(11);
+    constexpr int DURATION_MS = 20000;
+    std::vector<Trace> traces;
+
+    const auto add = [&](const char* name, const std::vector<float>& speed, int spacingMs) {
+        Trace trace{name, simulate_belt(speed, rng), {}};
+        trace.arrivalsMs = arrivals(speed, spacingMs, rng);
+        traces.push_back(trace);
+    };
+
+    std::vector<float> speed(DURATION_MS);
+    for (int ms = 0; ms < DURATION_MS; ms++) {
+        speed[ms] = ms < 100 ? 0 : FULL_SPEED_DPS;
+    }
+    add("score high", speed, 400);
+
+    for (int ms = 0; ms < DURATION_MS; ms++) {
+        speed[ms] = ms < 100 ? 0 : FULL_SPEED_DPS * 90 / 127;
+    }
+    add("score mid", speed, 400);
+
+    // A hot motor loses a quarter of its speed over the run
+    for (int ms = 0; ms < DURATION_MS; ms++) {
+        speed[ms] = ms < 100 ? 0 : FULL_SPEED_DPS * (1 - 0.25f * ms / DURATION_MS);
+    }
+    add("heating", speed, 400);
+
+    // Pieces wait between the sensor and the eject point while the belt stops
+    for (int ms = 0; ms < DURATION_MS; ms++) {
+        speed[ms] = ms < 100 || ms % 1000 >= 700 ? 0 : FULL_SPEED_DPS;
+    }
+    Trace stopAndGo{"stop and go", simulate_belt(speed, rng), {}};
+    for (int ms = 680; ms < DURATION_MS - 1000; ms += 1000) {
+        stopAndGo.arrivalsMs.push_back(ms);
+    }
+    traces.push_back(stopAndGo);
+    return traces;
+}
+
+bool load_trace(const char* path, Trace& trace) {
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    trace.name = path;
+    char line[128];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        int ms, piece;
+        float degrees;
+        if (std::sscanf(line, "%d,%f,%d", &ms, &degrees, &piece) != 3) {
+            continue; // header
+        }
+        trace.positionDeg.push_back(degrees);
+        if (piece != 0) {
+            trace.arrivalsMs.push_back(static_cast<int>(trace.positionDeg.size()) - 1);
+        }
+    }
+    std::fclose(file);
+    return !trace.positionDeg.empty();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<Trace> traces;
+    for (int i = 1; i < argc; i++) {
+        Trace trace;
+        if (!load_trace(argv[i], trace)) {
+            std::printf("could not read %s\n", argv[i]);
+            return 1;
+        }
+        traces.push_back(trace);
+    }
+    if (traces.empty()) {
+        traces = synthetic_traces();
+    }
+
+    Score total;
+    for (const Trace& trace : traces) {
+        const Score score = replay(trace);
+        std::printf("%-12s %3d pieces  tracker %5.1f%%  fixed delay %5.1f%%\n", trace.name, score.pieces,
+                    100.0f * score.trackerHits / score.pieces, 100.0f * score.fixedHits / score.pieces);
+        total.pieces += score.pieces;
+        total.trackerHits += score.trackerHits;
+        total.fixedHits += score.fixedHits;
+    }
+    const float rate = static_cast<float>(total.trackerHits) / total.pieces;
+    std::printf("%-12s %3d pieces  tracker %5.1f%%  fixed delay %5.1f%%  -> %s\n", "total", total.pieces, 100 * rate,
+                100.0f * total.fixedHits / total.pieces, rate >= MIN_HIT_RATE ? "PASS" : "FAIL");
+    return rate >= MIN_HIT_RATE ? 0 : 1;
+}
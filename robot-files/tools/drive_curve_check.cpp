@@ -0,0 +1,133 @@
+/**
+ * @file drive_curve_check.cpp
+ * @brief Host check and benchmark of LutDriveCurve against LemLib's exponential curve
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=gnu++20 -O2 -Iinclude tools/drive_curve_check.cpp src/input/lut_drive_curve.cpp -o drive_curve_check
+ *   ./drive_curve_check
+ *
+ * For the OPERATOR_CONSTANTS throttle and steer curves, LemLib's default
+ * curve and a few steeper curve gains, compares lookup() with the
+ * exponential formula truncated to int (what Chassis::arcade uses) for all
+ * 255 joystick values, and curve() with the formula itself. Also checks that
+ * the default curve, which drive() uses without OPERATOR_CONSTANTS::USE_CURVES,
+ * passes every input through unchanged. Then times both per call. Exits 1 on
+ * any mismatch.
+ *
+ * LemLib ships prebuilt, so its ExpoDriveCurve is defined here from LemLib's
+ * source; the table is built through it exactly as on the robot.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "constants.hpp"
+#include "input/lut_drive_curve.hpp"
+#include "lemlib/util.hpp"
+
+namespace {
+/**
+ * @brief LemLib's ExpoDriveCurve::curve, kept out of the class so the check does not depend on it
+ */
+float expo(float input, float deadband, float minOutput, float curveGain) {
+    if (std::fabs(input) <= deadband) {
+        return 0;
+    }
+    const float g = std::fabs(input) - deadband;
+    const float g127 = 127 - deadband;
+    const float i = std::pow(curveGain, g - 127) * g * lemlib::sgn(input);
+    const float i127 = std::pow(curveGain, g127 - 127) * g127;
+    return (127.0f - minOutput) / 127 * i * 127 / i127 + minOutput * lemlib::sgn(input);
+}
+} // namespace
+
+lemlib::ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+    : deadband(deadband),
+      minOutput(minOutput),
+      curveGain(curve) {}
+
+float lemlib::ExpoDriveCurve::curve(float input) { return expo(input, deadband, minOutput, curveGain); }
+
+namespace {
+constexpr int ROUNDS = 20000; // passes over all 255 inputs when timing
+
+struct Curve {
+  const char* name;
+  float deadband;
+  float minOutput;
+  float curveGain;
+};
+
+int check(const Curve& config) {
+    LutDriveCurve table(config.deadband, config.minOutput, config.curveGain);
+    int mismatches = 0;
+    for (int input = -127; input <= 127; input++) {
+        const float reference = expo(static_cast<float>(input), config.deadband, config.minOutput, config.curveGain);
+        if (table.lookup(input) != static_cast<int>(reference) || table.curve(static_cast<float>(input)) != reference) {
+            if (mismatches++ < 5) {
+                std::printf("  %s: input %d: lookup %d curve %f, expected %d (%f)\n", config.name, input,
+                            table.lookup(input), table.curve(static_cast<float>(input)), static_cast<int>(reference),
+                            reference);
+            }
+        }
+    }
+    // Out-of-range input clamps to the ends
+    if (table.lookup(200) != table.lookup(127) || table.lookup(-200) != table.lookup(-127)) {
+        std::printf("  %s: out-of-range input not clamped\n", config.name);
+        mismatches++;
+    }
+    return mismatches;
+}
+
+template <typename F> double ns_per_call(F&& call) {
+    volatile int sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int input = -127; input <= 127; input++) {
+            sink = sink + call(input);
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * 255.0);
+}
+} // namespace
+
+int main() {
+    const Curve curves[] = {
+        {"throttle", OPERATOR_CONSTANTS::THROTTLE::DEADBAND, OPERATOR_CONSTANTS::THROTTLE::MIN,
+         static_cast<float>(OPERATOR_CONSTANTS::THROTTLE::CURVE)},
+        {"steer", OPERATOR_CONSTANTS::STEER::DEADBAND, OPERATOR_CONSTANTS::STEER::MIN,
+         static_cast<float>(OPERATOR_CONSTANTS::STEER::CURVE)},
+        {"lemlib default", 0, 0, 1},
+        {"curve 1.019", 3, 10, 1.019f},
+        {"curve 1.05", 5, 0, 1.05f},
+    };
+
+    int mismatches = 0;
+    for (const Curve& config : curves) {
+        const int found = check(config);
+        std::printf("%-14s %s\n", config.name, found == 0 ? "255 inputs match" : "MISMATCH");
+        mismatches += found;
+    }
+
+    // Without USE_CURVES the drive must feel exactly as it did on LemLib's default curve
+    LutDriveCurve linear(0, 0, 1);
+    bool identity = true;
+    for (int input = -127; input <= 127; input++) {
+        identity = identity && linear.lookup(input) == input;
+    }
+    std::printf("%-14s %s\n", "linear", identity ? "output equals input" : "MISMATCH");
+    mismatches += !identity;
+
+    const Curve& throttle = curves[0];
+    LutDriveCurve table(throttle.deadband, throttle.minOutput, throttle.curveGain);
+    const double expoNs = ns_per_call([&](int input) {
+        return static_cast<int>(expo(static_cast<float>(input), throttle.deadband, throttle.minOutput, throttle.curveGain));
+    });
+    const double lookupNs = ns_per_call([&](int input) { return table.lookup(input); });
+    std::printf("expo %.2f ns/call, lookup %.2f ns/call\n", expoNs, lookupNs);
+
+    std::printf("%s\n", mismatches == 0 ? "PASS" : "FAIL");
+    return mismatches == 0 ? 0 : 1;
+}
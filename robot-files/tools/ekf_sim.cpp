@@ -0,0 +1,174 @@
+/**
+ * @file ekf_sim.cpp
+ * @brief Host check of EkfOdometry on a simulated drive with slipping drive wheels
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=gnu++20 -O2 -Iinclude tools/ekf_sim.cpp src/odometry/ekf_odometry.cpp src/odometry/heading_fusion.cpp -o ekf_sim
+ *   ./ekf_sim
+ *
+ * Drives a simulated tank robot for 15 s (still, straight, turn in place,
+ * arc, reverse, with stops between) and feeds EkfOdometry the snapshots
+ * SensorHub would publish every 5 ms:
+ *  - both tracking wheels, quantised to centidegrees;
+ *  - the drive motors, on their own 10 ms timestamps, reading fast by the
+ *    scenario's slip;
+ *  - one IMU with a constant bias and noise.
+ * Each scenario fails if the final position or heading error is over its
+ * limit, or if the filter gated out any measurement of a drive that did
+ * nothing unusual. Up to 3% slip the error is the tracking wheels' own
+ * (about 0.3 in); 10% slip is past what the motor encoder noise allows
+ * for, and only has to degrade gracefully. Exits 1 on any failure, so it gates changes to the filter
+ * and is what ODOMETRY_CONSTANTS::USE_EKF should pass before it is turned on.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "odometry/ekf_odometry.hpp"
+
+// LemLib ships prebuilt; this is the one piece of it the filter links against
+lemlib::Pose::Pose(float x, float y, float theta)
+    : x(x),
+      y(y),
+      theta(theta) {}
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float DT = 0.005f;
+constexpr int STEPS = 3000; // 15 s
+constexpr float MAX_HEADING_ERROR = 1; // degrees
+
+// Robot, in the tracking-wheel conventions EkfConfig documents
+constexpr float VERTICAL_DIAMETER = 2;
+constexpr float VERTICAL_OFFSET = -1;
+constexpr float HORIZONTAL_DIAMETER = 2;
+constexpr float HORIZONTAL_OFFSET = 3;
+constexpr float TRACK_WIDTH = 12;
+constexpr float INCHES_PER_TICK = 3.25f * PI / 900 * 36 / 48; // blue cartridge on a 36:48 drive
+
+struct Scenario {
+  const char* name;
+  float slip;     ///< Drive wheels read this much more travel than the ground moved
+  float biasDps;  ///< IMU bias
+  float maxPositionError; ///< Inches after 15 s
+};
+
+/**
+ * @brief Commanded forward speed (in/s) and turn rate (deg/s, clockwise) at time t
+ */
+void command(float t, float& forward, float& turn) {
+    forward = 0;
+    turn = 0;
+    if (t >= 1 && t < 4) {
+        forward = 40;
+    } else if (t >= 4.5f && t < 5.5f) {
+        turn = 90;
+    } else if (t >= 6 && t < 9.5f) {
+        forward = 30;
+        turn = -30;
+    } else if (t >= 10 && t < 13.5f) {
+        forward = -35;
+    }
+}
+
+/**
+ * @brief Position in centidegrees of a wheel that has rolled distance inches
+ */
+int32_t centidegrees(double distance, float diameter) {
+    return static_cast<int32_t>(std::lround(distance / (PI * diameter) * 36000));
+}
+
+bool run(const Scenario& scenario) {
+    std::mt19937 rng(3);
+    std::normal_distribution<float> gyroNoise(0, 0.1f);
+
+    EkfConfig config;
+    config.vertical = {VERTICAL_DIAMETER, VERTICAL_OFFSET};
+    config.horizontal = {HORIZONTAL_DIAMETER, HORIZONTAL_OFFSET};
+    config.trackWidth = TRACK_WIDTH;
+    config.motorInchesPerTick = INCHES_PER_TICK;
+    config.wheelWindowMs = 10;
+    EkfOdometry ekf(config);
+
+    SensorSnapshot snapshot;
+    const auto healthy = [](DeviceHealth& health) {
+        health.present = true;
+        health.connected = true;
+    };
+    healthy(snapshot.verticalRotation.health);
+    healthy(snapshot.horizontalRotation.health);
+    healthy(snapshot.leftDrive.health);
+    healthy(snapshot.rightDrive.health);
+    healthy(snapshot.imu[0].health);
+    snapshot.leftDrive.count = 3;
+    snapshot.rightDrive.count = 3;
+
+    double x = 0, y = 0, theta = 0; // truth; theta in radians, clockwise
+    float forward = 0, omega = 0;   // actual, lagging the command
+    double vertical = 0, horizontal = 0, left = 0, right = 0, rotation = 0;
+    for (int step = 0; step < STEPS; step++) {
+        const float t = step * DT;
+        float forwardCommand, turnCommand;
+        command(t, forwardCommand, turnCommand);
+        // The drive reaches its command with a 0.1 s time constant
+        forward += (forwardCommand - forward) * DT / 0.1f;
+        omega += (turnCommand * PI / 180 - omega) * DT / 0.1f;
+
+        x += forward * std::sin(theta) * DT;
+        y += forward * std::cos(theta) * DT;
+        theta += omega * DT;
+        vertical += (forward - VERTICAL_OFFSET * omega) * DT;
+        horizontal += (-HORIZONTAL_OFFSET * omega) * DT;
+        left += (forward + TRACK_WIDTH / 2 * omega) * (1 + scenario.slip) * DT;
+        right += (forward - TRACK_WIDTH / 2 * omega) * (1 + scenario.slip) * DT;
+        const float gyroDps = omega * 180 / PI + scenario.biasDps + gyroNoise(rng);
+        rotation += gyroDps * DT;
+
+        snapshot.cycle++;
+        snapshot.timestampUs = static_cast<uint64_t>(step) * 5000;
+        snapshot.verticalRotation.positionCdeg = centidegrees(vertical, VERTICAL_DIAMETER);
+        snapshot.verticalRotation.readUs = snapshot.timestampUs;
+        snapshot.horizontalRotation.positionCdeg = centidegrees(horizontal, HORIZONTAL_DIAMETER);
+        snapshot.horizontalRotation.readUs = snapshot.timestampUs;
+        // Motors report every 10 ms
+        if (step % 2 == 0) {
+            const uint32_t nowMs = static_cast<uint32_t>(snapshot.timestampUs / 1000);
+            snapshot.leftDrive.deviceTimestampMs = nowMs;
+            snapshot.rightDrive.deviceTimestampMs = nowMs;
+            for (std::size_t i = 0; i < 3; i++) {
+                snapshot.leftDrive.rawPosition[i] = static_cast<int32_t>(std::lround(left / INCHES_PER_TICK));
+                snapshot.rightDrive.rawPosition[i] = static_cast<int32_t>(std::lround(right / INCHES_PER_TICK));
+            }
+        }
+        snapshot.imu[0].gyroZDps = gyroDps;
+        snapshot.imu[0].rotationDeg = rotation;
+        ekf.update(snapshot);
+    }
+
+    const lemlib::Pose pose = ekf.pose();
+    const float positionError = static_cast<float>(std::hypot(pose.x - x, pose.y - y));
+    const float headingError = static_cast<float>(std::fabs(pose.theta - theta * 180 / PI));
+    const EkfStats& stats = ekf.stats();
+    const bool ok = positionError <= scenario.maxPositionError && headingError <= MAX_HEADING_ERROR && stats.rejected == 0;
+    std::printf("%-22s position %.3f in  heading %.3f deg  accepted %lu rejected %lu  %s\n", scenario.name,
+                positionError, headingError, static_cast<unsigned long>(stats.accepted),
+                static_cast<unsigned long>(stats.rejected), ok ? "ok" : "FAIL");
+    return ok;
+}
+} // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"no slip", 0, 0, 0.5f},
+        {"3% motor slip", 0.03f, 0, 0.5f},
+        {"3% slip, biased gyro", 0.03f, 0.3f, 0.5f},
+        {"10% motor slip", 0.10f, 0, 1.5f},
+    };
+    bool pass = true;
+    for (const Scenario& scenario : scenarios) {
+        pass = run(scenario) && pass;
+    }
+    std::printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file feedforward_fitter.cpp
+ * @brief Host tool fitting kS/kV/kA per drive side from a characterization log
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 tools/feedforward_fitter.cpp -o feedforward_fitter
+ *   ./feedforward_fitter characterization.csv
+ *
+ * Reads the CSV written by Drivetrain::characterize() and solves, by ordinary
+ * least squares, V = kS*sgn(v) + kV*v + kA*a for each side. Samples where the
+ * wheel is (nearly) stopped are skipped, since static friction makes the
+ * model invalid there. Prints the fit quality and the constants to paste into
+ * DRIVETRAIN_CONSTANTS::FEEDFORWARD.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+// Slower than this (in/s) counts as stopped
+constexpr double MIN_VELOCITY = 0.5;
+
+struct Row {
+    double volts;
+    double velocity;
+    double acceleration;
+};
+
+struct Fit {
+    double kS = 0;
+    double kV = 0;
+    double kA = 0;
+    double rSquared = 0;
+    size_t samples = 0;
+    bool ok = false;
+};
+
+bool read_log(const char* filename, std::vector<Row>& left, std::vector<Row>& right) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "cannot open " << filename << "\n";
+        return false;
+    }
+
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::array<double, 8> values;
+        char comma;
+        bool ok = static_cast<bool>(stream >> values[0]);
+        for (size_t i = 1; ok && i < values.size(); i++) {
+            ok = static_cast<bool>(stream >> comma >> values[i]);
+        }
+        if (!ok) {
+            continue;
+        }
+        // test, time, left V, right V, left v, right v, left a, right a
+        left.push_back({values[2], values[4], values[6]});
+        right.push_back({values[3], values[5], values[7]});
+    }
+    return true;
+}
+
+/**
+ * @brief Solves the 3x3 system a * x = b by Gaussian elimination with partial pivoting
+ */
+bool solve(std::array<std::array<double, 4>, 3> m, std::array<double, 3>& x) {
+    for (size_t col = 0; col < 3; col++) {
+        size_t pivot = col;
+        for (size_t row = col + 1; row < 3; row++) {
+            if (std::fabs(m[row][col]) > std::fabs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(m[pivot][col]) < 1e-12) {
+            return false;
+        }
+        std::swap(m[col], m[pivot]);
+        for (size_t row = 0; row < 3; row++) {
+            if (row == col) {
+                continue;
+            }
+            const double factor = m[row][col] / m[col][col];
+            for (size_t k = col; k < 4; k++) {
+                m[row][k] -= factor * m[col][k];
+            }
+        }
+    }
+    for (size_t i = 0; i < 3; i++) {
+        x[i] = m[i][3] / m[i][i];
+    }
+    return true;
+}
+
+Fit fit(const std::vector<Row>& rows) {
+    // Normal equations (X^T X) k = X^T V with X = [sgn(v), v, a]
+    std::array<std::array<double, 4>, 3> normal{};
+    double sumVolts = 0;
+    size_t n = 0;
+    for (const Row& row : rows) {
+        if (std::fabs(row.velocity) < MIN_VELOCITY) {
+            continue;
+        }
+        const std::array<double, 3> x = {row.velocity > 0 ? 1.0 : -1.0, row.velocity, row.acceleration};
+        for (size_t i = 0; i < 3; i++) {
+            for (size_t j = 0; j < 3; j++) {
+                normal[i][j] += x[i] * x[j];
+            }
+            normal[i][3] += x[i] * row.volts;
+        }
+        sumVolts += row.volts;
+        n++;
+    }
+
+    Fit result;
+    result.samples = n;
+    std::array<double, 3> k;
+    if (n < 3 || !solve(normal, k)) {
+        return result;
+    }
+    result.kS = k[0];
+    result.kV = k[1];
+    result.kA = k[2];
+    result.ok = true;
+
+    const double meanVolts = sumVolts / n;
+    double residual = 0;
+    double total = 0;
+    for (const Row& row : rows) {
+        if (std::fabs(row.velocity) < MIN_VELOCITY) {
+            continue;
+        }
+        const double sign = row.velocity > 0 ? 1.0 : -1.0;
+        const double predicted = result.kS * sign + result.kV * row.velocity + result.kA * row.acceleration;
+        residual += (row.volts - predicted) * (row.volts - predicted);
+        total += (row.volts - meanVolts) * (row.volts - meanVolts);
+    }
+    result.rSquared = total > 0 ? 1 - residual / total : 0;
+    return result;
+}
+
+void print(const char* side, const Fit& result) {
+    if (!result.ok) {
+        std::printf("%s: not enough moving samples (%zu) to fit\n", side, result.samples);
+        return;
+    }
+    std::printf("%s: kS=%.4f V  kV=%.5f V/(in/s)  kA=%.5f V/(in/s^2)  r^2=%.4f  (%zu samples)\n", side, result.kS,
+                result.kV, result.kA, result.rSquared, result.samples);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: feedforward_fitter <characterization.csv>\n";
+        return 1;
+    }
+
+    std::vector<Row> left, right;
+    if (!read_log(argv[1], left, right)) {
+        return 1;
+    }
+
+    const Fit leftFit = fit(left);
+    const Fit rightFit = fit(right);
+    print("left ", leftFit);
+    print("right", rightFit);
+    if (!leftFit.ok || !rightFit.ok) {
+        return 1;
+    }
+
+    std::printf("\nnamespace FEEDFORWARD {\n");
+    for (const auto& [name, result] : {std::pair{"LEFT", leftFit}, std::pair{"RIGHT", rightFit}}) {
+        std::printf("namespace %s {\nconstexpr double KS = %.4f;\nconstexpr double KV = %.5f;\nconstexpr double KA = "
+                    "%.5f;\n} // namespace %s\n",
+                    name, result.kS, result.kV, result.kA, name);
+    }
+    std::printf("} // namespace FEEDFORWARD\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file heading_fusion_sim.cpp
+ * @brief Host check of HeadingFusion on synthetic drifting gyro traces
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/heading_fusion_sim.cpp src/odometry/heading_fusion.cpp -o heading_fusion_sim
+ *   ./heading_fusion_sim
+ *
+ * Simulates a 60 s skills run at 5 ms: stretches of turning and driving
+ * separated by short stops, with each gyro's bias wandering as it warms up.
+ * Every scenario reports the final heading error of one gyro integrated with
+ * only its start-up bias (what a single IMU gives) and of the fused heading,
+ * and fails if the fused heading is off by more than the limit. Exits 1 on
+ * any failure, so it can gate changes to the fusion.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "odometry/heading_fusion.hpp"
+
+namespace {
+constexpr float DT = 0.005f;
+constexpr int STEPS = 12000; // 60 s
+constexpr float MAX_FUSED_ERROR = 1.5f; // degrees after 60 s
+constexpr float NAN_RATE = NAN;
+
+enum class Fault { NONE, SECOND_DISCONNECTS, SECOND_BIAS_JUMP, NO_REFERENCE };
+
+struct Scenario {
+  const char* name;
+  Fault fault;
+};
+
+/**
+ * @brief True yaw rate: 2 s of motion, then 0.5 s still, repeating
+ */
+float true_rate(int step) {
+    const float t = step * DT;
+    const float phase = std::fmod(t, 2.5f);
+    if (phase >= 2.0f) {
+        return 0;
+    }
+    return 90 * std::sin(t * 1.7f) * std::sin(phase * static_cast<float>(M_PI) / 2);
+}
+
+/**
+ * @brief Bias that settles from its start value toward a warm value
+ */
+float drifting_bias(float start, float warm, int step) {
+    const float t = step * DT;
+    return warm + (start - warm) * std::exp(-t / 20);
+}
+
+bool run(const Scenario& scenario) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0, 0.15f);
+    std::normal_distribution<float> wheelNoise(0, 3.0f);
+
+    HeadingFusion fusion;
+    float truth = 0;
+    float single = 0;
+    const float singleStartBias = drifting_bias(0.3f, -0.4f, 0); // what a start-up calibration measures
+
+    for (int step = 0; step < STEPS; step++) {
+        const float rate = true_rate(step);
+        truth += rate * DT;
+
+        std::array<GyroReading, HeadingFusion::MAX_GYROS> readings;
+        readings[0] = {rate + drifting_bias(0.3f, -0.4f, step) + noise(rng), true};
+        readings[1] = {rate + drifting_bias(-0.2f, 0.5f, step) + noise(rng), true};
+        if (scenario.fault == Fault::SECOND_DISCONNECTS && step > STEPS / 3) {
+            readings[1].valid = false;
+        }
+        if (scenario.fault == Fault::SECOND_BIAS_JUMP && step > STEPS / 3) {
+            readings[1].rateDps += 25;
+        }
+        single += (readings[0].rateDps - singleStartBias) * DT;
+
+        const bool stationary = rate == 0;
+        const float reference = scenario.fault == Fault::NO_REFERENCE ? NAN_RATE : rate + wheelNoise(rng);
+        fusion.update(readings, DT, stationary, reference);
+    }
+
+    const float singleError = std::fabs(single - truth);
+    const float fusedError = std::fabs(fusion.heading() - truth);
+    const bool pass = fusedError <= MAX_FUSED_ERROR;
+    std::printf("%-22s single %6.2f deg  fused %5.2f deg  biases %+.2f %+.2f  healthy %d %d  %s\n", scenario.name,
+                singleError, fusedError, fusion.bias(0), fusion.bias(1), fusion.healthy(0), fusion.healthy(1),
+                pass ? "ok" : "FAIL");
+    return pass;
+}
+} // namespace
+
+int main() {
+    const Scenario scenarios[] = {
+        {"both healthy", Fault::NONE},
+        {"second disconnects", Fault::SECOND_DISCONNECTS},
+        {"second bias jump", Fault::SECOND_BIAS_JUMP},
+        {"no wheel reference", Fault::NO_REFERENCE},
+    };
+
+    bool ok = true;
+    for (const Scenario& scenario : scenarios) {
+        ok = run(scenario) && ok;
+    }
+    return ok ? 0 : 1;
+}
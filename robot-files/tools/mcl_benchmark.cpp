@@ -0,0 +1,114 @@
+/**
+ * @file mcl_benchmark.cpp
+ * @brief Host benchmark and sanity check of MonteCarloLocalization
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/mcl_benchmark.cpp src/odometry/monte_carlo_localization.cpp -o mcl_benchmark
+ *   ./mcl_benchmark
+ *
+ * Drives a simulated robot with four distance sensors (front, back, left,
+ * right) around the field for 20 s at the relocalization rate, feeding the
+ * filter odometry deltas that under-read by 3% and, halfway through, a 10 inch
+ * shove the odometry never sees. Reports the final error of the odometry and
+ * of the filter, and the particle updates (predict + correct) per millisecond.
+ * The brain's Cortex-A9 is roughly an order of magnitude slower than a
+ * desktop core, so divide accordingly when sizing PARTICLES.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "odometry/field_model.hpp"
+#include "odometry/monte_carlo_localization.hpp"
+
+namespace {
+constexpr float PERIOD = 0.05f; // seconds, one distance sensor update
+constexpr int STEPS = 400;      // 20 s
+constexpr float DEG = static_cast<float>(M_PI) / 180;
+constexpr float MAX_MCL_ERROR = 2; // inches after the run
+
+struct Pose {
+  float x;
+  float y;
+  float theta; // degrees
+};
+
+MclConfig make_config() {
+    MclConfig config;
+    config.mounts = {{{0, 6, 0}, {0, -6, 180}, {-6, 0, -90}, {6, 0, 90}}};
+    return config;
+}
+
+DistanceBeam read_beam(const Pose& pose, const DistanceMount& mount, float maxRange, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0, 0.3f);
+    const float sinT = std::sin(pose.theta * DEG);
+    const float cosT = std::cos(pose.theta * DEG);
+    const float ox = pose.x + mount.x * cosT + mount.y * sinT;
+    const float oy = pose.y - mount.x * sinT + mount.y * cosT;
+    const float angle = (pose.theta + mount.angle) * DEG;
+    const float range = FIELD.cast(ox, oy, std::sin(angle), std::cos(angle), maxRange);
+    DistanceBeam beam;
+    beam.valid = range < maxRange;
+    beam.range = range + noise(rng);
+    beam.confidence = 1;
+    return beam;
+}
+} // namespace
+
+int main() {
+    const MclConfig config = make_config();
+    MonteCarloLocalization mcl(config);
+    std::mt19937 rng(3);
+
+    Pose truth{-24, -36, 0};
+    Pose odometry = truth;
+    mcl.reset(truth.x, truth.y, truth.theta);
+
+    double busySeconds = 0;
+    for (int step = 0; step < STEPS; step++) {
+        const float t = step * PERIOD;
+        const float forward = 30 * std::sin(t * 0.6f) * PERIOD;
+        const float turn = 60 * std::sin(t * 0.9f) * PERIOD;
+
+        // Truth moves; odometry sees 3% less of it
+        const float sinT = std::sin(truth.theta * DEG);
+        const float cosT = std::cos(truth.theta * DEG);
+        truth.x += forward * sinT;
+        truth.y += forward * cosT;
+        truth.theta += turn;
+        const float odoSin = std::sin(odometry.theta * DEG);
+        const float odoCos = std::cos(odometry.theta * DEG);
+        odometry.x += 0.97f * forward * odoSin;
+        odometry.y += 0.97f * forward * odoCos;
+        odometry.theta += turn;
+        if (step == STEPS / 2) {
+            truth.x += 10; // shoved sideways by another robot
+        }
+
+        std::array<DistanceBeam, MonteCarloLocalization::MAX_BEAMS> beams;
+        for (std::size_t i = 0; i < beams.size(); i++) {
+            beams[i] = read_beam(truth, config.mounts[i], config.maxRange, rng);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        mcl.predict(0.97f * forward, 0, turn);
+        mcl.correct(beams);
+        busySeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const MclEstimate estimate = mcl.estimate();
+    const float odometryError = std::hypot(odometry.x - truth.x, odometry.y - truth.y);
+    const float mclError = std::hypot(estimate.x - truth.x, estimate.y - truth.y);
+    const double particlesPerMs = MonteCarloLocalization::PARTICLES * STEPS / (busySeconds * 1000);
+    const bool pass = mclError <= MAX_MCL_ERROR;
+
+    std::printf("odometry error %6.2f in\n", odometryError);
+    std::printf("mcl error      %6.2f in  (spread %.2f in, heading %+.2f deg off)  %s\n", mclError,
+                estimate.positionSpread, estimate.theta - truth.theta, pass ? "ok" : "FAIL");
+    std::printf("%zu particles, %.0f particle updates/ms, %.1f us per update with %zu beams\n",
+                MonteCarloLocalization::PARTICLES, particlesPerMs, busySeconds * 1e6 / STEPS,
+                MonteCarloLocalization::MAX_BEAMS);
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file motion_profile_check.cpp
+ * @brief Host check of MotionProfile's trapezoidal and S-curve profiles
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/motion_profile_check.cpp src/motion/motion_profile.cpp -o motion_profile_check
+ *   ./motion_profile_check
+ *
+ * For long moves that cruise at the velocity limit and short ones that never
+ * reach it, in both directions, samples each profile every 0.1 ms and checks
+ * that:
+ *  - position and velocity are continuous, and each step's position change
+ *    is the integral of the sampled velocity (acceleration too, for S-curves);
+ *  - |v| <= vmax, |a| <= amax, and the peak speed sampled is peak_velocity();
+ *  - the profile ends at rest on the target and holds there past its end;
+ *  - duration() matches the closed-form time-optimal duration.
+ * Exits 1 on any miss.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+#include "motion/motion_profile.hpp"
+
+namespace {
+constexpr float DT = 0.0001f;
+constexpr float RELATIVE_TOLERANCE = 1e-3f; // float sampling of profiles a few seconds long
+constexpr float DURATION_TOLERANCE = 1e-3f; // relative; the S-curve peak comes from a float bisection
+
+struct Case {
+  const char* name;
+  float distance;
+  ProfileConstraints constraints;
+  bool reachesMaxVelocity;
+};
+
+int failures = 0;
+
+void expect(bool ok, const char* what, float got, float want) {
+    std::printf("    %-34s %10.6f  expected %10.6f  %s\n", what, got, want, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+/**
+ * @brief Time-optimal rest-to-rest duration, solved directly rather than by search
+ */
+float closed_form_duration(float distance, const ProfileConstraints& limits) {
+    const float d = std::fabs(distance);
+    const float v = limits.maxVelocity;
+    const float a = limits.maxAcceleration;
+    const float j = limits.maxJerk;
+    if (j <= 0) {
+        // Trapezoid, or a triangle when the distance is under v^2/a
+        return d >= v * v / a ? d / v + v / a : 2 * std::sqrt(d / a);
+    }
+
+    // Ramp from rest to vPeak: time and distance, with amax reached only if vPeak >= a^2/j
+    const auto rampTime = [&](float vPeak) {
+        return vPeak >= a * a / j ? vPeak / a + a / j : 2 * std::sqrt(vPeak / j);
+    };
+    const auto rampDistance = [&](float vPeak) { return vPeak * rampTime(vPeak) / 2; };
+    if (d >= 2 * rampDistance(v)) {
+        return 2 * rampTime(v) + (d - 2 * rampDistance(v)) / v;
+    }
+
+    // No cruise: the two ramps cover d exactly. With amax reached,
+    // vPeak^2/a + vPeak a/j = d; without, 2 vPeak sqrt(vPeak/j) = d.
+    float vPeak = a / 2 * (-a / j + std::sqrt(a * a / (j * j) + 4 * d / a));
+    if (vPeak < a * a / j) {
+        vPeak = std::cbrt(d * d * j / 4);
+    }
+    return 2 * rampTime(vPeak);
+}
+
+void run(const Case& test) {
+    const ProfileConstraints& limits = test.constraints;
+    std::printf("%s: distance %.2f  vmax %.1f  amax %.1f  jmax %.1f\n", test.name, test.distance, limits.maxVelocity,
+                limits.maxAcceleration, limits.maxJerk);
+
+    const MotionProfile profile(test.distance, limits);
+    const float duration = profile.duration();
+    const float want = closed_form_duration(test.distance, limits);
+    expect(std::fabs(duration - want) <= DURATION_TOLERANCE * want, "duration (s)", duration, want);
+    if (test.reachesMaxVelocity) {
+        expect(std::fabs(profile.peak_velocity() - limits.maxVelocity) <= RELATIVE_TOLERANCE * limits.maxVelocity,
+               "peak velocity, cruising", profile.peak_velocity(), limits.maxVelocity);
+    } else {
+        expect(profile.peak_velocity() < limits.maxVelocity, "peak velocity, short of vmax", profile.peak_velocity(),
+               limits.maxVelocity);
+    }
+
+    // Step tolerances: well under a real discontinuity, over the float rounding of the state
+    const float positionTolerance =
+        RELATIVE_TOLERANCE * limits.maxVelocity * DT + 8 * FLT_EPSILON * std::fabs(test.distance);
+    const float velocityTolerance = RELATIVE_TOLERANCE * limits.maxVelocity * 0.01f;
+    const float accelerationTolerance = RELATIVE_TOLERANCE * limits.maxAcceleration;
+    float worstPosition = 0;     // |position step - integral of velocity|
+    float worstVelocity = 0;     // |velocity step - integral of acceleration|, S-curve only
+    float worstVelocityJump = 0; // |velocity step| beyond amax * dt
+    float worstAccelerationJump = 0;
+    float maxSpeed = 0;
+    float maxAcceleration = 0;
+
+    ProfileState previous = profile.sample(0);
+    const int steps = static_cast<int>(std::ceil(duration / DT));
+    for (int i = 1; i <= steps; i++) {
+        const ProfileState state = profile.sample(std::min(i * DT, duration));
+        const float dt = std::min(i * DT, duration) - std::min((i - 1) * DT, duration);
+        worstPosition = std::max(
+            worstPosition, std::fabs(state.position - previous.position - (state.velocity + previous.velocity) / 2 * dt));
+        worstVelocityJump =
+            std::max(worstVelocityJump, std::fabs(state.velocity - previous.velocity) - limits.maxAcceleration * dt);
+        if (limits.maxJerk > 0) {
+            worstVelocity = std::max(worstVelocity, std::fabs(state.velocity - previous.velocity -
+                                                              (state.acceleration + previous.acceleration) / 2 * dt));
+            worstAccelerationJump = std::max(worstAccelerationJump, std::fabs(state.acceleration - previous.acceleration) -
+                                                                        limits.maxJerk * dt);
+        }
+        maxSpeed = std::max(maxSpeed, std::fabs(state.velocity));
+        maxAcceleration = std::max(maxAcceleration, std::fabs(state.acceleration));
+        previous = state;
+    }
+
+    expect(worstPosition <= positionTolerance, "position follows velocity", worstPosition, positionTolerance);
+    expect(worstVelocityJump <= velocityTolerance, "velocity continuous", worstVelocityJump, velocityTolerance);
+    if (limits.maxJerk > 0) {
+        expect(worstVelocity <= velocityTolerance, "velocity follows acceleration", worstVelocity, velocityTolerance);
+        expect(worstAccelerationJump <= accelerationTolerance, "acceleration continuous", worstAccelerationJump,
+               accelerationTolerance);
+    }
+    expect(maxSpeed <= limits.maxVelocity * (1 + RELATIVE_TOLERANCE), "max |v|", maxSpeed, limits.maxVelocity);
+    expect(std::fabs(maxSpeed - profile.peak_velocity()) <= RELATIVE_TOLERANCE * profile.peak_velocity(),
+           "max |v| is peak_velocity()", maxSpeed, profile.peak_velocity());
+    expect(maxAcceleration <= limits.maxAcceleration * (1 + RELATIVE_TOLERANCE), "max |a|", maxAcceleration,
+           limits.maxAcceleration);
+
+    const ProfileState end = profile.sample(duration);
+    const float endTolerance = RELATIVE_TOLERANCE * std::fabs(test.distance);
+    expect(std::fabs(end.position - test.distance) <= endTolerance, "position at the end", end.position, test.distance);
+    expect(std::fabs(end.velocity) <= velocityTolerance, "velocity at the end", end.velocity, 0);
+    const ProfileState after = profile.sample(duration + 1);
+    expect(std::fabs(after.position - test.distance) <= endTolerance && after.velocity == 0 && after.acceleration == 0,
+           "holds at rest past the end", after.position, test.distance);
+}
+} // namespace
+
+int main() {
+    // Drive-like limits: in/s, in/s^2, in/s^3. v^2/a is 30 in for the trapezoid;
+    // the S-curve reaches amax once v >= a^2/j (14.4 in/s at j = 1000)
+    const Case cases[] = {
+        {"trapezoid, long", 48, {60, 120}, true},
+        {"trapezoid, long, reverse", -48, {60, 120}, true},
+        {"trapezoid, short", 6, {60, 120}, false},
+        {"trapezoid, very short", 0.25f, {60, 120}, false},
+        {"S-curve, long", 48, {60, 120, 1000}, true},
+        {"S-curve, long, reverse", -48, {60, 120, 1000}, true},
+        {"S-curve, short, reaches amax", 10, {60, 120, 1000}, false},
+        {"S-curve, short, below amax", 0.5f, {60, 120, 1000}, false},
+        {"S-curve, short, reverse", -0.5f, {60, 120, 1000}, false},
+        // a^2/j = 72 > vmax: cruises without ever reaching amax
+        {"S-curve, jerk-bound cruise", 100, {60, 120, 200}, true},
+        {"S-curve, jerk-bound short", 20, {60, 120, 200}, false},
+    };
+    for (const Case& test : cases) {
+        run(test);
+    }
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
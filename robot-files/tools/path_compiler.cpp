@@ -0,0 +1,200 @@
+/**
+ * @file path_compiler.cpp
+ * @brief Host tool converting LemLib text paths into packed binary paths
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/path_compiler.cpp -o path_compiler
+ *   ./path_compiler static/skills.txt static/skills.bin
+ *
+ * Input is the LemLib/path.jerryio text format: one "x, y, speed" line per
+ * point (speed 0-127), terminated by "endData". Anything after that is
+ * ignored. The output's target velocity is speed scaled to --max-velocity,
+ * capped so lateral acceleration stays under --max-lateral-accel on curves,
+ * and ramped down with --max-accel so the robot can stop at the end.
+ *
+ * Options (defaults in brackets):
+ *   --max-velocity <in/s>        velocity at speed 127 [60]
+ *   --max-accel <in/s^2>         deceleration limit [120]
+ *   --max-lateral-accel <in/s^2> cornering limit [80]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "motion/packed_path.hpp"
+
+namespace {
+struct Options {
+    float maxVelocity = 60;
+    float maxAccel = 120;
+    float maxLateralAccel = 80;
+};
+
+struct TextPoint {
+    float x;
+    float y;
+    float speed;
+};
+
+bool read_text_path(const char* filename, std::vector<TextPoint>& points) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "cannot open " << filename << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.rfind("endData", 0) == 0) {
+            break;
+        }
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream stream(line);
+        TextPoint point;
+        if (!(stream >> point.x >> point.y >> point.speed)) {
+            std::cerr << filename << ":" << lineNumber << ": expected \"x, y, speed\"\n";
+            return false;
+        }
+        points.push_back(point);
+    }
+
+    if (points.size() < 2) {
+        std::cerr << filename << ": a path needs at least 2 points\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Signed curvature of the circle through a, b, c (positive = clockwise)
+ */
+float curvature(const TextPoint& a, const TextPoint& b, const TextPoint& c) {
+    const float ab = std::hypot(b.x - a.x, b.y - a.y);
+    const float bc = std::hypot(c.x - b.x, c.y - b.y);
+    const float ca = std::hypot(a.x - c.x, a.y - c.y);
+    const float denominator = ab * bc * ca;
+    if (denominator < 1e-6f) {
+        return 0;
+    }
+    const float cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+    return -2 * cross / denominator;
+}
+
+std::vector<float> compile(const std::vector<TextPoint>& points, const Options& options, PackedPathHeader& header) {
+    const size_t n = points.size();
+    std::vector<float> x(n), y(n), heading(n), kappa(n), velocity(n), distance(n);
+
+    for (size_t i = 0; i < n; i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        if (i > 0) {
+            distance[i] = distance[i - 1] + std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+        }
+
+        const TextPoint& before = points[i > 0 ? i - 1 : i];
+        const TextPoint& after = points[i + 1 < n ? i + 1 : i];
+        heading[i] = std::atan2(after.x - before.x, after.y - before.y) * 180 / M_PI;
+    }
+
+    for (size_t i = 1; i + 1 < n; i++) {
+        kappa[i] = curvature(points[i - 1], points[i], points[i + 1]);
+    }
+    kappa[0] = kappa[std::min<size_t>(1, n - 1)];
+    kappa[n - 1] = kappa[n > 1 ? n - 2 : 0];
+
+    for (size_t i = 0; i < n; i++) {
+        float v = std::clamp(points[i].speed, 0.0f, 127.0f) / 127 * options.maxVelocity;
+        if (std::fabs(kappa[i]) > 1e-6f) {
+            v = std::min(v, std::sqrt(options.maxLateralAccel / std::fabs(kappa[i])));
+        }
+        velocity[i] = v;
+    }
+
+    // Stop at the end: v^2 = v_next^2 + 2 * a * d, walking backwards
+    velocity[n - 1] = 0;
+    for (size_t i = n - 1; i-- > 0;) {
+        const float gap = distance[i + 1] - distance[i];
+        velocity[i] = std::min(velocity[i], std::sqrt(velocity[i + 1] * velocity[i + 1] + 2 * options.maxAccel * gap));
+    }
+
+    header.fieldCount = static_cast<uint16_t>(PackedPathField::FIELD_COUNT);
+    header.pointCount = static_cast<uint32_t>(n);
+    header.totalDistance = distance[n - 1];
+    header.maxVelocity = *std::max_element(velocity.begin(), velocity.end());
+
+    std::vector<float> arrays;
+    arrays.reserve(n * header.fieldCount);
+    for (const std::vector<float>* field : {&x, &y, &heading, &kappa, &velocity, &distance}) {
+        arrays.insert(arrays.end(), field->begin(), field->end());
+    }
+    return arrays;
+}
+
+bool parse_options(int argc, char** argv, Options& options) {
+    for (int i = 3; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            std::cerr << "missing value for " << argv[i] << "\n";
+            return false;
+        }
+        const float value = std::strtof(argv[i + 1], nullptr);
+        if (value <= 0) {
+            std::cerr << argv[i] << " must be positive\n";
+            return false;
+        }
+        if (std::strcmp(argv[i], "--max-velocity") == 0) {
+            options.maxVelocity = value;
+        } else if (std::strcmp(argv[i], "--max-accel") == 0) {
+            options.maxAccel = value;
+        } else if (std::strcmp(argv[i], "--max-lateral-accel") == 0) {
+            options.maxLateralAccel = value;
+        } else {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (argc < 3 || !parse_options(argc, argv, options)) {
+        std::cerr << "usage: path_compiler <input.txt> <output.bin> [--max-velocity v] [--max-accel a] "
+                     "[--max-lateral-accel a]\n";
+        return 1;
+    }
+
+    std::vector<TextPoint> points;
+    if (!read_text_path(argv[1], points)) {
+        return 1;
+    }
+
+    PackedPathHeader header;
+    const std::vector<float> arrays = compile(points, options, header);
+
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(arrays.data()), arrays.size() * sizeof(float));
+    if (!out) {
+        std::cerr << "cannot write " << argv[2] << "\n";
+        return 1;
+    }
+
+    std::printf("%s: %u points, %.1f in, peak %.1f in/s\n", argv[2], header.pointCount, header.totalDistance,
+                header.maxVelocity);
+    return 0;
+}
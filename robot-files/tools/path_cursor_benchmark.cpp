@@ -0,0 +1,113 @@
+/**
+ * @file path_cursor_benchmark.cpp
+ * @brief Host benchmark: full-path rescans vs. PathCursor per pure pursuit tick
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/path_cursor_benchmark.cpp src/motion/path_cursor.cpp -o path_cursor_benchmark
+ *   ./path_cursor_benchmark
+ *
+ * Builds packed S-shaped paths of 1k, 10k and 100k points in memory, drives a
+ * simulated robot along each (slightly off the path), and times the closest
+ * point + lookahead search per tick both ways. The cursor's time per tick
+ * should stay flat as the path grows; the rescan's grows linearly.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "motion/packed_path.hpp"
+#include "motion/path_cursor.hpp"
+
+namespace {
+constexpr int TICKS = 2000;
+constexpr float LOOKAHEAD = 10;
+constexpr float SPACING = 0.25f; // inches between points
+
+std::vector<uint8_t> build_path(size_t points) {
+    const size_t fields = static_cast<size_t>(PackedPathField::FIELD_COUNT);
+    std::vector<float> arrays(fields * points, 0.0f);
+    float* x = &arrays[0];
+    float* y = &arrays[points];
+    float* distance = &arrays[static_cast<size_t>(PackedPathField::DISTANCE) * points];
+
+    for (size_t i = 0; i < points; i++) {
+        const float s = i * SPACING;
+        x[i] = 24 * std::sin(s / 24);
+        y[i] = s;
+        if (i > 0) {
+            distance[i] = distance[i - 1] + std::hypot(x[i] - x[i - 1], y[i] - y[i - 1]);
+        }
+    }
+
+    PackedPathHeader header;
+    header.fieldCount = static_cast<uint16_t>(fields);
+    header.pointCount = static_cast<uint32_t>(points);
+    header.totalDistance = distance[points - 1];
+
+    std::vector<uint8_t> buffer(sizeof(header) + arrays.size() * sizeof(float));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + sizeof(header), arrays.data(), arrays.size() * sizeof(float));
+    return buffer;
+}
+
+/**
+ * @brief The search follow() did before PathCursor: scan every point, then every segment from the closest
+ */
+size_t rescan(const PackedPath& path, float px, float py) {
+    size_t closest = 0;
+    float best = INFINITY;
+    for (size_t i = 0; i < path.size(); i++) {
+        const float d = std::hypot(path.x(i) - px, path.y(i) - py);
+        if (d < best) {
+            best = d;
+            closest = i;
+        }
+    }
+    for (size_t i = closest; i + 1 < path.size(); i++) {
+        if (std::hypot(path.x(i + 1) - px, path.y(i + 1) - py) >= LOOKAHEAD) {
+            return i;
+        }
+    }
+    return closest;
+}
+
+template <typename F> double ns_per_tick(F&& tick) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TICKS; i++) {
+        tick(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / TICKS;
+}
+} // namespace
+
+int main() {
+    std::printf("%10s %16s %16s\n", "points", "rescan ns/tick", "cursor ns/tick");
+    for (size_t points : {1000, 10000, 100000}) {
+        const std::vector<uint8_t> buffer = build_path(points);
+        const PackedPath path(buffer.data(), buffer.size());
+
+        // Robot positions spread evenly along the path, 1 inch to the side
+        std::vector<float> robotX(TICKS), robotY(TICKS);
+        for (int i = 0; i < TICKS; i++) {
+            const size_t index = static_cast<size_t>(i) * (points - 1) / (TICKS - 1);
+            robotX[i] = path.x(index) + 1;
+            robotY[i] = path.y(index);
+        }
+
+        volatile size_t sink = 0;
+        const double rescanNs = ns_per_tick([&](int i) { sink = sink + rescan(path, robotX[i], robotY[i]); });
+
+        PathCursor cursor(path);
+        const double cursorNs = ns_per_tick([&](int i) {
+            sink = sink + cursor.closest(robotX[i], robotY[i]);
+            sink = sink + cursor.lookahead(robotX[i], robotY[i], LOOKAHEAD).segment;
+        });
+
+        std::printf("%10zu %16.0f %16.0f\n", points, rescanNs, cursorNs);
+    }
+    return 0;
+}
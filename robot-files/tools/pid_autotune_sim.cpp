@@ -0,0 +1,170 @@
+/**
+ * @file pid_autotune_sim.cpp
+ * @brief Host check of the relay autotuner against plants with known parameters
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/pid_autotune_sim.cpp src/motion/pid_autotune.cpp -o pid_autotune_sim
+ *   ./pid_autotune_sim
+ *
+ * Each case is an integrating plant with a first-order lag and dead time,
+ * K e^(-Ls) / (s (tau s + 1)), integrated at 1 ms. RelayAnalyzer drives it
+ * the way Drivetrain::relay_test does: sampled every 10 ms with the
+ * AUTOTUNE_CONSTANTS relay output, plus a little position noise. The checks:
+ *  - K and L from identify_integrating_plant against the plant's own;
+ *  - the identified model's Tu and Ku against the plant's exact ultimate
+ *    point (its phase crossover, where atan(w tau) + w L = 90 deg). The
+ *    relay's own period and gain are printed but not checked: its
+ *    hysteresis moves the oscillation off the ultimate point by design;
+ *  - the gains tune_pid finds on the identified model, run on the true plant
+ *    through simulate_step: they must settle, overshoot little more than the
+ *    goal allows, and settle nearly as fast as the gains tune_pid finds on
+ *    the true plant itself, with a kP close to that tuning's.
+ * Exits 1 on any miss.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "constants.hpp"
+#include "motion/pid_autotune.hpp"
+
+namespace {
+constexpr float PI = static_cast<float>(M_PI);
+constexpr float PLANT_DT = 0.001f;
+constexpr int CONTROL_EVERY = 10; // plant steps per relay update
+constexpr float RELAY_TIME = 8;   // seconds
+
+// Describing-function identification is approximate; these bound how approximate
+constexpr float MAX_GAIN_ERROR = 0.15f;          // K
+constexpr float MAX_DEAD_TIME_ERROR = 0.01f;     // s, one relay sample
+constexpr float MAX_PERIOD_ERROR = 0.10f;        // Tu
+constexpr float MAX_ULTIMATE_GAIN_ERROR = 0.20f; // Ku compounds the errors in K and L
+constexpr float MAX_KP_ERROR = 0.25f;            // against the true plant's own tuning
+constexpr float MAX_SETTLE_RATIO = 1.25f;        // settle time against the true plant's own tuning
+constexpr float OVERSHOOT_MARGIN = 0.02f;        // on top of the goal's, for the model mismatch
+
+struct Case {
+  const char* name;
+  PlantModel plant;
+  float hysteresis;
+  float step; ///< Step the gains are tuned for
+};
+
+int failures = 0;
+
+void expect(bool ok, const char* what, float got, float want) {
+    std::printf("    %-28s %9.4f  expected %9.4f  %s\n", what, got, want, ok ? "ok" : "FAIL");
+    failures += !ok;
+}
+
+bool within(float got, float want, float fraction) { return std::fabs(got - want) <= fraction * std::fabs(want); }
+
+/**
+ * @brief Exact ultimate gain and period of a plant, by bisection on its phase
+ */
+void ultimate_point(const PlantModel& plant, float& gain, float& period) {
+    float low = 1e-3f;
+    float high = 1e3f;
+    for (int i = 0; i < 100; i++) {
+        const float mid = std::sqrt(low * high);
+        const float lag = std::atan(mid * plant.timeConstant) + mid * plant.deadTime;
+        (lag < PI / 2 ? low : high) = mid;
+    }
+    const float omega = std::sqrt(low * high);
+    gain = omega * std::sqrt(1 + omega * omega * plant.timeConstant * plant.timeConstant) / plant.gain;
+    period = 2 * PI / omega;
+}
+
+/**
+ * @brief Relay test on the plant, sampled like the robot's
+ */
+RelayResult relay_test(const PlantModel& plant, float hysteresis, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0, hysteresis / 10);
+    RelayAnalyzer relay(static_cast<float>(AUTOTUNE_CONSTANTS::RELAY_OUTPUT), hysteresis);
+
+    const std::size_t delaySteps = static_cast<std::size_t>(std::lround(plant.deadTime / PLANT_DT));
+    std::vector<float> delayed(delaySteps + 1, 0);
+    std::size_t head = 0;
+    float position = 0;
+    float velocity = 0;
+    float output = 0;
+    const int steps = static_cast<int>(RELAY_TIME / PLANT_DT);
+    for (int i = 0; i < steps; i++) {
+        if (i % CONTROL_EVERY == 0) {
+            output = relay.update(i * PLANT_DT, -(position + noise(rng)));
+        }
+        delayed[(head + delaySteps) % delayed.size()] = output;
+        const float applied = delayed[head];
+        head = (head + 1) % delayed.size();
+        velocity += PLANT_DT * (plant.gain * applied - velocity) / plant.timeConstant;
+        position += velocity * PLANT_DT;
+    }
+    return relay.result();
+}
+
+void run(const Case& test, std::mt19937& rng) {
+    std::printf("%s: K %.3f  tau %.3f s  L %.3f s\n", test.name, test.plant.gain, test.plant.timeConstant,
+                test.plant.deadTime);
+
+    const RelayResult relay = relay_test(test.plant, test.hysteresis, rng);
+    expect(relay.ok && relay.cycles >= static_cast<std::size_t>(AUTOTUNE_CONSTANTS::MIN_CYCLES), "relay cycles",
+           static_cast<float>(relay.cycles), static_cast<float>(AUTOTUNE_CONSTANTS::MIN_CYCLES));
+    if (!relay.ok) {
+        return;
+    }
+
+    std::printf("    relay oscillation            %9.4f s, gain %.4f\n", relay.period, relay.ultimateGain);
+
+    const PlantModel model = identify_integrating_plant(relay, test.plant.timeConstant);
+    expect(within(model.gain, test.plant.gain, MAX_GAIN_ERROR), "K", model.gain, test.plant.gain);
+    expect(std::fabs(model.deadTime - test.plant.deadTime) <= MAX_DEAD_TIME_ERROR, "L (s)", model.deadTime,
+           test.plant.deadTime);
+
+    float ultimateGain, period, modelGain, modelPeriod;
+    ultimate_point(test.plant, ultimateGain, period);
+    ultimate_point(model, modelGain, modelPeriod);
+    expect(within(modelPeriod, period, MAX_PERIOD_ERROR), "Tu (s)", modelPeriod, period);
+    expect(within(modelGain, ultimateGain, MAX_ULTIMATE_GAIN_ERROR), "Ku", modelGain, ultimateGain);
+
+    TuningGoal goal;
+    goal.step = test.step;
+    goal.maxOvershoot = static_cast<float>(AUTOTUNE_CONSTANTS::MAX_OVERSHOOT);
+    const PidGains gains = tune_pid(model, relay, goal);
+
+    // What the search would pick with perfect knowledge of the plant
+    RelayResult exact = relay;
+    exact.period = period;
+    exact.ultimateGain = ultimateGain;
+    StepMetrics idealMetrics;
+    const PidGains ideal = tune_pid(test.plant, exact, goal, &idealMetrics);
+    expect(within(gains.kP, ideal.kP, MAX_KP_ERROR), "kP", gains.kP, ideal.kP);
+    std::printf("    %-28s %9.4f  (true plant's %.4f)\n", "kD", gains.kD, ideal.kD);
+
+    const StepMetrics onPlant = simulate_step(test.plant, gains, goal);
+    expect(onPlant.settled && onPlant.settleTime <= MAX_SETTLE_RATIO * idealMetrics.settleTime,
+           "settle time on the true plant", onPlant.settleTime, idealMetrics.settleTime);
+    expect(onPlant.overshoot <= goal.maxOvershoot + OVERSHOOT_MARGIN, "overshoot on the true plant", onPlant.overshoot,
+           goal.maxOvershoot);
+}
+} // namespace
+
+int main() {
+    std::mt19937 rng(5);
+    const Case cases[] = {
+        // Drive: about 60 in/s at full output, motor lag from characterization, sensor and bus delay
+        {"lateral", {0.5f, 0.08f, 0.03f}, static_cast<float>(AUTOTUNE_CONSTANTS::LATERAL_HYSTERESIS),
+         static_cast<float>(AUTOTUNE_CONSTANTS::LATERAL_STEP)},
+        {"lateral, slow motors", {0.35f, 0.15f, 0.04f}, static_cast<float>(AUTOTUNE_CONSTANTS::LATERAL_HYSTERESIS),
+         static_cast<float>(AUTOTUNE_CONSTANTS::LATERAL_STEP)},
+        // Turning: degrees per second per output unit
+        {"angular", {4.0f, 0.06f, 0.025f}, static_cast<float>(AUTOTUNE_CONSTANTS::ANGULAR_HYSTERESIS),
+         static_cast<float>(AUTOTUNE_CONSTANTS::ANGULAR_STEP)},
+    };
+    for (const Case& test : cases) {
+        run(test, rng);
+    }
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
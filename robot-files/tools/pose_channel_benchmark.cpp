@@ -0,0 +1,162 @@
+/**
+ * @file pose_channel_benchmark.cpp
+ * @brief Host benchmark: PoseChannel reads vs. a mutex-guarded pose under contention
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/pose_channel_benchmark.cpp src/odometry/pose_channel.cpp -o pose_channel_benchmark -pthread
+ *   ./pose_channel_benchmark
+ *
+ * One writer thread publishes poses as fast as it can while 1, 2, 4 and 8
+ * reader threads read them, first through PoseChannel::read() and then
+ * through a std::mutex-guarded copy, the way getPose() behind a pros::Mutex
+ * works. Reports each path's mean read time and the writer's publish rate,
+ * which the mutex path costs too.
+ *
+ * Every published pose has all its fields derived from its sequence number,
+ * so a reader can tell a torn snapshot (fields from two different publishes)
+ * from a whole one. Exits 1 if any PoseChannel read was torn.
+ *
+ * The host is multi-core, so readers and the writer really do run at once;
+ * on the single-core brain they only interleave at preemption, which is the
+ * milder case of the same race.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "odometry/pose_channel.hpp"
+
+// LemLib ships prebuilt; this is the one piece of it the channel links against
+lemlib::Pose::Pose(float x, float y, float theta)
+    : x(x),
+      y(y),
+      theta(theta) {}
+
+namespace {
+constexpr auto RUN_TIME = std::chrono::milliseconds(300);
+constexpr uint32_t WRAP = 100000; // keeps every derived field exact in a float
+
+/**
+ * @brief Fields of the pose with this sequence number
+ */
+PoseSample expected(uint32_t sequence) {
+    const float base = static_cast<float>(sequence % WRAP);
+    PoseSample sample;
+    sample.x = base;
+    sample.y = 2 * base;
+    sample.theta = 3 * base;
+    sample.vx = 4 * base;
+    sample.vy = 5 * base;
+    sample.omega = 6 * base;
+    sample.timestampUs = sequence;
+    sample.sequence = sequence;
+    return sample;
+}
+
+bool whole(const PoseSample& sample) {
+    const PoseSample want = expected(sample.sequence);
+    return sample.x == want.x && sample.y == want.y && sample.theta == want.theta && sample.vx == want.vx &&
+           sample.vy == want.vy && sample.omega == want.omega && sample.timestampUs == want.timestampUs;
+}
+
+/**
+ * @brief getPose() behind a lock, as before PoseChannel
+ */
+class MutexPose {
+public:
+  void publish(const PoseSample& sample) {
+    std::lock_guard<std::mutex> lock(mutex);
+    value = sample;
+  }
+
+  PoseSample read() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return value;
+  }
+
+private:
+  std::mutex mutex;
+  PoseSample value;
+};
+
+struct Result {
+  double readNs = 0;       ///< Mean per read, over all readers
+  double publishesPerMs = 0;
+  uint64_t torn = 0;
+};
+
+/**
+ * @param publish Called with each new sample by the writer
+ * @param read Returns the latest sample, called by every reader
+ */
+template <typename Publish, typename Read> Result run(int readers, Publish publish, Read read) {
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> torn{0};
+    uint32_t published = 0;
+
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            publish(expected(++published));
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; i++) {
+        threads.emplace_back([&] {
+            uint64_t count = 0;
+            uint64_t bad = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const PoseSample sample = read();
+                bad += sample.sequence != 0 && !whole(sample);
+                count++;
+            }
+            reads += count;
+            torn += bad;
+        });
+    }
+
+    std::this_thread::sleep_for(RUN_TIME);
+    stop = true;
+    writer.join();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(RUN_TIME).count();
+    Result result;
+    result.readNs = ms * 1e6 * readers / static_cast<double>(reads.load());
+    result.publishesPerMs = published / ms;
+    result.torn = torn.load();
+    return result;
+}
+} // namespace
+
+int main() {
+    std::printf("%8s %14s %14s %16s %16s %8s\n", "readers", "channel ns", "mutex ns", "channel pub/ms",
+                "mutex pub/ms", "torn");
+    uint64_t torn = 0;
+    for (int readers : {1, 2, 4, 8}) {
+        PoseChannel channel;
+        const Result lockFree = run(
+            readers,
+            [&](const PoseSample& sample) {
+                // publish() numbers the poses itself, counting from 1 like expected()
+                channel.publish(sample.pose(), sample.velocity(), sample.timestampUs);
+            },
+            [&] { return channel.read(); });
+
+        MutexPose guarded;
+        const Result locked = run(
+            readers, [&](const PoseSample& sample) { guarded.publish(sample); }, [&] { return guarded.read(); });
+
+        std::printf("%8d %14.1f %14.1f %16.0f %16.0f %8llu\n", readers, lockFree.readNs, locked.readNs,
+                    lockFree.publishesPerMs, locked.publishesPerMs, static_cast<unsigned long long>(lockFree.torn));
+        torn += lockFree.torn;
+    }
+    std::printf("%s\n", torn == 0 ? "PASS: no torn PoseChannel reads" : "FAIL: torn PoseChannel reads");
+    return torn == 0 ? 0 : 1;
+}
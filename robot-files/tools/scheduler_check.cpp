@@ -0,0 +1,172 @@
+/**
+ * @file scheduler_check.cpp
+ * @brief Host check of the subsystem schedule on a VirtualClock
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++17 -O2 -Iinclude tools/scheduler_check.cpp src/scheduler/scheduler.cpp -o scheduler_check
+ *   ./scheduler_check
+ *
+ * Registers the operator-control subsystems with their SCHEDULER_CONSTANTS
+ * periods and priorities on one Scheduler and drives it the way
+ * SchedulerTask does: tick, then sleep to the next base-period deadline,
+ * skipping any already passed. Time only moves when a callback advances the
+ * clock to simulate its own execution time. Checks that:
+ *  - every entry runs exactly on its 5/10/50 ms period;
+ *  - entries due together run in priority order, ties in registration order;
+ *  - a slow mechanism callback does not delay the drive entry: drive still
+ *    starts first in every tick and stays on its 5 ms grid.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "constants.hpp"
+#include "scheduler/scheduler.hpp"
+
+namespace {
+constexpr uint64_t RUN_US = 1000000;
+
+struct Start {
+  const char* name;
+  uint64_t timeUs;
+  uint32_t tick;
+};
+
+struct Harness {
+  VirtualClock clock;
+  Scheduler scheduler{clock};
+  std::vector<Start> starts;
+  uint32_t ticks = 0;
+  uint32_t slowUs = 0; ///< Simulated execution time of the intake callback
+
+  Harness() {
+    const auto entry = [this](const char* name, uint32_t workUs) {
+      return [this, name, workUs] {
+        starts.push_back({name, clock.now_us(), ticks});
+        clock.advance_us(workUs);
+      };
+    };
+    // Same order as register_subsystems() in main.cpp
+    scheduler.add("input", SCHEDULER_CONSTANTS::INPUT_PERIOD_MS, SCHEDULER_CONSTANTS::INPUT_PRIORITY,
+                  entry("input", 20));
+    scheduler.add("drivetrain", SCHEDULER_CONSTANTS::DRIVETRAIN_PERIOD_MS, SCHEDULER_CONSTANTS::DRIVETRAIN_PRIORITY,
+                  entry("drivetrain", 300));
+    scheduler.add("intake", SCHEDULER_CONSTANTS::INTAKE_PERIOD_MS, SCHEDULER_CONSTANTS::INTAKE_PRIORITY,
+                  [this] {
+                    starts.push_back({"intake", clock.now_us(), ticks});
+                    clock.advance_us(slowUs);
+                  });
+    scheduler.add("endeffector", SCHEDULER_CONSTANTS::ENDEFFECTOR_PERIOD_MS, SCHEDULER_CONSTANTS::ENDEFFECTOR_PRIORITY,
+                  entry("endeffector", 100));
+    scheduler.add("lilwill", SCHEDULER_CONSTANTS::PNEUMATICS_PERIOD_MS, SCHEDULER_CONSTANTS::PNEUMATICS_PRIORITY,
+                  entry("lilwill", 50));
+  }
+
+  /**
+   * @brief Ticks at the base period like SchedulerTask's LoopTimer
+   */
+  void run() {
+    const uint64_t periodUs = static_cast<uint64_t>(scheduler.base_period_ms()) * 1000;
+    scheduler.reset();
+    uint64_t deadlineUs = 0;
+    while (deadlineUs < RUN_US) {
+      if (clock.now_us() < deadlineUs) {
+        clock.advance_us(deadlineUs - clock.now_us());
+      }
+      scheduler.tick();
+      ticks++;
+      deadlineUs += periodUs;
+      while (deadlineUs <= clock.now_us()) {
+        deadlineUs += periodUs; // overran: skip to the next deadline still ahead
+      }
+    }
+  }
+};
+
+int failures = 0;
+
+void expect(bool ok, const char* what) {
+  std::printf("%-62s %s\n", what, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+/**
+ * @brief Every start of an entry is exactly one period after the last, beginning at 0
+ */
+bool on_period(const std::vector<Start>& starts, const char* name, uint32_t periodMs) {
+  uint64_t expected = 0;
+  uint32_t runs = 0;
+  for (const Start& start : starts) {
+    if (std::strcmp(start.name, name) != 0) {
+      continue;
+    }
+    if (start.timeUs / 1000 / periodMs != expected / 1000 / periodMs || start.timeUs < expected) {
+      return false;
+    }
+    expected += static_cast<uint64_t>(periodMs) * 1000;
+    runs++;
+  }
+  return runs == RUN_US / 1000 / periodMs;
+}
+
+/**
+ * @brief Within every tick, the drive entries run before anything else and the drivetrain starts on its grid
+ */
+bool drive_first(const std::vector<Start>& starts) {
+  const uint64_t periodUs = static_cast<uint64_t>(SCHEDULER_CONSTANTS::DRIVETRAIN_PERIOD_MS) * 1000;
+  for (std::size_t i = 0; i < starts.size(); i++) {
+    if (std::strcmp(starts[i].name, "drivetrain") != 0) {
+      continue;
+    }
+    // Only input may precede it in its tick
+    for (std::size_t j = i; j-- > 0 && starts[j].tick == starts[i].tick;) {
+      if (std::strcmp(starts[j].name, "input") != 0) {
+        return false;
+      }
+    }
+    // Started within the input's execution time of its deadline
+    if (starts[i].timeUs % periodUs > 100) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main() {
+  Harness fast;
+  fast.run();
+  expect(on_period(fast.starts, "input", SCHEDULER_CONSTANTS::INPUT_PERIOD_MS), "input runs every 5 ms");
+  expect(on_period(fast.starts, "drivetrain", SCHEDULER_CONSTANTS::DRIVETRAIN_PERIOD_MS), "drivetrain runs every 5 ms");
+  expect(on_period(fast.starts, "intake", SCHEDULER_CONSTANTS::INTAKE_PERIOD_MS), "intake runs every 10 ms");
+  expect(on_period(fast.starts, "endeffector", SCHEDULER_CONSTANTS::ENDEFFECTOR_PERIOD_MS),
+         "endeffector runs every 10 ms");
+  expect(on_period(fast.starts, "lilwill", SCHEDULER_CONSTANTS::PNEUMATICS_PERIOD_MS), "pneumatics run every 50 ms");
+
+  // At t = 0 everything is due together
+  const char* order[] = {"input", "drivetrain", "intake", "endeffector", "lilwill"};
+  bool ordered = fast.starts.size() >= 5;
+  for (std::size_t i = 0; ordered && i < 5; i++) {
+    ordered = std::strcmp(fast.starts[i].name, order[i]) == 0;
+  }
+  expect(ordered, "priority order within a tick, ties in registration order");
+
+  // An intake that takes most of a drive period still runs after the drive,
+  // and the drive keeps its grid because the overrun ends before the next deadline
+  Harness slow;
+  slow.slowUs = 4000;
+  slow.run();
+  expect(drive_first(slow.starts), "slow intake (4 ms): drive runs first, on its grid");
+  expect(on_period(slow.starts, "drivetrain", SCHEDULER_CONSTANTS::DRIVETRAIN_PERIOD_MS),
+         "slow intake (4 ms): drivetrain still runs every 5 ms");
+
+  // One that overruns whole periods costs the drive ticks, but never its place in a tick
+  Harness stalled;
+  stalled.slowUs = 12000;
+  stalled.run();
+  expect(drive_first(stalled.starts), "stalled intake (12 ms): drive still starts each tick first");
+
+  std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
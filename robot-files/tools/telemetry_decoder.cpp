@@ -0,0 +1,79 @@
+/**
+ * @file telemetry_decoder.cpp
+ * @brief Host decoder for the binary telemetry the robot writes to the SD card
+ *
+ * Build and run on a PC (not part of the robot build):
+ *   g++ -std=c++20 -O2 -Iinclude tools/telemetry_decoder.cpp src/telemetry/record_format.cpp -o telemetry_decoder
+ *   ./telemetry_decoder telemetry.bin [record_name ...]
+ *
+ * Prints every record as the drain task would have printed it, one per
+ * line. Given record names (e.g. color_piece color_eject), prints only
+ * those. A file written by a different FORMAT_VERSION is refused: the field
+ * lists it was written with are not the ones compiled in here.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "telemetry/record_format.hpp"
+
+namespace {
+bool wanted(const RecordHeader& header, int argc, char** argv) {
+    if (argc <= 2) {
+        return true;
+    }
+    if (header.id >= static_cast<uint16_t>(RecordId::COUNT)) {
+        return false;
+    }
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], RECORD_FORMATS[header.id].name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("usage: %s telemetry.bin [record_name ...]\n", argv[0]);
+        return 1;
+    }
+    FILE* file = std::fopen(argv[1], "rb");
+    if (file == nullptr) {
+        std::printf("could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    FileHeader fileHeader;
+    if (std::fread(&fileHeader, sizeof(fileHeader), 1, file) != 1 || std::memcmp(fileHeader.magic, "TLOG", 4) != 0) {
+        std::printf("%s is not a telemetry file\n", argv[1]);
+        std::fclose(file);
+        return 1;
+    }
+    if (fileHeader.version != FORMAT_VERSION) {
+        std::printf("%s is format version %u, this decoder reads %u\n", argv[1],
+                    static_cast<unsigned>(fileHeader.version), static_cast<unsigned>(FORMAT_VERSION));
+        std::fclose(file);
+        return 1;
+    }
+
+    RecordHeader header;
+    uint8_t payload[256];
+    unsigned long records = 0;
+    while (std::fread(&header, sizeof(header), 1, file) == 1) {
+        if (std::fread(payload, 1, header.size, file) != header.size) {
+            std::printf("truncated record after %lu records\n", records);
+            break;
+        }
+        records++;
+        if (!wanted(header, argc, argv)) {
+            continue;
+        }
+        char line[256];
+        format_record(header, payload, line, sizeof(line));
+        std::printf("%s\n", line);
+    }
+    std::fclose(file);
+    return 0;
+}